@@ -125,6 +125,7 @@ namespace Avida {
       
       bool Serialize(ArchivePtr ar) const;
       bool LegacySave(void* df) const;
+      bool LegacySaveProperties(Apto::Map<Apto::String, Apto::String>& props) const;
 
       void RemoveActiveReference() const;
       
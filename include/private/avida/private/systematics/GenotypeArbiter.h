@@ -129,6 +129,7 @@ namespace Avida {
       
       bool Serialize(ArchivePtr ar) const;
       bool LegacySave(void* df) const;
+      bool LegacySaveProperties(Apto::Array<Apto::SmartPtr<Apto::Map<Apto::String, Apto::String> > >& records) const;
       GroupPtr LegacyLoad(void* props);
       
       IteratorPtr Begin();
@@ -62,13 +62,76 @@ namespace Avida {
 
   
   
+  // InstructionBuffer - copy-on-write instruction storage
+  // --------------------------------------------------------------------------------------------------------------
+  //
+  // Copies of a buffer share one reference counted array until a non-const access forces a private copy, so sequences
+  // that are only passed along (offspring, organism, genotype) never copy their instructions.  Shared storage is never
+  // written, so const access from several threads is safe.  References returned by the non-const accessor must not be
+  // held across a copy of the buffer.
+  
+  class InstructionBuffer
+  {
+  private:
+    class Data : public Apto::RefCountObject<Apto::ThreadSafe>
+    {
+    public:
+      Apto::Array<Instruction> seq;
+      
+      LIB_LOCAL inline explicit Data(int size) : seq(size) { ; }
+      LIB_LOCAL inline Data(const Data& data) : Apto::RefCountObject<Apto::ThreadSafe>(data), seq(data.seq) { ; }
+    };
+    
+    Apto::SmartPtr<Data, Apto::InternalRCObject> m_data;
+    
+  public:
+    LIB_EXPORT inline explicit InstructionBuffer(int size = 0) : m_data(new Data(size)) { ; }
+    
+    LIB_EXPORT inline int GetSize() const { return m_data->seq.GetSize(); }
+    
+    LIB_EXPORT inline const Instruction& operator[](int idx) const { return m_data->seq[idx]; }
+    LIB_EXPORT inline Instruction& operator[](int idx) { prepareWrite(); return m_data->seq[idx]; }
+    
+    LIB_EXPORT inline void Resize(int size)
+    {
+      if (m_data->RefCount() == 1) { m_data->seq.Resize(size); return; }
+      
+      // Shared, so copy the surviving sites straight into storage of the new size rather than copying then resizing
+      Data* data = new Data(size);
+      const int keep = (size < GetSize()) ? size : GetSize();
+      for (int i = 0; i < keep; i++) data->seq[i] = m_data->seq[i];
+      m_data = Apto::SmartPtr<Data, Apto::InternalRCObject>(data);
+    }
+    LIB_EXPORT inline void ResizeClear(int size)
+    {
+      if (m_data->RefCount() != 1) m_data = Apto::SmartPtr<Data, Apto::InternalRCObject>(new Data(size));
+      else m_data->seq.ResizeClear(size);
+    }
+    
+    // Writable pointer to the first site (NULL if empty), for moving many sites without a copy check per site
+    LIB_EXPORT inline Instruction* GetWritable() { prepareWrite(); return (m_data->seq.GetSize()) ? &m_data->seq[0] : NULL; }
+    
+    LIB_EXPORT inline bool IsSharedWith(const InstructionBuffer& other) const { return &(*m_data) == &(*other.m_data); }
+    
+    // Hash of the first size sites
+    LIB_EXPORT unsigned int Hash(int size) const;
+    
+  private:
+    LIB_LOCAL inline void prepareWrite()
+    {
+      if (m_data->RefCount() != 1) m_data = Apto::SmartPtr<Data, Apto::InternalRCObject>(new Data(*m_data));
+    }
+  };
+  
+  
+  
   // InstructionSequence - a series of bytes containing a base level genetic sequence
   // --------------------------------------------------------------------------------------------------------------
 
   class InstructionSequence : public GeneticRepresentation
   {
   protected:
-    Apto::Array<Instruction> m_seq;
+    InstructionBuffer m_seq;
     int m_active_size;
     
   public:
@@ -84,6 +147,9 @@ namespace Avida {
     
     LIB_EXPORT inline Instruction& operator[](int idx) { assert(idx >= 0 && idx < m_active_size);  return m_seq[idx]; }
     LIB_EXPORT inline const Instruction& operator[](int idx) const { assert(idx >= 0 && idx < m_active_size);  return m_seq[idx]; }
+    
+    // Hash of the active sites
+    LIB_EXPORT inline unsigned int Hash() const { return m_seq.Hash(m_active_size); }
 
 
     // GeneticRepresentation Interface
@@ -137,8 +203,18 @@ namespace Avida {
     static int FindSlidingDistance(const InstructionSequence& seq1, const InstructionSequence& seq2);
     static int FindEditDistance(const InstructionSequence& seq1, const InstructionSequence& seq2);
     
+    // Thresholded edit distance, returns early with (max_dist + 1) once the distance is known to exceed max_dist.  A
+    // negative max_dist means no limit, the exact distance is always returned.
+    static int FindEditDistance(const InstructionSequence& seq1, const InstructionSequence& seq2, int max_dist);
+    
+    // Raw buffer variants, for callers that pack many sequences into contiguous storage (max_dist as above)
+    static int FindHammingDistance(const Instruction* seq1, int size1, const Instruction* seq2, int size2);
+    static int FindEditDistance(const Instruction* seq1, int size1, const Instruction* seq2, int size2, int max_dist = -1);
+    
     
   protected:
+    inline const Instruction* rawSequence() const { return (m_active_size) ? &m_seq[0] : NULL; }
+    
     LIB_EXPORT virtual void adjustCapacity(int new_size);
     LIB_EXPORT virtual void prepareInsert(int pos, int num_sites);
   };
@@ -69,6 +69,7 @@ namespace Avida {
       // Serialization
       LIB_EXPORT virtual bool Serialize(ArchivePtr ar) const;
       LIB_EXPORT virtual bool LegacySave(void* df) const;
+      LIB_EXPORT virtual bool LegacySaveProperties(Apto::Array<Apto::SmartPtr<Apto::Map<Apto::String, Apto::String> > >& records) const;
       LIB_EXPORT virtual GroupPtr LegacyLoad(void* props);
       
       
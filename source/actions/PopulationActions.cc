@@ -3909,14 +3909,12 @@ public:
       cerr << "cellB: " << temp_x << " " << temp_y << endl;
 #endif
       
-      tList<cPopulationCell>& cellA_list = cellA.ConnectionList();
-      tList<cPopulationCell>& cellB_list = cellB.ConnectionList();
-      cellA_list.Remove(&m_world->GetPopulation().GetCell(idB));
-      cellA_list.Remove(&m_world->GetPopulation().GetCell(idB0));
-      cellA_list.Remove(&m_world->GetPopulation().GetCell(idB1));
-      cellB_list.Remove(&m_world->GetPopulation().GetCell(idA));
-      cellB_list.Remove(&m_world->GetPopulation().GetCell(idA0));
-      cellB_list.Remove(&m_world->GetPopulation().GetCell(idA1));
+      cellA.RemoveConnection(m_world->GetPopulation().GetCell(idB));
+      cellA.RemoveConnection(m_world->GetPopulation().GetCell(idB0));
+      cellA.RemoveConnection(m_world->GetPopulation().GetCell(idB1));
+      cellB.RemoveConnection(m_world->GetPopulation().GetCell(idA));
+      cellB.RemoveConnection(m_world->GetPopulation().GetCell(idA0));
+      cellB.RemoveConnection(m_world->GetPopulation().GetCell(idA1));
     }
   }
 };
@@ -3986,14 +3984,12 @@ public:
       cerr << "cellB: " << temp_x << " " << temp_y << endl;
 #endif
       
-      tList<cPopulationCell>& cellA_list = cellA.ConnectionList();
-      tList<cPopulationCell>& cellB_list = cellB.ConnectionList();
-      cellA_list.Remove(&m_world->GetPopulation().GetCell(idB));
-      cellA_list.Remove(&m_world->GetPopulation().GetCell(idB0));
-      cellA_list.Remove(&m_world->GetPopulation().GetCell(idB1));
-      cellB_list.Remove(&m_world->GetPopulation().GetCell(idA));
-      cellB_list.Remove(&m_world->GetPopulation().GetCell(idA0));
-      cellB_list.Remove(&m_world->GetPopulation().GetCell(idA1));
+      cellA.RemoveConnection(m_world->GetPopulation().GetCell(idB));
+      cellA.RemoveConnection(m_world->GetPopulation().GetCell(idB0));
+      cellA.RemoveConnection(m_world->GetPopulation().GetCell(idB1));
+      cellB.RemoveConnection(m_world->GetPopulation().GetCell(idA));
+      cellB.RemoveConnection(m_world->GetPopulation().GetCell(idA0));
+      cellB.RemoveConnection(m_world->GetPopulation().GetCell(idA1));
     }
   }
 };
@@ -4047,28 +4043,24 @@ public:
       cPopulationCell& cellA = m_world->GetPopulation().GetCell(idA);
       cPopulationCell& cellB = m_world->GetPopulation().GetCell(idB);
       
-      //grab the cell lists
-      tList<cPopulationCell>& cellA_list = cellA.ConnectionList();
-      tList<cPopulationCell>& cellB_list = cellB.ConnectionList();
-      
       //these cells are always joined
-      if (cellA_list.FindPtr(&cellB)  == NULL) cellA_list.Push(&cellB);
-      if (cellB_list.FindPtr(&cellA)  == NULL) cellB_list.Push(&cellA);
+      if (!cellA.HasConnection(cellB)) cellA.AddConnection(cellB, true);
+      if (!cellB.HasConnection(cellA)) cellB.AddConnection(cellA, true);
       
       //make sure we don't break the bounded grid at the top
       if((nGeometry::GRID == geometry && row_id != 0) || nGeometry::GRID != geometry){
         cPopulationCell& cellA0 = m_world->GetPopulation().GetCell(GridNeighbor(idA, world_x, world_y,  0, -1));
         cPopulationCell& cellB0 = m_world->GetPopulation().GetCell(GridNeighbor(idA, world_x, world_y, -1, -1));
-        if (cellA_list.FindPtr(&cellB0) == NULL) cellA_list.Push(&cellB0);
-        if (cellB_list.FindPtr(&cellA0) == NULL) cellB_list.Push(&cellA0);
+        if (!cellA.HasConnection(cellB0)) cellA.AddConnection(cellB0, true);
+        if (!cellB.HasConnection(cellA0)) cellB.AddConnection(cellA0, true);
       }
       
       //make sure we don't break the bounded grid at the bottom
       if((nGeometry::GRID == geometry && row_id != (world_y-1)) || nGeometry::GRID != geometry){
         cPopulationCell& cellA1 = m_world->GetPopulation().GetCell(GridNeighbor(idA, world_x, world_y,  0,  1));
         cPopulationCell& cellB1 = m_world->GetPopulation().GetCell(GridNeighbor(idA, world_x, world_y, -1,  1));
-        if (cellA_list.FindPtr(&cellB1) == NULL) cellA_list.Push(&cellB1);
-        if (cellB_list.FindPtr(&cellA1) == NULL) cellB_list.Push(&cellA1);
+        if (!cellA.HasConnection(cellB1)) cellA.AddConnection(cellB1, true);
+        if (!cellB.HasConnection(cellA1)) cellB.AddConnection(cellA1, true);
       }
     }
   }
@@ -4123,28 +4115,24 @@ public:
       cPopulationCell& cellA = m_world->GetPopulation().GetCell(idA);
       cPopulationCell& cellB = m_world->GetPopulation().GetCell(idB);
       
-      //grab the cell lists
-      tList<cPopulationCell>& cellA_list = cellA.ConnectionList();
-      tList<cPopulationCell>& cellB_list = cellB.ConnectionList();
-      
       //these cells are always joined
-      if (cellA_list.FindPtr(&cellB)  == NULL) cellA_list.Push(&cellB);
-      if (cellB_list.FindPtr(&cellA)  == NULL) cellB_list.Push(&cellA);
+      if (!cellA.HasConnection(cellB)) cellA.AddConnection(cellB, true);
+      if (!cellB.HasConnection(cellA)) cellB.AddConnection(cellA, true);
       
       //make sure we don't break the bounded grid on the left
       if((nGeometry::GRID == geometry && col_id != 0) || nGeometry::GRID != geometry){
         cPopulationCell& cellA0 = m_world->GetPopulation().GetCell(GridNeighbor(idA, world_x, world_y, -1,  0));
         cPopulationCell& cellB0 = m_world->GetPopulation().GetCell(GridNeighbor(idA, world_x, world_y, -1, -1));
-        if (cellA_list.FindPtr(&cellB0) == NULL) cellA_list.Push(&cellB0);
-        if (cellB_list.FindPtr(&cellA0) == NULL) cellB_list.Push(&cellA0);
+        if (!cellA.HasConnection(cellB0)) cellA.AddConnection(cellB0, true);
+        if (!cellB.HasConnection(cellA0)) cellB.AddConnection(cellA0, true);
       }
       
       //make cure we don't break the bounded grid on the right
       if((nGeometry::GRID == geometry && col_id != (world_x-1)) || nGeometry::GRID != geometry){
         cPopulationCell& cellA1 = m_world->GetPopulation().GetCell(GridNeighbor(idA, world_x, world_y,  1,  0));
         cPopulationCell& cellB1 = m_world->GetPopulation().GetCell(GridNeighbor(idA, world_x, world_y,  1, -1));
-        if (cellA_list.FindPtr(&cellB1) == NULL) cellA_list.Push(&cellB1);
-        if (cellB_list.FindPtr(&cellA1) == NULL) cellB_list.Push(&cellA1);
+        if (!cellA.HasConnection(cellB1)) cellA.AddConnection(cellB1, true);
+        if (!cellB.HasConnection(cellA1)) cellB.AddConnection(cellA1, true);
       }
     }
   }
@@ -4183,10 +4171,8 @@ public:
     int idB = m_b_y * world_x + m_b_x;
     cPopulationCell& cellA = m_world->GetPopulation().GetCell(idA);
     cPopulationCell& cellB = m_world->GetPopulation().GetCell(idB);
-    tList<cPopulationCell>& cellA_list = cellA.ConnectionList();
-    tList<cPopulationCell>& cellB_list = cellB.ConnectionList();
-    cellA_list.PushRear(&cellB);
-    cellB_list.PushRear(&cellA);
+    cellA.AddConnection(cellB);
+    cellB.AddConnection(cellA);
   }
 };
 
@@ -4223,10 +4209,8 @@ public:
     int idB = m_b_y * world_x + m_b_x;
     cPopulationCell& cellA = m_world->GetPopulation().GetCell(idA);
     cPopulationCell& cellB = m_world->GetPopulation().GetCell(idB);
-    tList<cPopulationCell>& cellA_list = cellA.ConnectionList();
-    tList<cPopulationCell>& cellB_list = cellB.ConnectionList();
-    cellA_list.Remove(&cellB);
-    cellB_list.Remove(&cellA);
+    cellA.RemoveConnection(cellB);
+    cellB.RemoveConnection(cellA);
   }
 };
 
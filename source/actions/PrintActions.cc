@@ -108,7 +108,9 @@ STATS_OUT_FILE(PrintCurrentReactionData,    cur_reactions.dat   );
 STATS_OUT_FILE(PrintReactionRewardData,     reaction_reward.dat );
 STATS_OUT_FILE(PrintCurrentReactionRewardData,     cur_reaction_reward.dat );
 STATS_OUT_FILE(PrintTimeData,               time.dat            );
+STATS_OUT_FILE(PrintAllocatorData,          allocator.dat       );
 STATS_OUT_FILE(PrintExtendedTimeData,       xtime.dat           );
+STATS_OUT_FILE(PrintTestCPUData,            testcpu.dat         );
 STATS_OUT_FILE(PrintMutationRateData,       mutation_rates.dat  );
 STATS_OUT_FILE(PrintDivideMutData,          divide_mut.dat      );
 STATS_OUT_FILE(PrintParasiteData,           parasite.dat        );
@@ -2367,7 +2369,8 @@ public:
       tListIterator<cAnalyzeGenotype> batch_it(m_world->GetAnalyze().GetCurrentBatch().List());
       cAnalyzeGenotype* genotype = NULL;
       while((genotype = batch_it.Next())){
-        Apto::SmartPtr<cPhenPlastGenotype> ppgen(new cPhenPlastGenotype(genotype->GetGenome(), m_num_trials, test_info, m_world, ctx));
+        Apto::SmartPtr<cPhenPlastGenotype> ppgen(new cPhenPlastGenotype(genotype->GetGenome(), m_num_trials, test_info, m_world, ctx,
+                                                                        m_world->GetAnalyze().GetJobQueue()));
         PrintPPG(fot, ppgen, genotype->GetID(), genotype->GetParents());
       }
     } else{  // Run mode
@@ -5257,7 +5260,9 @@ void RegisterPrintActions(cActionLibrary* action_lib)
   action_lib->Register<cActionPrintReactionRewardData>("PrintReactionRewardData");
   action_lib->Register<cActionPrintCurrentReactionRewardData>("PrintCurrentReactionRewardData");
   action_lib->Register<cActionPrintTimeData>("PrintTimeData");
+  action_lib->Register<cActionPrintAllocatorData>("PrintAllocatorData");
   action_lib->Register<cActionPrintExtendedTimeData>("PrintExtendedTimeData");
+  action_lib->Register<cActionPrintTestCPUData>("PrintTestCPUData");
   action_lib->Register<cActionPrintMutationRateData>("PrintMutationRateData");
   action_lib->Register<cActionPrintDivideMutData>("PrintDivideMutData");
   action_lib->Register<cActionPrintParasiteData>("PrintParasiteData");
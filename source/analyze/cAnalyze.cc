@@ -54,7 +54,9 @@
 #include "cInitFile.h"
 #include "cInstSet.h"
 #include "cLandscape.h"
+#include "cMappedInitFile.h"
 #include "cModularityAnalysis.h"
+#include "cPairwiseDistance.h"
 #include "cPhenotype.h"
 #include "cPhenPlastGenotype.h"
 #include "cPlasticPhenotype.h"
@@ -766,6 +768,67 @@ double cAnalyze::IncreasedInfo(cAnalyzeGenotype * genotype1,
   return increased_info;
 }
 
+// Parses a contiguous range of lines of a genotype_data file into analyze genotypes, run as a job by LoadFile.  Lines
+// come from the mapped file, or when the file had to be read by cInitFile, from a copy of its lines.
+class cAnalyzeLoadChunk
+{
+public:
+  static const int CHUNK_LINES = 2048;
+
+private:
+  cWorld* m_world;
+  const cMappedInitFile& m_input_file;
+  const Apto::Array<cString, Apto::Smart>& m_full_lines;
+  const Apto::Array<tDataEntryCommand<cAnalyzeGenotype>*>& m_columns;
+  Genome m_default_genome;
+  int m_begin;
+  int m_end;
+  bool m_id_inc;
+  tList<cAnalyzeGenotype> m_genotypes;
+
+public:
+  cAnalyzeLoadChunk(cWorld* world, const cMappedInitFile& input_file, const Apto::Array<cString, Apto::Smart>& full_lines,
+                    const Apto::Array<tDataEntryCommand<cAnalyzeGenotype>*>& columns, const Genome& default_genome,
+                    int begin, int end, bool id_inc)
+    : m_world(world), m_input_file(input_file), m_full_lines(full_lines), m_columns(columns)
+    , m_default_genome(default_genome), m_begin(begin), m_end(end), m_id_inc(id_inc) { ; }
+
+  tList<cAnalyzeGenotype>& GetGenotypes() { return m_genotypes; }
+
+  void Parse(cAvidaContext&)
+  {
+    for (int line_id = m_begin; line_id < m_end; line_id++) {
+      if (m_input_file.NeedsInitFile()) {
+        cString cur_line = m_full_lines[line_id];
+        parseLine(cur_line, line_id);
+      } else {
+        cMappedInitFile::cLineView cur_line = m_input_file.GetLineView(line_id);
+        parseLine(cur_line, line_id);
+      }
+    }
+  }
+
+private:
+  template <class LineType> void parseLine(LineType& cur_line, int line_id)
+  {
+    cAnalyzeGenotype* genotype = new cAnalyzeGenotype(m_world, m_default_genome);
+    
+    for (int i = 0; i < m_columns.GetSize(); i++) m_columns[i]->SetValue(genotype, cur_line.PopWord());
+    
+    // Give this genotype a name.  Base it on the ID if possible, otherwise on the load order (one per line).
+    if (m_id_inc == false) {
+      cString name = cStringUtil::Stringf("org-%d", line_id);
+      genotype->SetName(name);
+    }
+    else {
+      cString name = cStringUtil::Stringf("org-%d", genotype->GetID());
+      genotype->SetName(name);
+    }
+    
+    m_genotypes.PushRear(genotype);
+  }
+};
+
 void cAnalyze::LoadFile(cString cur_string)
 {
   // LOAD
@@ -774,9 +837,15 @@ void cAnalyze::LoadFile(cString cur_string)
   
   cout << "Loading: " << filename << endl;
   
-  cInitFile input_file(filename, m_world->GetWorkingDir());
-  if (!input_file.WasOpened()) {
-    const cUserFeedback& feedback = input_file.GetFeedback();
+  // Genotype files can be very large, map them rather than copying every line into memory, unless they rely on
+  // directives that only cInitFile supports
+  cMappedInitFile input_file(filename, m_world->GetWorkingDir());
+  const bool use_full_file = input_file.NeedsInitFile();
+  Apto::SmartPtr<cInitFile> full_input_file;
+  if (use_full_file) full_input_file = Apto::SmartPtr<cInitFile>(new cInitFile(filename, m_world->GetWorkingDir()));
+  
+  if (!((use_full_file) ? full_input_file->WasOpened() : input_file.WasOpened())) {
+    const cUserFeedback& feedback = (use_full_file) ? full_input_file->GetFeedback() : input_file.GetFeedback();
     for (int i = 0; i < feedback.GetNumMessages(); i++) {
       switch (feedback.GetMessageType(i)) {
         case cUserFeedback::UF_ERROR:    cerr << "error: "; break;
@@ -788,7 +857,8 @@ void cAnalyze::LoadFile(cString cur_string)
     if (exit_on_error) exit(1);
   }
   
-  const cString filetype = input_file.GetFiletype();
+  const cString filetype = (use_full_file) ? full_input_file->GetFiletype() : input_file.GetFiletype();
+  const cStringList& format = (use_full_file) ? full_input_file->GetFormat() : input_file.GetFormat();
   if (filetype != "population_data" &&  // Deprecated
       filetype != "genotype_data") {
     cerr << "error: cannot load files of type \"" << filetype << "\"." << endl;
@@ -804,7 +874,7 @@ void cAnalyze::LoadFile(cString cur_string)
   tList< tDataEntryCommand<cAnalyzeGenotype> > output_list;
   tListIterator< tDataEntryCommand<cAnalyzeGenotype> > output_it(output_list);
   cUserFeedback feedback;
-  cAnalyzeGenotype::GetDataCommandManager().LoadCommandList(input_file.GetFormat(), output_list, &feedback);
+  cAnalyzeGenotype::GetDataCommandManager().LoadCommandList(format, output_list, &feedback);
   
   for (int i = 0; i < feedback.GetNumMessages(); i++) {
     switch (feedback.GetMessageType(i)) {
@@ -817,38 +887,43 @@ void cAnalyze::LoadFile(cString cur_string)
   
   if (feedback.GetNumErrors()) return;
   
-  bool id_inc = input_file.GetFormat().HasString("id");
+  bool id_inc = format.HasString("id");
   
   // Setup the genome...
   const cInstSet& is = m_world->GetHardwareManager().GetDefaultInstSet();
   HashPropertyMap props;
   cHardwareManager::SetupPropertyMap(props, (const char*)is.GetInstSetName());
   Genome default_genome(is.GetHardwareType(), props, GeneticRepresentationPtr(new InstructionSequence(1)));
-  int load_count = 0;
   
-  for (int line_id = 0; line_id < input_file.GetNumLines(); line_id++) {
-    cString cur_line = input_file.GetLine(line_id);
-    
-    cAnalyzeGenotype* genotype = new cAnalyzeGenotype(m_world, default_genome);
-    
-    output_it.Reset();
-    tDataEntryCommand<cAnalyzeGenotype>* data_command = NULL;
-    while ((data_command = output_it.Next()) != NULL) {
-      data_command->SetValue(genotype, cur_line.PopWord());
-    }
-    
-    // Give this genotype a name.  Base it on the ID if possible.
-    if (id_inc == false) {
-      cString name = cStringUtil::Stringf("org-%d", load_count++);
-      genotype->SetName(name);
-    }
-    else {
-      cString name = cStringUtil::Stringf("org-%d", genotype->GetID());
-      genotype->SetName(name);
-    }
-    
-    // Add this genotype to the proper batch.
-    batch[cur_batch].List().PushRear(genotype);
+  // Flatten the column commands so that the parsing jobs can share them without touching the list iterators
+  Apto::Array<tDataEntryCommand<cAnalyzeGenotype>*> columns;
+  tDataEntryCommand<cAnalyzeGenotype>* data_command = NULL;
+  while ((data_command = output_it.Next()) != NULL) columns.Push(data_command);
+  
+  // The file was fully indexed when opened, so the line views can be safely read from all jobs.  The accessors of
+  // cInitFile are not const, so its lines are copied out up front instead.
+  const int num_lines = (use_full_file) ? full_input_file->GetNumLines() : input_file.GetNumLines();
+  Apto::Array<cString, Apto::Smart> full_lines;
+  if (use_full_file) {
+    full_lines.Resize(num_lines);
+    for (int line_id = 0; line_id < num_lines; line_id++) full_lines[line_id] = full_input_file->GetLine(line_id);
+  }
+  
+  // Parse line ranges in parallel, then splice the results into the batch in file order
+  Apto::Array<cAnalyzeLoadChunk*> chunks;
+  tAnalyzeJobBatch<cAnalyzeLoadChunk> jobbatch(m_jobqueue);
+  for (int begin = 0; begin < num_lines; begin += cAnalyzeLoadChunk::CHUNK_LINES) {
+    const int end = Apto::Min(begin + cAnalyzeLoadChunk::CHUNK_LINES, num_lines);
+    cAnalyzeLoadChunk* chunk = new cAnalyzeLoadChunk(m_world, input_file, full_lines, columns, default_genome, begin, end, id_inc);
+    chunks.Push(chunk);
+    jobbatch.AddJob(chunk, &cAnalyzeLoadChunk::Parse);
+  }
+  jobbatch.RunBatch();
+  
+  for (int i = 0; i < chunks.GetSize(); i++) {
+    tList<cAnalyzeGenotype>& genotypes = chunks[i]->GetGenotypes();
+    while (genotypes.GetSize()) batch[cur_batch].List().PushRear(genotypes.Pop());
+    delete chunks[i];
   }
   
   // Adjust the flags on this batch
@@ -5893,6 +5968,7 @@ void cAnalyze::CommandHamming(cString cur_string)
   
   int batch1 = PopBatch(cur_string.PopWord());
   int batch2 = PopBatch(cur_string.PopWord());
+  cString matrix_file = cur_string.PopWord();
   
   // We want batch2 to be the larger one for efficiency...
   if (batch[batch1].List().GetSize() > batch[batch2].List().GetSize()) {
@@ -5908,45 +5984,11 @@ void cAnalyze::CommandHamming(cString cur_string)
     cout.flush();
   }
   
-  // Setup some variables;
-  cAnalyzeGenotype * genotype1 = NULL;
-  cAnalyzeGenotype * genotype2 = NULL;
-
-  double total_dist = 0;
-  double total_count = 0;
-  
-  tListIterator<cAnalyzeGenotype> list1_it(batch[batch1].List());
-  tListIterator<cAnalyzeGenotype> list2_it(batch[batch2].List());
-  
-  while ((genotype1 = list1_it.Next()) != NULL) {
-    list2_it.Reset();
-    while ((genotype2 = list2_it.Next()) != NULL) {
-      // Determine the counts...
-      const int count1 = genotype1->GetNumCPUs();
-      const int count2 = genotype2->GetNumCPUs();
-      const int num_pairs = (genotype1 == genotype2) ?
-        ((count1 - 1) * (count2 - 1)) : (count1 * count2);
-      if (num_pairs == 0) continue;
-      
-      // And do the tests...
-      const Genome& genotype1_genome = genotype1->GetGenome();
-      ConstInstructionSequencePtr genotype1_seq_p;
-      ConstGeneticRepresentationPtr genotype1_rep_p = genotype1_genome.Representation();
-      genotype1_seq_p.DynamicCastFrom(genotype1_rep_p);
-      const InstructionSequence& genotype1_seq = *genotype1_seq_p;
-      
-      const Genome& genotype2_genome = genotype2->GetGenome();
-      ConstInstructionSequencePtr genotype2_seq_p;
-      ConstGeneticRepresentationPtr genotype2_rep_p = genotype2_genome.Representation();
-      genotype2_seq_p.DynamicCastFrom(genotype2_rep_p);
-      const InstructionSequence& genotype2_seq = *genotype2_seq_p;
-
-      const int dist = InstructionSequence::FindHammingDistance(genotype1_seq, genotype2_seq);
-      total_dist += dist * num_pairs;
-      total_count += num_pairs;
-    }
-  }
-  
+  // Evaluate all pairs across the analyze workers
+  cPairwiseDistance distances(m_world, m_jobqueue, cPairwiseDistance::HAMMING);
+  if (!distances.Calculate(m_ctx, batch[batch1].List(), batch[batch2].List(), matrix_file) && exit_on_error) exit(1);
+  const double total_dist = distances.GetTotalDistance();
+  const double total_count = distances.GetTotalCount();
   
   // Calculate the final answer
   double ave_dist = (double) total_dist / (double) total_count;
@@ -5971,6 +6013,7 @@ void cAnalyze::CommandLevenstein(cString cur_string)
   
   int batch1 = PopBatch(cur_string.PopWord());
   int batch2 = PopBatch(cur_string.PopWord());
+  cString matrix_file = cur_string.PopWord();
   
   // We want batch2 to be the larger one for efficiency...
   if (batch[batch1].List().GetSize() > batch[batch2].List().GetSize()) {
@@ -5986,44 +6029,11 @@ void cAnalyze::CommandLevenstein(cString cur_string)
     cout.flush();
   }
   
-  // Setup some variables;
-  cAnalyzeGenotype * genotype1 = NULL;
-  cAnalyzeGenotype * genotype2 = NULL;
-  double total_dist = 0;
-  double total_count = 0;
-  
-  tListIterator<cAnalyzeGenotype> list1_it(batch[batch1].List());
-  tListIterator<cAnalyzeGenotype> list2_it(batch[batch2].List());
-  
-  // Loop through all of the genotypes in each batch...
-  while ((genotype1 = list1_it.Next()) != NULL) {
-    list2_it.Reset();
-    while ((genotype2 = list2_it.Next()) != NULL) {
-      // Determine the counts...
-      const int count1 = genotype1->GetNumCPUs();
-      const int count2 = genotype2->GetNumCPUs();
-      const int num_pairs = (genotype1 == genotype2) ?
-        ((count1 - 1) * (count2 - 1)) : (count1 * count2);
-      if (num_pairs == 0) continue;
-      
-      // And do the tests...
-      const Genome& genotype1_genome = genotype1->GetGenome();
-      ConstInstructionSequencePtr genotype1_seq_p;
-      ConstGeneticRepresentationPtr genotype1_rep_p = genotype1_genome.Representation();
-      genotype1_seq_p.DynamicCastFrom(genotype1_rep_p);
-      const InstructionSequence& genotype1_seq = *genotype1_seq_p;
-
-      const Genome& genotype2_genome = genotype2->GetGenome();
-      ConstInstructionSequencePtr genotype2_seq_p;
-      ConstGeneticRepresentationPtr genotype2_rep_p = genotype2_genome.Representation();
-      genotype2_seq_p.DynamicCastFrom(genotype2_rep_p);
-      const InstructionSequence& genotype2_seq = *genotype2_seq_p;
-
-      const int dist = InstructionSequence::FindEditDistance(genotype1_seq, genotype2_seq);
-      total_dist += dist * num_pairs;
-      total_count += num_pairs;
-    }
-  }
+  // Evaluate all pairs across the analyze workers
+  cPairwiseDistance distances(m_world, m_jobqueue, cPairwiseDistance::LEVENSTEIN);
+  if (!distances.Calculate(m_ctx, batch[batch1].List(), batch[batch2].List(), matrix_file) && exit_on_error) exit(1);
+  const double total_dist = distances.GetTotalDistance();
+  const double total_count = distances.GetTotalCount();
   
   // Calculate the final answer
   double ave_dist = (double) total_dist / (double) total_count;
@@ -6059,101 +6069,11 @@ void cAnalyze::CommandSpecies(cString cur_string)
   else cout << "Calculating Species Distance between batch "
     << batch1 << " and " << batch2 << endl;
   
-  // Setup some variables;
-  cAnalyzeGenotype * genotype1 = NULL;
-  cAnalyzeGenotype * genotype2 = NULL;
-  int total_fail = 0;
-  int total_count = 0;
-  
-  cTestCPU* testcpu = m_world->GetHardwareManager().CreateTestCPU(m_ctx);
-  
-  tListIterator<cAnalyzeGenotype> list1_it(batch[batch1].List());
-  tListIterator<cAnalyzeGenotype> list2_it(batch[batch2].List());
-  
-  // Loop through all of the genotypes in each batch...
-  while ((genotype1 = list1_it.Next()) != NULL) {
-    list2_it.Reset();
-    while ((genotype2 = list2_it.Next()) != NULL) {
-      // Determine the counts...
-      const int count1 = genotype1->GetNumCPUs();
-      const int count2 = genotype2->GetNumCPUs();
-      int num_pairs = count1 * count2; 
-      int fail_count = 0;
-      bool cross1_viable = true;
-      bool cross2_viable = true;
-      
-      
-      if (genotype1 == genotype2) {
-        total_count += num_pairs * 2 * num_compare;
-      }
-      else {	
-        assert(num_compare!=0);
-        // And do the tests...
-        for (int iter=1; iter < num_compare; iter++) {
-          Genome test_genome0 = genotype1->GetGenome(); 
-          InstructionSequencePtr test_genome0_seq_p;
-          GeneticRepresentationPtr test_genome0_rep_p = test_genome0.Representation();
-          test_genome0_seq_p.DynamicCastFrom(test_genome0_rep_p);
-          InstructionSequence& test_genome0_seq = *test_genome0_seq_p;
-          
-          Genome test_genome1 = genotype2->GetGenome(); 
-          InstructionSequencePtr test_genome1_seq_p;
-          GeneticRepresentationPtr test_genome1_rep_p = test_genome1.Representation();
-          test_genome1_seq_p.DynamicCastFrom(test_genome1_rep_p);
-          InstructionSequence& test_genome1_seq = *test_genome1_seq_p;
-         
-          double start_frac = m_world->GetRandom().GetDouble();
-          double end_frac = m_world->GetRandom().GetDouble();
-          if (start_frac > end_frac) Swap(start_frac, end_frac);
-          
-          int start0 = (int) (start_frac * (double) test_genome0_seq.GetSize());
-          int end0   = (int) (end_frac * (double) test_genome0_seq.GetSize());
-          int start1 = (int) (start_frac * (double) test_genome1_seq.GetSize());
-          int end1   = (int) (end_frac * (double) test_genome1_seq.GetSize());
-          assert( start0 >= 0  &&  start0 < test_genome0_seq.GetSize() );
-          assert( end0   >= 0  &&  end0   < test_genome0_seq.GetSize() );
-          assert( start1 >= 0  &&  start1 < test_genome1_seq.GetSize() );
-          assert( end1   >= 0  &&  end1   < test_genome1_seq.GetSize() );
-          
-          // Calculate size of sections crossing over...    
-          int size0 = end0 - start0;
-          int size1 = end1 - start1;
-          
-          int new_size0 = test_genome0_seq.GetSize() - size0 + size1;   
-          int new_size1 = test_genome1_seq.GetSize() - size1 + size0;
-          
-          // Don't Crossover if offspring will be illegal!!!
-          if (new_size0 < MIN_GENOME_LENGTH || new_size0 > MAX_GENOME_LENGTH || 
-              new_size1 < MIN_GENOME_LENGTH || new_size1 > MAX_GENOME_LENGTH) { 
-            fail_count +=2; 
-            break; 
-          } 
-          
-          // Swap the components
-          InstructionSequence cross0 = test_genome0_seq.Crop(start0, end0);
-          InstructionSequence cross1 = test_genome1_seq.Crop(start1, end1);
-          test_genome0_seq.Replace(start0, size0, cross1);
-          test_genome1_seq.Replace(start1, size1, cross0);
-          
-          // Run each side, and determine viability...
-          cCPUTestInfo test_info;
-          testcpu->TestGenome(m_ctx, test_info, test_genome0);
-          cross1_viable = test_info.IsViable();
-          
-          testcpu->TestGenome(m_ctx, test_info, test_genome1);
-          cross2_viable = test_info.IsViable();
-          
-          if (cross1_viable == false) fail_count++;   
-          if (cross2_viable == false) fail_count++;
-        }
-        
-        total_fail += fail_count * num_pairs;
-        total_count += num_pairs * 2 * num_compare;
-      }
-    }
-  }
-  
-  delete testcpu;
+  // Evaluate all pairs across the analyze workers, each with its own test CPU
+  cPairwiseDistance distances(m_world, m_jobqueue, cPairwiseDistance::SPECIES, num_compare);
+  distances.Calculate(m_ctx, batch[batch1].List(), batch[batch2].List());
+  const int total_fail = static_cast<int>(distances.GetTotalDistance());
+  const int total_count = static_cast<int>(distances.GetTotalCount());
   
   // Calculate the final answer
   double ave_dist = (double) total_fail / (double) total_count;
@@ -0,0 +1,369 @@
+/*
+ *  cPairwiseDistance.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cPairwiseDistance.h"
+
+#include "avida/core/Definitions.h"
+#include "avida/core/Genome.h"
+#include "avida/core/WorldDriver.h"
+#include "avida/output/Manager.h"
+
+#include "apto/rng.h"
+
+#include "AvidaTools.h"
+
+#include "cAnalyzeGenotype.h"
+#include "cAnalyzeJobQueue.h"
+#include "cAvidaContext.h"
+#include "cCPUTestInfo.h"
+#include "cHardwareManager.h"
+#include "cTestCPU.h"
+#include "cWorld.h"
+#include "tAnalyzeJobBatch.h"
+
+#include <fstream>
+
+
+static void writeInt32(std::ostream& fp, int value)
+{
+  const unsigned int uvalue = static_cast<unsigned int>(value);
+  unsigned char buf[4];
+  for (int i = 0; i < 4; i++) buf[i] = static_cast<unsigned char>((uvalue >> (8 * i)) & 0xFF);
+  fp.write(reinterpret_cast<const char*>(buf), 4);
+}
+
+
+// A contiguous range of rows of the pair matrix, evaluated as a single analyze job.  SPECIES bands seed their own
+// context, so that the recombinations tested do not depend on which worker thread runs the band.
+class cPairwiseDistance::cBand
+{
+private:
+  cPairwiseDistance* m_engine;
+  int m_row_begin;
+  int m_row_end;
+  bool m_store;
+  int m_seed;
+
+public:
+  double total;
+  double count;
+  Apto::Array<int, Apto::Smart> distances;   // matrix rows of this band, in file order (only when storing)
+
+  cBand(cPairwiseDistance* engine, int row_begin, int row_end, bool store, int seed)
+    : m_engine(engine), m_row_begin(row_begin), m_row_end(row_end), m_store(store), m_seed(seed), total(0.0), count(0.0) { ; }
+
+  void Run(cAvidaContext&)
+  {
+    if (m_engine->m_measure == SPECIES) {
+      Apto::RNG::AvidaRNG rng(m_seed);
+      cAvidaContext ctx(&m_engine->m_world->GetDriver(), rng);
+      ctx.SetAnalyzeMode();
+      runSpecies(ctx);
+    } else {
+      runSequence();
+    }
+  }
+
+private:
+  void runSequence();
+  void runSpecies(cAvidaContext& ctx);
+};
+
+
+void cPairwiseDistance::cBand::runSequence()
+{
+  const cPairwiseDistance& engine = *m_engine;
+  const Instruction* insts = (engine.m_insts.GetSize()) ? &engine.m_insts[0] : NULL;
+  const int num_cols = engine.m_side2.genotypes.GetSize();
+  const bool symmetric = engine.m_symmetric;
+
+  Apto::Array<int> row_offsets(m_row_end - m_row_begin);
+  if (m_store) {
+    int size = 0;
+    for (int row = m_row_begin; row < m_row_end; row++) {
+      row_offsets[row - m_row_begin] = size;
+      size += engine.rowLength(row);
+    }
+    distances.Resize(size);
+  }
+
+  // Visit the columns in blocks so that the band's row genomes and the current column genomes remain in cache
+  for (int block = 0; block < num_cols; block += COLUMN_BLOCK) {
+    const int block_end = Apto::Min(block + COLUMN_BLOCK, num_cols);
+    for (int row = m_row_begin; row < m_row_end; row++) {
+      const int first_col = (symmetric) ? Apto::Max(block, row + 1) : block;
+      for (int col = first_col; col < block_end; col++) {
+        const int dist = engine.sequenceDistance(insts, row, col);
+        engine.addSequencePair(row, col, dist, total, count);
+        if (m_store) distances[row_offsets[row - m_row_begin] + col - ((symmetric) ? row + 1 : 0)] = dist;
+      }
+    }
+  }
+
+  // The diagonal (each genotype with itself) is never stored, but does count towards the pairs tested
+  if (symmetric) {
+    for (int row = m_row_begin; row < m_row_end; row++) engine.addSequencePair(row, row, 0, total, count);
+  }
+}
+
+
+void cPairwiseDistance::cBand::runSpecies(cAvidaContext& ctx)
+{
+  const cPairwiseDistance& engine = *m_engine;
+  const int num_cols = engine.m_side2.genotypes.GetSize();
+  const int num_compare = engine.m_num_compare;
+
+  cTestCPU* testcpu = engine.m_world->GetHardwareManager().CreateTestCPU(ctx);
+
+  for (int row = m_row_begin; row < m_row_end; row++) {
+    cAnalyzeGenotype* genotype1 = engine.m_side1.genotypes[row];
+    for (int col = 0; col < num_cols; col++) {
+      cAnalyzeGenotype* genotype2 = engine.m_side2.genotypes[col];
+
+      // Determine the counts...
+      const int count1 = engine.m_side1.counts[row];
+      const int count2 = engine.m_side2.counts[col];
+      int num_pairs = count1 * count2;
+      int fail_count = 0;
+
+      if (genotype1 == genotype2) {
+        count += num_pairs * 2 * num_compare;
+        continue;
+      }
+
+      assert(num_compare != 0);
+      // And do the tests...
+      for (int iter = 1; iter < num_compare; iter++) {
+        Genome test_genome0 = genotype1->GetGenome();
+        InstructionSequencePtr test_genome0_seq_p;
+        GeneticRepresentationPtr test_genome0_rep_p = test_genome0.Representation();
+        test_genome0_seq_p.DynamicCastFrom(test_genome0_rep_p);
+        InstructionSequence& test_genome0_seq = *test_genome0_seq_p;
+
+        Genome test_genome1 = genotype2->GetGenome();
+        InstructionSequencePtr test_genome1_seq_p;
+        GeneticRepresentationPtr test_genome1_rep_p = test_genome1.Representation();
+        test_genome1_seq_p.DynamicCastFrom(test_genome1_rep_p);
+        InstructionSequence& test_genome1_seq = *test_genome1_seq_p;
+
+        double start_frac = ctx.GetRandom().GetDouble();
+        double end_frac = ctx.GetRandom().GetDouble();
+        if (start_frac > end_frac) AvidaTools::Swap(start_frac, end_frac);
+
+        int start0 = (int) (start_frac * (double) test_genome0_seq.GetSize());
+        int end0   = (int) (end_frac * (double) test_genome0_seq.GetSize());
+        int start1 = (int) (start_frac * (double) test_genome1_seq.GetSize());
+        int end1   = (int) (end_frac * (double) test_genome1_seq.GetSize());
+        assert( start0 >= 0  &&  start0 < test_genome0_seq.GetSize() );
+        assert( end0   >= 0  &&  end0   < test_genome0_seq.GetSize() );
+        assert( start1 >= 0  &&  start1 < test_genome1_seq.GetSize() );
+        assert( end1   >= 0  &&  end1   < test_genome1_seq.GetSize() );
+
+        // Calculate size of sections crossing over...
+        int size0 = end0 - start0;
+        int size1 = end1 - start1;
+
+        int new_size0 = test_genome0_seq.GetSize() - size0 + size1;
+        int new_size1 = test_genome1_seq.GetSize() - size1 + size0;
+
+        // Don't Crossover if offspring will be illegal!!!
+        if (new_size0 < MIN_GENOME_LENGTH || new_size0 > MAX_GENOME_LENGTH ||
+            new_size1 < MIN_GENOME_LENGTH || new_size1 > MAX_GENOME_LENGTH) {
+          fail_count += 2;
+          break;
+        }
+
+        // Swap the components
+        InstructionSequence cross0 = test_genome0_seq.Crop(start0, end0);
+        InstructionSequence cross1 = test_genome1_seq.Crop(start1, end1);
+        test_genome0_seq.Replace(start0, size0, cross1);
+        test_genome1_seq.Replace(start1, size1, cross0);
+
+        // Run each side, and determine viability...
+        cCPUTestInfo test_info;
+        testcpu->TestGenome(ctx, test_info, test_genome0);
+        if (test_info.IsViable() == false) fail_count++;
+
+        testcpu->TestGenome(ctx, test_info, test_genome1);
+        if (test_info.IsViable() == false) fail_count++;
+      }
+
+      total += fail_count * num_pairs;
+      count += num_pairs * 2 * num_compare;
+    }
+  }
+
+  delete testcpu;
+}
+
+
+
+cPairwiseDistance::cPairwiseDistance(cWorld* world, cAnalyzeJobQueue& jobqueue, eMeasure measure, int num_compare)
+  : m_world(world), m_jobqueue(jobqueue), m_measure(measure), m_num_compare(num_compare), m_symmetric(false)
+  , m_total_dist(0.0), m_total_count(0.0)
+{
+}
+
+
+bool cPairwiseDistance::Calculate(cAvidaContext& ctx, tList<cAnalyzeGenotype>& list1, tList<cAnalyzeGenotype>& list2,
+                                  const cString& matrix_file)
+{
+  m_total_dist = 0.0;
+  m_total_count = 0.0;
+  m_insts.Resize(0);
+
+  // Recombination is random, so SPECIES always evaluates every ordered pair
+  const bool same_list = (&list1 == &list2);
+  const bool sequence_measure = (m_measure != SPECIES);
+  m_symmetric = (same_list && sequence_measure);
+
+  packSide(list1, m_side1, sequence_measure);
+  if (same_list) m_side2 = m_side1;
+  else packSide(list2, m_side2, sequence_measure);
+
+  const int num_rows = m_side1.genotypes.GetSize();
+  const int num_cols = m_side2.genotypes.GetSize();
+
+  // Setup the matrix output, if requested
+  std::ofstream fp;
+  const bool store = (matrix_file.GetSize() > 0 && sequence_measure);
+  if (store) {
+    Apto::String file_path = Avida::Output::Manager::Of(m_world->GetNewWorld())->OutputIDFromPath((const char*)matrix_file);
+    if (file_path.GetSize()) fp.open((const char*)file_path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!fp.good()) {
+      m_world->GetDriver().Feedback().Error("unable to open distance matrix file '%s'", (const char*)matrix_file);
+      return false;
+    }
+
+    fp.write("AVDDMAT1", 8);
+    writeInt32(fp, m_measure);
+    writeInt32(fp, (m_symmetric) ? 1 : 0);
+    writeInt32(fp, num_rows);
+    writeInt32(fp, num_cols);
+    for (int i = 0; i < num_rows; i++) writeInt32(fp, m_side1.genotypes[i]->GetID());
+    if (!m_symmetric) for (int i = 0; i < num_cols; i++) writeInt32(fp, m_side2.genotypes[i]->GetID());
+  }
+
+  // Evaluate the bands in waves, bounding the memory held by stored distances to a wave at a time
+  const int wave_rows = BAND_ROWS * BANDS_PER_WAVE;
+  for (int wave_begin = 0; wave_begin < num_rows; wave_begin += wave_rows) {
+    const int wave_end = Apto::Min(wave_begin + wave_rows, num_rows);
+
+    Apto::Array<cBand*> bands;
+    tAnalyzeJobBatch<cBand> jobbatch(m_jobqueue);
+    for (int row = wave_begin; row < wave_end; row += BAND_ROWS) {
+      // Seeds are drawn in band order before the wave runs; the sequence measures are deterministic and draw nothing
+      const int seed = (sequence_measure) ? 0 : ctx.GetRandom().GetInt(ctx.GetRandom().MaxSeed());
+      cBand* band = new cBand(this, row, Apto::Min(row + BAND_ROWS, wave_end), store, seed);
+      bands.Push(band);
+      jobbatch.AddJob(band, &cBand::Run);
+    }
+    jobbatch.RunBatch();
+
+    // Merge in row order, so that the totals and matrix output do not depend on job scheduling
+    for (int i = 0; i < bands.GetSize(); i++) {
+      m_total_dist += bands[i]->total;
+      m_total_count += bands[i]->count;
+      if (store) {
+        const Apto::Array<int, Apto::Smart>& distances = bands[i]->distances;
+        for (int d = 0; d < distances.GetSize(); d++) writeInt32(fp, distances[d]);
+      }
+      delete bands[i];
+    }
+  }
+
+  if (store) {
+    fp.close();
+    if (fp.fail()) {
+      m_world->GetDriver().Feedback().Error("error writing distance matrix file '%s'", (const char*)matrix_file);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+
+void cPairwiseDistance::packSide(tList<cAnalyzeGenotype>& list, sSide& side, bool pack_sequences)
+{
+  const int num_genotypes = list.GetSize();
+  side.genotypes.Resize(num_genotypes);
+  side.offsets.Resize(num_genotypes);
+  side.sizes.Resize(num_genotypes);
+  side.counts.Resize(num_genotypes);
+
+  tListIterator<cAnalyzeGenotype> list_it(list);
+  cAnalyzeGenotype* genotype = NULL;
+  for (int i = 0; (genotype = list_it.Next()) != NULL; i++) {
+    side.genotypes[i] = genotype;
+    side.counts[i] = genotype->GetNumCPUs();
+    side.offsets[i] = m_insts.GetSize();
+    side.sizes[i] = 0;
+    if (!pack_sequences) continue;
+
+    const Genome& genome = genotype->GetGenome();
+    ConstInstructionSequencePtr seq_p;
+    ConstGeneticRepresentationPtr rep_p = genome.Representation();
+    seq_p.DynamicCastFrom(rep_p);
+    const InstructionSequence& seq = *seq_p;
+
+    side.sizes[i] = seq.GetSize();
+    for (int site = 0; site < seq.GetSize(); site++) m_insts.Push(seq[site]);
+  }
+}
+
+
+int cPairwiseDistance::rowLength(int row) const
+{
+  const int num_cols = m_side2.genotypes.GetSize();
+  return (m_symmetric) ? (num_cols - row - 1) : num_cols;
+}
+
+
+int cPairwiseDistance::sequenceDistance(const Instruction* insts, int idx1, int idx2) const
+{
+  const Instruction* seq1 = insts + m_side1.offsets[idx1];
+  const Instruction* seq2 = insts + m_side2.offsets[idx2];
+  const int size1 = m_side1.sizes[idx1];
+  const int size2 = m_side2.sizes[idx2];
+
+  if (m_measure == HAMMING) return InstructionSequence::FindHammingDistance(seq1, size1, seq2, size2);
+  return InstructionSequence::FindEditDistance(seq1, size1, seq2, size2);
+}
+
+
+void cPairwiseDistance::addSequencePair(int idx1, int idx2, int dist, double& total, double& count) const
+{
+  const int count1 = m_side1.counts[idx1];
+  const int count2 = m_side2.counts[idx2];
+
+  int num_pairs = 0;
+  if (m_side1.genotypes[idx1] == m_side2.genotypes[idx2]) {
+    num_pairs = (count1 - 1) * (count2 - 1);
+  } else {
+    num_pairs = count1 * count2;
+    // Each unordered pair stands in for both orderings of the original nested loops
+    if (m_symmetric) num_pairs *= 2;
+  }
+  if (num_pairs == 0) return;
+
+  total += static_cast<double>(dist) * num_pairs;
+  count += num_pairs;
+}
@@ -0,0 +1,117 @@
+/*
+ *  cPairwiseDistance.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cPairwiseDistance_h
+#define cPairwiseDistance_h
+
+#include "apto/core.h"
+#include "avida/core/InstructionSequence.h"
+
+#include "cString.h"
+#include "tList.h"
+
+class cAnalyzeGenotype;
+class cAnalyzeJobQueue;
+class cAvidaContext;
+class cWorld;
+
+using namespace Avida;
+
+
+// cPairwiseDistance - all-pairs distance engine shared by the HAMMING, LEVENSTEIN and SPECIES analyze commands
+//
+// The pair matrix between two genotype lists is split into bands of rows, which are evaluated as jobs on the analyze job
+// queue in waves; within a band columns are visited in blocks so that the genomes involved stay cache resident.  For the
+// sequence measures all genomes are first packed into a single contiguous instruction buffer.  When both lists are the
+// same, sequence measures only evaluate each unordered pair once.
+//
+// Totals are accumulated exactly as the original serial loops did (all ordered pairs, weighted by organism counts).
+// Optionally, the per-genotype distance matrix for the sequence measures can be written to a binary file.  All fields are
+// 32-bit little endian integers following an 8 byte magic:
+//   "AVDDMAT1", measure, condensed flag, rows, columns, genotype ids of the rows, genotype ids of the columns (omitted
+//   when condensed), distances
+// A list compared with itself is written condensed, that is only pairs i < j in row-major order (the pdist layout
+// used by common clustering packages).  Otherwise the full rows x columns matrix is written.
+class cPairwiseDistance
+{
+public:
+  enum eMeasure {
+    HAMMING,
+    LEVENSTEIN,
+    SPECIES
+  };
+
+  static const int BAND_ROWS = 16;
+  static const int COLUMN_BLOCK = 256;
+  static const int BANDS_PER_WAVE = 64;
+
+private:
+  class cBand;
+  friend class cBand;
+
+  struct sSide
+  {
+    Apto::Array<cAnalyzeGenotype*> genotypes;
+    Apto::Array<int> offsets;     // offset of each genome in m_insts
+    Apto::Array<int> sizes;
+    Apto::Array<int> counts;      // number of organisms (num_cpus) of each genotype
+  };
+
+  cWorld* m_world;
+  cAnalyzeJobQueue& m_jobqueue;
+  eMeasure m_measure;
+  int m_num_compare;
+  bool m_symmetric;
+
+  Apto::Array<Instruction, Apto::Smart> m_insts;
+  sSide m_side1;
+  sSide m_side2;
+
+  double m_total_dist;
+  double m_total_count;
+
+
+  cPairwiseDistance(); // @not_implemented
+  cPairwiseDistance(const cPairwiseDistance&); // @not_implemented
+  cPairwiseDistance& operator=(const cPairwiseDistance&); // @not_implemented
+
+public:
+  cPairwiseDistance(cWorld* world, cAnalyzeJobQueue& jobqueue, eMeasure measure, int num_compare = 0);
+  ~cPairwiseDistance() { ; }
+
+  // Evaluates all pairs between list1 and list2 (which may be the same list).  If matrix_file is not empty, the
+  // genotype distance matrix is also written to that file.  Returns false if the matrix file could not be written.
+  // SPECIES draws one seed per band from ctx, in band order, so its results do not depend on thread scheduling.
+  bool Calculate(cAvidaContext& ctx, tList<cAnalyzeGenotype>& list1, tList<cAnalyzeGenotype>& list2,
+                 const cString& matrix_file = "");
+
+  // Sum of distances (or failed recombinants for SPECIES) and number of pairs (or recombinants) tested
+  double GetTotalDistance() const { return m_total_dist; }
+  double GetTotalCount() const { return m_total_count; }
+
+private:
+  void packSide(tList<cAnalyzeGenotype>& list, sSide& side, bool pack_sequences);
+
+  int rowLength(int row) const;
+  int sequenceDistance(const Instruction* insts, int idx1, int idx2) const;
+  void addSequencePair(int idx1, int idx2, int dist, double& total, double& count) const;
+};
+
+#endif
@@ -26,6 +26,8 @@
 
 #include "AvidaTools.h"
 
+#include <cstring>
+
 using namespace AvidaTools;
 
 
@@ -34,10 +36,25 @@ const double MEMORY_INCREASE_FACTOR = 1.5;
 const double MEMORY_SHRINK_TEST_FACTOR = 4.0;
 
 
+unsigned int Avida::InstructionBuffer::Hash(int size) const
+{
+  assert(size <= GetSize());
+  
+  // FNV-1a over the instruction operands
+  const Apto::Array<Instruction>& seq = m_data->seq;
+  unsigned int hash = 2166136261u;
+  for (int i = 0; i < size; i++) {
+    hash ^= static_cast<unsigned int>(seq[i].GetOp());
+    hash *= 16777619u;
+  }
+  
+  return hash;
+}
+
+
 Avida::InstructionSequence::InstructionSequence(const InstructionSequence& seq)
-: GeneticRepresentation(seq), m_seq(seq.GetSize()), m_active_size(seq.GetSize())
+: GeneticRepresentation(seq), m_seq(seq.m_seq), m_active_size(seq.m_active_size)
 {
-  for (int i = 0; i < m_active_size; i++)  m_seq[i] = seq[i];
 }
 
 Avida::InstructionSequence::InstructionSequence(const Apto::String& str)
@@ -345,11 +362,9 @@ void Avida::InstructionSequence::Rotate(int n)
 
 void Avida::InstructionSequence::operator=(const InstructionSequence& other_seq)
 {
+  // Share the other sequence's storage, it will be copied if either side is modified
   m_active_size = other_seq.m_active_size;
-  m_seq.ResizeClear(m_active_size);
-  
-  // Now that both code arrays are the same size, copy the other one over
-  for (int i = 0; i < m_active_size; i++) m_seq[i] = other_seq[i];
+  m_seq = other_seq.m_seq;
 }
 
 
@@ -361,6 +376,9 @@ bool Avida::InstructionSequence::operator==(const GeneticRepresentation& other_s
   // Make sure the sizes are the same.
   if (m_active_size != seq->m_active_size) return false;
   
+  // Sequences sharing storage are identical
+  if (m_seq.IsSharedWith(seq->m_seq)) return true;
+  
   // Then go through line by line.
   for (int i = 0; i < m_active_size; i++)
     if (m_seq[i] != (*seq)[i]) return false;
@@ -504,6 +522,20 @@ int Avida::InstructionSequence::FindHammingDistance(const InstructionSequence& s
 }
 
 
+int Avida::InstructionSequence::FindHammingDistance(const Instruction* seq1, int size1, const Instruction* seq2, int size2)
+{
+  const int overlap = (size1 < size2) ? size1 : size2;
+  
+  // Everything protruding past the overlap counts as a difference, then add all differences within it.
+  int hamming_distance = abs(size1 - size2);
+  for (int i = 0; i < overlap; i++) {
+    if (seq1[i] != seq2[i]) hamming_distance++;
+  }
+  
+  return hamming_distance;
+}
+
+
 int Avida::InstructionSequence::FindBestOffset(const InstructionSequence& seq1, const InstructionSequence& seq2)
 {
   const int size1 = seq1.GetSize();
@@ -544,12 +576,116 @@ int Avida::InstructionSequence::FindSlidingDistance(const InstructionSequence& s
 }
 
 
-int Avida::InstructionSequence::FindEditDistance(const InstructionSequence& seq1, const InstructionSequence& seq2)
+// Edit (Levenshtein) distance via the bit-parallel algorithm of Myers (1999), in the global distance formulation given
+// by Hyyrö (2001).  The shorter sequence is used as the pattern and packed into 64-bit blocks, each text instruction
+// then updates one column of the DP matrix per block with a handful of word operations.  Storage for sequences up to
+// EDIT_DIST_STACK_BLOCKS blocks with few distinct instructions is kept on the stack, so the common case allocates
+// nothing.
+
+typedef unsigned long long tEditDistWord;
+
+static const int EDIT_DIST_WORD_BITS = 64;
+static const int EDIT_DIST_STACK_BLOCKS = 8;
+static const int EDIT_DIST_STACK_SYMBOLS = 64;
+
+static inline int editDistAdvanceBlock(tEditDistWord& Pv, tEditDistWord& Mv, tEditDistWord Eq, tEditDistWord high, int hin)
+{
+  const tEditDistWord Xv = Eq | Mv;
+  if (hin < 0) Eq |= 1ULL;
+  const tEditDistWord Xh = (((Eq & Pv) + Pv) ^ Pv) | Eq;
+  
+  tEditDistWord Ph = Mv | ~(Xh | Pv);
+  tEditDistWord Mh = Pv & Xh;
+  
+  int hout = 0;
+  if (Ph & high) hout = 1;
+  else if (Mh & high) hout = -1;
+  
+  Ph <<= 1;
+  Mh <<= 1;
+  if (hin < 0) Mh |= 1ULL;
+  else if (hin > 0) Ph |= 1ULL;
+  
+  Pv = Mh | ~(Xv | Ph);
+  Mv = Ph & Xv;
+  
+  return hout;
+}
+
+
+static int editDistBitParallel(const Avida::Instruction* pattern, int p_size, const Avida::Instruction* text, int t_size,
+                               int max_dist)
+{
+  const int num_blocks = (p_size + EDIT_DIST_WORD_BITS - 1) / EDIT_DIST_WORD_BITS;
+  const tEditDistWord last_high = 1ULL << ((p_size - 1) % EDIT_DIST_WORD_BITS);
+  const tEditDistWord full_high = 1ULL << (EDIT_DIST_WORD_BITS - 1);
+  
+  // Compact the pattern alphabet, row 0 of the match table is reserved for instructions not present in the pattern
+  unsigned short symbol_row[256];
+  memset(symbol_row, 0, sizeof(symbol_row));
+  int num_rows = 1;
+  for (int i = 0; i < p_size; i++) {
+    const int op = pattern[i].GetOp();
+    if (symbol_row[op] == 0) symbol_row[op] = static_cast<unsigned short>(num_rows++);
+  }
+  
+  tEditDistWord stack_peq[EDIT_DIST_STACK_SYMBOLS * EDIT_DIST_STACK_BLOCKS];
+  tEditDistWord stack_pv[EDIT_DIST_STACK_BLOCKS];
+  tEditDistWord stack_mv[EDIT_DIST_STACK_BLOCKS];
+  Apto::Array<tEditDistWord> heap_peq;
+  Apto::Array<tEditDistWord> heap_pv;
+  Apto::Array<tEditDistWord> heap_mv;
+  
+  tEditDistWord* peq = stack_peq;
+  tEditDistWord* pv = stack_pv;
+  tEditDistWord* mv = stack_mv;
+  if (num_rows > EDIT_DIST_STACK_SYMBOLS || num_blocks > EDIT_DIST_STACK_BLOCKS) {
+    heap_peq.Resize(num_rows * num_blocks);
+    heap_pv.Resize(num_blocks);
+    heap_mv.Resize(num_blocks);
+    peq = &heap_peq[0];
+    pv = &heap_pv[0];
+    mv = &heap_mv[0];
+  }
+  
+  // Build the match vectors; bit i of row r in block b is set if pattern site (b * 64 + i) is the instruction of row r
+  memset(peq, 0, sizeof(tEditDistWord) * num_rows * num_blocks);
+  for (int i = 0; i < p_size; i++) {
+    const int row = symbol_row[pattern[i].GetOp()];
+    peq[row * num_blocks + i / EDIT_DIST_WORD_BITS] |= 1ULL << (i % EDIT_DIST_WORD_BITS);
+  }
+  
+  // Initial column is 0..p_size, i.e. all vertical deltas are +1
+  for (int b = 0; b < num_blocks; b++) {
+    pv[b] = ~0ULL;
+    mv[b] = 0;
+  }
+  
+  int score = p_size;
+  for (int j = 0; j < t_size; j++) {
+    const tEditDistWord* eq = peq + symbol_row[text[j].GetOp()] * num_blocks;
+    
+    // The top row of the matrix grows by one per column, so a +1 horizontal delta enters the first block
+    int carry = 1;
+    for (int b = 0; b < num_blocks - 1; b++) carry = editDistAdvanceBlock(pv[b], mv[b], eq[b], full_high, carry);
+    score += editDistAdvanceBlock(pv[num_blocks - 1], mv[num_blocks - 1], eq[num_blocks - 1], last_high, carry);
+    
+    // The bottom row can decrease by at most one per remaining column; stop once the threshold is unreachable
+    if (max_dist >= 0 && score - (t_size - j - 1) > max_dist) return max_dist + 1;
+  }
+  
+  return score;
+}
+
+
+int Avida::InstructionSequence::FindEditDistance(const Instruction* seq1, int size1, const Instruction* seq2, int size2,
+                                                 int max_dist)
 {
-  const int size1 = seq1.GetSize();
-  const int size2 = seq2.GetSize();
   const int min_size = (size1 < size2) ? size1 : size2;
   
+  // The distance is at least the difference in length
+  if (max_dist >= 0 && abs(size1 - size2) > max_dist) return max_dist + 1;
+  
   // If either size is zero, return the other one!
   if (!min_size) return (size1 > size2) ? size1 : size2;
   
@@ -564,50 +700,21 @@ int Avida::InstructionSequence::FindEditDistance(const InstructionSequence& seq1
   
   if (test_size1 <= 0 || test_size2 <=0) return abs(test_size1 - test_size2);
   
-  // Now match everything else...
-  int* cur_row  = new int[test_size1];  // The row we are calculating
-  int* prev_row = new int[test_size1];  // The last row we calculated
-  
-  // Initialize the previous row to record the differece from nothing.
-  for (int i = 0; i < test_size1; i++)  prev_row[i] = i + 1;
-  
-  // Loop through each subsequent character in the test code
-  for (int i = 0; i < test_size2; i++) {
-    // Initialize the first entry in cur_row.
-    if (seq1[match_front] == seq2[match_front + i]) cur_row[0] = i;
-    else cur_row[0] = (i < prev_row[0]) ? (i+1) : (prev_row[0] + 1);
-    
-    // Move down the cur_row and fill it out.
-    for (int j = 1; j < test_size1; j++) {
-      // If the values are equal, keep the value in the upper left.
-      if (seq1[match_front + j] == seq2[match_front + i]) {
-        cur_row[j] = prev_row[j-1];
-      }
-      
-      // Otherwise, set the current position the the minimal of the three
-      // numbers above (insertion), to the left (deletion), or upper left
-      // (mutation) in the chart, plus one.
-      else {
-        cur_row[j] = (prev_row[j] < prev_row[j-1]) ? prev_row[j] : prev_row[j-1];
-        if (cur_row[j-1] < cur_row[j]) cur_row[j] = cur_row[j-1];
-        cur_row[j]++;
-      }
-    }
-    
-    // Swap cur_row and prev_row. (we only really need to move the cur row
-    // over to prev, but this saves us from having to keep re-allocating
-    // new rows.  We recycle!
-    int* temp_row = cur_row;
-    cur_row = prev_row;
-    prev_row = temp_row;
-  }
-  
-  // Now that we are done, return the bottom-right corner of the chart.
-  
-  const int value = prev_row[test_size1 - 1];
-  
-  delete [] cur_row;
-  delete [] prev_row;
-  
-  return value;
+  // Now match everything else, using the shorter remainder as the pattern to minimize the number of blocks
+  const Instruction* test_seq1 = seq1 + match_front;
+  const Instruction* test_seq2 = seq2 + match_front;
+  if (test_size1 <= test_size2) return editDistBitParallel(test_seq1, test_size1, test_seq2, test_size2, max_dist);
+  return editDistBitParallel(test_seq2, test_size2, test_seq1, test_size1, max_dist);
+}
+
+
+int Avida::InstructionSequence::FindEditDistance(const InstructionSequence& seq1, const InstructionSequence& seq2)
+{
+  return FindEditDistance(seq1.rawSequence(), seq1.GetSize(), seq2.rawSequence(), seq2.GetSize(), -1);
+}
+
+
+int Avida::InstructionSequence::FindEditDistance(const InstructionSequence& seq1, const InstructionSequence& seq2, int max_dist)
+{
+  return FindEditDistance(seq1.rawSequence(), seq1.GetSize(), seq2.rawSequence(), seq2.GetSize(), max_dist);
 }
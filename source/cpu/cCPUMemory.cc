@@ -25,16 +25,139 @@
 using namespace std;
 using namespace Avida;
 
-cCPUMemory::cCPUMemory(const cCPUMemory& in_memory) : InstructionSequence(in_memory), m_flag_array(in_memory.GetSize())
+// Number of flag words needed to cover num_sites sites
+static inline int flagWords(int num_sites) { return (num_sites + 31) >> 5; }
+
+static inline int popCount(unsigned int v)
+{
+  v = v - ((v >> 1) & 0x55555555);
+  v = (v & 0x33333333) + ((v >> 2) & 0x33333333);
+  return (((v + (v >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24;
+}
+
+// Reads num_bits (1 to 32) bits starting at bit, low bit first
+static inline unsigned int readBits(const unsigned int* words, int bit, int num_bits)
+{
+  const int word = bit >> 5;
+  const int offset = bit & 31;
+  unsigned int value = words[word] >> offset;
+  if (offset + num_bits > 32) value |= words[word + 1] << (32 - offset);
+  return (num_bits < 32) ? (value & ((1u << num_bits) - 1)) : value;
+}
+
+// Writes the low num_bits (1 to 32) bits of value starting at bit
+static inline void writeBits(unsigned int* words, int bit, int num_bits, unsigned int value)
 {
-  for (int i = 0; i < m_flag_array.GetSize(); i++) m_flag_array[i] = in_memory.m_flag_array[i];
+  const int word = bit >> 5;
+  const int offset = bit & 31;
+  const unsigned int mask = (num_bits < 32) ? ((1u << num_bits) - 1) : ~0u;
+  value &= mask;
+  words[word] = (words[word] & ~(mask << offset)) | (value << offset);
+  if (offset + num_bits > 32) {
+    const unsigned int spill_mask = (1u << (offset + num_bits - 32)) - 1;
+    words[word + 1] = (words[word + 1] & ~spill_mask) | (value >> (32 - offset));
+  }
+}
+
+
+cCPUMemory::cCPUMemory(const cCPUMemory& in_memory)
+  : InstructionSequence(in_memory), m_revision(0), m_reserved(0)
+{
+  setupFlags();
+  const int num_words = flagWords(m_active_size);
+  for (int f = 0; f < NUM_FLAGS; f++) {
+    for (int i = 0; i < num_words; i++) m_flags[f][i] = in_memory.m_flags[f][i];
+  }
+}
+
+
+void cCPUMemory::setupFlags()
+{
+  const int num_words = flagWords(m_seq.GetSize());
+  for (int f = 0; f < NUM_FLAGS; f++) {
+    m_flags[f].ResizeClear(num_words);
+    m_flags[f].SetAll(0);
+  }
+}
+
+
+// Sizes the flag planes to cover the capacity of m_seq, clearing any new words
+void cCPUMemory::resizeFlags()
+{
+  const int num_words = flagWords(m_seq.GetSize());
+  for (int f = 0; f < NUM_FLAGS; f++) {
+    const int old_words = m_flags[f].GetSize();
+    if (old_words == num_words) continue;
+    m_flags[f].Resize(num_words);
+    for (int i = old_words; i < num_words; i++) m_flags[f][i] = 0;
+  }
+}
+
+
+void cCPUMemory::clearFlags(int begin, int end)
+{
+  if (begin >= end) return;
+  for (int f = 0; f < NUM_FLAGS; f++) {
+    unsigned int* words = &m_flags[f][0];
+    for (int i = begin; i < end; i += 32) writeBits(words, i, (end - i < 32) ? end - i : 32, 0);
+  }
+}
+
+
+// Moves the flags of num_sites sites from from to to; the ranges may overlap
+void cCPUMemory::moveFlags(int to, int from, int num_sites)
+{
+  if (to == from || num_sites <= 0) return;
+  for (int f = 0; f < NUM_FLAGS; f++) {
+    unsigned int* words = &m_flags[f][0];
+    if (to < from) {
+      for (int i = 0; i < num_sites; i += 32) {
+        const int num_bits = (num_sites - i < 32) ? num_sites - i : 32;
+        writeBits(words, to + i, num_bits, readBits(words, from + i, num_bits));
+      }
+    } else {
+      for (int i = num_sites; i > 0; i -= 32) {
+        const int num_bits = (i < 32) ? i : 32;
+        writeBits(words, to + i - num_bits, num_bits, readBits(words, from + i - num_bits, num_bits));
+      }
+    }
+  }
+}
+
+
+int cCPUMemory::countFlag(eFlag flag, int begin, int end) const
+{
+  assert(begin >= 0 && end <= m_active_size);
+  if (begin >= end) return 0;
+  const unsigned int* words = &m_flags[flag][0];
+  int count = 0;
+  for (int i = begin; i < end; i += 32) count += popCount(readBits(words, i, (end - i < 32) ? end - i : 32));
+  return count;
+}
+
+
+void cCPUMemory::Reserve(int capacity)
+{
+  if (capacity <= m_reserved) return;
+  m_reserved = capacity;
+  if (m_seq.GetSize() < capacity) {
+    m_seq.Resize(capacity);
+    resizeFlags();
+  }
 }
 
 
 void cCPUMemory::adjustCapacity(int new_size)
 {
-  InstructionSequence::adjustCapacity(new_size);
-  if (m_seq.GetSize() != m_flag_array.GetSize()) m_flag_array.Resize(m_seq.GetSize()); 
+  if (new_size <= m_reserved) {
+    // Within the reservation the size changes in place, the base class would otherwise release storage on shrinking
+    assert(new_size > 0);
+    if (m_seq.GetSize() < m_reserved) m_seq.Resize(m_reserved);
+    m_active_size = new_size;
+  } else {
+    InstructionSequence::adjustCapacity(new_size);
+  }
+  resizeFlags();
 }
 
 
@@ -49,14 +172,16 @@ void cCPUMemory::prepareInsert(int pos, int num_sites)
   adjustCapacity(new_size);
   
   // Shift any sites needed...
-  for (int i = old_size - 1; i >= pos; i--) m_seq[i + num_sites] = m_seq[i];
-  for (int i = old_size - 1; i >= pos; i--) m_flag_array[i + num_sites] = m_flag_array[i];
+  Instruction* seq = m_seq.GetWritable();
+  for (int i = old_size - 1; i >= pos; i--) seq[i + num_sites] = seq[i];
+  moveFlags(pos + num_sites, pos, old_size - pos);
 }
 
 
 void cCPUMemory::Reset(int new_size)
 {
   assert(new_size >= 0);
+  m_revision++;
 
   adjustCapacity(new_size);
   Clear();
@@ -66,25 +191,25 @@ void cCPUMemory::Reset(int new_size)
 void cCPUMemory::Resize(int new_size)
 {
   assert(new_size >= 0);
+  m_revision++;
 
   const int old_size = m_active_size;
   adjustCapacity(new_size);
   
-  for (int i = old_size; i < new_size; i++) {
-    m_seq[i].SetOp(0);
-    m_flag_array[i] = 0;
-  }
+  for (int i = old_size; i < new_size; i++) m_seq[i].SetOp(0);
+  clearFlags(old_size, new_size);
 }
 
 
 void cCPUMemory::ResizeOld(int new_size)
 {
   assert(new_size >= 0);
+  m_revision++;
 
   const int old_size = m_active_size;
   adjustCapacity(new_size);
 
-  for (int i = old_size; i < new_size; i++) m_flag_array[i] = 0;
+  clearFlags(old_size, new_size);
 }
 
 
@@ -94,9 +219,13 @@ void cCPUMemory::Copy(int to, int from)
   assert(to < m_seq.GetSize());
   assert(from >= 0);
   assert(from < m_seq.GetSize());
+  m_revision++;
   
   m_seq[to] = m_seq[from];
-  m_flag_array[to] = m_flag_array[from];
+  for (int f = 0; f < NUM_FLAGS; f++) {
+    if (getFlag(eFlag(f), from)) setFlag(eFlag(f), to);
+    else clearFlag(eFlag(f), to);
+  }
 }
 
 
@@ -104,22 +233,23 @@ void cCPUMemory::Insert(int pos, const Instruction& inst)
 {
   assert(pos >= 0);
   assert(pos <= m_seq.GetSize());
+  m_revision++;
 
   prepareInsert(pos, 1);
   m_seq[pos] = inst;
-  m_flag_array[pos] = 0;
+  clearFlags(pos, pos + 1);
 }
 
 void cCPUMemory::Insert(int pos, const InstructionSequence& genome)
 {
   assert(pos >= 0);
   assert(pos <= m_seq.GetSize());
+  m_revision++;
 
   prepareInsert(pos, genome.GetSize());
-  for (int i = 0; i < genome.GetSize(); i++) {
-    m_seq[i + pos] = genome[i];
-    m_flag_array[i + pos] = 0;
-  }
+  Instruction* seq = m_seq.GetWritable();
+  for (int i = 0; i < genome.GetSize(); i++) seq[i + pos] = genome[i];
+  clearFlags(pos, pos + genome.GetSize());
 }
 
 void cCPUMemory::Remove(int pos, int num_sites)
@@ -127,12 +257,12 @@ void cCPUMemory::Remove(int pos, int num_sites)
   assert(num_sites > 0);                    // Must remove something...
   assert(pos >= 0);                         // Removal must be in genome.
   assert(pos + num_sites <= m_active_size); // Cannot extend past end of genome.
+  m_revision++;
 
   const int new_size = m_active_size - num_sites;
-  for (int i = pos; i < new_size; i++) {
-    m_seq[i] = m_seq[i + num_sites];
-    m_flag_array[i] = m_flag_array[i + num_sites];
-  }
+  Instruction* seq = m_seq.GetWritable();
+  for (int i = pos; i < new_size; i++) seq[i] = seq[i + num_sites];
+  moveFlags(pos, pos + num_sites, new_size - pos);
   adjustCapacity(new_size);
 }
 
@@ -141,6 +271,7 @@ void cCPUMemory::Replace(int pos, int num_sites, const InstructionSequence& geno
   assert(pos >= 0);                         // Replace must be in genome
   assert(num_sites >= 0);                   // Cannot replace negative
   assert(pos + num_sites <= m_active_size); // Cannot extend past end!
+  m_revision++;
   
   const int size_change = genome.GetSize() - num_sites;
   
@@ -149,33 +280,25 @@ void cCPUMemory::Replace(int pos, int num_sites, const InstructionSequence& geno
   else if (size_change < 0) Remove(pos, -size_change);
   
   // Now just copy everything over!
-  for (int i = 0; i < genome.GetSize(); i++) {
-    m_seq[i + pos] = genome[i];
-    m_flag_array[i + pos] = 0;
-  }
+  Instruction* seq = m_seq.GetWritable();
+  for (int i = 0; i < genome.GetSize(); i++) seq[i + pos] = genome[i];
+  clearFlags(pos, pos + genome.GetSize());
 }
 
 
 void cCPUMemory::operator=(const cCPUMemory& other_memory)
 {
-  adjustCapacity(other_memory.m_active_size);
-  
-  // Fill in the new information...
-  for (int i = 0; i < m_active_size; i++) {
-    m_seq[i] = other_memory.m_seq[i];
-    m_flag_array[i] = other_memory.m_flag_array[i];
-  }
+  m_revision++;
+  // The instructions are shared until either memory is modified
+  InstructionSequence::operator=(other_memory);
+  for (int f = 0; f < NUM_FLAGS; f++) m_flags[f] = other_memory.m_flags[f];
 }
 
 
 void cCPUMemory::operator=(const InstructionSequence& other_genome)
 {
-  adjustCapacity(other_genome.GetSize());
-  
-  // Fill in the new information...
-  for (int i = 0; i < m_active_size; i++) {
-    m_seq[i] = other_genome[i];
-    m_flag_array[i] = 0;
-  }
+  m_revision++;
+  // The instructions are shared until either side is modified
+  InstructionSequence::operator=(other_genome);
+  setupFlags();
 }
-
@@ -29,57 +29,86 @@
 class cCPUMemory : public Avida::InstructionSequence
 {
 private:
-	static const unsigned char MASK_COPIED   = 0x01;
-	static const unsigned char MASK_MUTATED  = 0x02;
-	static const unsigned char MASK_EXECUTED = 0x04;
-	static const unsigned char MASK_POINTMUT = 0x08;
-	static const unsigned char MASK_COPYMUT  = 0x10;
-	static const unsigned char MASK_INJECTED = 0x20;
-	static const unsigned char MASK_UNUSED1  = 0x40; // unused bit
-	static const unsigned char MASK_UNUSED2  = 0x80; // unused bit
+  // Per-site flags are stored as one bit-plane per flag, 32 sites to a word, so that whole ranges of sites can be
+  // cleared, shifted and counted a word at a time.
+  enum eFlag {
+    FLAG_COPIED = 0,
+    FLAG_MUTATED,
+    FLAG_EXECUTED,
+    FLAG_POINTMUT,
+    FLAG_COPYMUT,
+    FLAG_INJECTED,
+    NUM_FLAGS
+  };
   
-  Apto::Array<unsigned char> m_flag_array;
+  Apto::Array<unsigned int> m_flags[NUM_FLAGS];  // each sized to cover the capacity of m_seq
+  unsigned int m_revision;
+  int m_reserved;  // capacity kept regardless of size, see Reserve
 
   void adjustCapacity(int new_size);
   void prepareInsert(int pos, int num_sites);
 
+  void setupFlags();
+  void resizeFlags();
+  void clearFlags(int begin, int end);
+  void moveFlags(int to, int from, int num_sites);
+  int countFlag(eFlag flag, int begin, int end) const;
+
+  inline bool getFlag(eFlag flag, int pos) const { return (m_flags[flag][pos >> 5] & (1u << (pos & 31))) != 0; }
+  inline void setFlag(eFlag flag, int pos) { m_flags[flag][pos >> 5] |= (1u << (pos & 31)); }
+  inline void clearFlag(eFlag flag, int pos) { m_flags[flag][pos >> 5] &= ~(1u << (pos & 31)); }
+
 public:
   cCPUMemory(const cCPUMemory& in_memory);
-  cCPUMemory(const InstructionSequence& in_genome) : InstructionSequence(in_genome), m_flag_array(in_genome.GetSize()) { ; }
-  explicit cCPUMemory(int size = 1)  : InstructionSequence(size), m_flag_array(size) { ClearFlags(); }
-  cCPUMemory(const Apto::String& in_string) : InstructionSequence(in_string), m_flag_array(in_string.GetSize()) { ; }
+  cCPUMemory(const InstructionSequence& in_genome) : InstructionSequence(in_genome), m_revision(0), m_reserved(0) { setupFlags(); }
+  explicit cCPUMemory(int size = 1) : InstructionSequence(size), m_revision(0), m_reserved(0) { setupFlags(); }
+  cCPUMemory(const Apto::String& in_string) : InstructionSequence(in_string), m_revision(0), m_reserved(0) { setupFlags(); }
   ~cCPUMemory() { ; }
 
-  inline bool FlagCopied(int pos) const     { return (MASK_COPIED   & m_flag_array[pos]) != 0; }
-  inline bool FlagMutated(int pos) const    { return (MASK_MUTATED  & m_flag_array[pos]) != 0; }
-  inline bool FlagExecuted(int pos) const   { return (MASK_EXECUTED & m_flag_array[pos]) != 0; }
-  inline bool FlagPointMut(int pos) const   { return (MASK_POINTMUT & m_flag_array[pos]) != 0; }
-  inline bool FlagCopyMut(int pos) const    { return (MASK_COPYMUT  & m_flag_array[pos]) != 0; }
-  inline bool FlagInjected(int pos) const   { return (MASK_INJECTED & m_flag_array[pos]) != 0; }
+  // The revision changes whenever the instructions may have changed through this memory's interface, including any
+  // non-const element access, so that derived data (e.g. cLabelIndex) can tell when it is stale.
+  inline unsigned int GetRevision() const { return m_revision; }
+
+  // Keeps storage for at least capacity sites from now on, so the memory can grow to that size and shrink back (e.g.
+  // while offspring are allocated, copied and divided off) without reallocating.
+  void Reserve(int capacity);
+
+  inline Avida::Instruction& operator[](int idx) { m_revision++; return InstructionSequence::operator[](idx); }
+  inline const Avida::Instruction& operator[](int idx) const { return InstructionSequence::operator[](idx); }
+
+  inline bool FlagCopied(int pos) const     { return getFlag(FLAG_COPIED, pos);   }
+  inline bool FlagMutated(int pos) const    { return getFlag(FLAG_MUTATED, pos);  }
+  inline bool FlagExecuted(int pos) const   { return getFlag(FLAG_EXECUTED, pos); }
+  inline bool FlagPointMut(int pos) const   { return getFlag(FLAG_POINTMUT, pos); }
+  inline bool FlagCopyMut(int pos) const    { return getFlag(FLAG_COPYMUT, pos);  }
+  inline bool FlagInjected(int pos) const   { return getFlag(FLAG_INJECTED, pos); }
+  
+  inline void SetFlagCopied(int pos)     { setFlag(FLAG_COPIED, pos);   }
+  inline void SetFlagMutated(int pos)    { setFlag(FLAG_MUTATED, pos);  }
+  inline void SetFlagExecuted(int pos)   { setFlag(FLAG_EXECUTED, pos); }
+  inline void SetFlagPointMut(int pos)   { setFlag(FLAG_POINTMUT, pos); }
+  inline void SetFlagCopyMut(int pos)    { setFlag(FLAG_COPYMUT, pos);  }
+  inline void SetFlagInjected(int pos)   { setFlag(FLAG_INJECTED, pos); }
+  
+  inline void ClearFlagCopied(int pos)     { clearFlag(FLAG_COPIED, pos);   }
+  inline void ClearFlagMutated(int pos)    { clearFlag(FLAG_MUTATED, pos);  }
+  inline void ClearFlagExecuted(int pos)   { clearFlag(FLAG_EXECUTED, pos); }
+  inline void ClearFlagPointMut(int pos)   { clearFlag(FLAG_POINTMUT, pos); }
+  inline void ClearFlagCopyMut(int pos)    { clearFlag(FLAG_COPYMUT, pos);  }
+  inline void ClearFlagInjected(int pos)   { clearFlag(FLAG_INJECTED, pos); }
   
-  inline void SetFlagCopied(int pos)     { m_flag_array[pos] |= MASK_COPIED;   }
-  inline void SetFlagMutated(int pos)    { m_flag_array[pos] |= MASK_MUTATED;  }
-  inline void SetFlagExecuted(int pos)   { m_flag_array[pos] |= MASK_EXECUTED; }
-  inline void SetFlagPointMut(int pos)   { m_flag_array[pos] |= MASK_POINTMUT; }
-  inline void SetFlagCopyMut(int pos)    { m_flag_array[pos] |= MASK_COPYMUT;  }
-  inline void SetFlagInjected(int pos)   { m_flag_array[pos] |= MASK_INJECTED; }
-	
-	inline void ClearFlagCopied(int pos)     { m_flag_array[pos] &= ~MASK_COPIED;   }
-	inline void ClearFlagMutated(int pos)    { m_flag_array[pos] &= ~MASK_MUTATED;  }
-	inline void ClearFlagExecuted(int pos)   { m_flag_array[pos] &= ~MASK_EXECUTED; }
-	inline void ClearFlagPointMut(int pos)   { m_flag_array[pos] &= ~MASK_POINTMUT; }
-	inline void ClearFlagCopyMut(int pos)    { m_flag_array[pos] &= ~MASK_COPYMUT;  }
-  inline void ClearFlagInjected(int pos)   { m_flag_array[pos] &= ~MASK_INJECTED; }
+  // Number of sites in [begin, end) with the flag set
+  inline int CountFlagCopied(int begin, int end) const   { return countFlag(FLAG_COPIED, begin, end);   }
+  inline int CountFlagExecuted(int begin, int end) const { return countFlag(FLAG_EXECUTED, begin, end); }
   
   
   void Clear()
-	{
-		for (int i = 0; i < m_active_size; i++) {
-			m_seq[i].SetOp(0);
-			m_flag_array[i] = 0;
-		}
-	}
-  inline void ClearFlags() { m_flag_array.SetAll(0); }
+  {
+    m_revision++;
+    for (int i = 0; i < m_active_size; i++) m_seq[i].SetOp(0);
+    ClearFlags();
+  }
+  inline void ClearFlags() { for (int f = 0; f < NUM_FLAGS; f++) m_flags[f].SetAll(0); }
   void Reset(int new_size);     // Reset size, clearing contents...
   void ResizeOld(int new_size); // Reset size, save contents, init to previous
     
@@ -90,6 +119,8 @@ public:
   void Insert(int pos, const InstructionSequence& genome);
   void Remove(int pos, int num_sites = 1);
   void Replace(int pos, int num_sites, const InstructionSequence& genome);
+  void Replace(const InstructionSequence& g, int begin, int end) { m_revision++; InstructionSequence::Replace(g, begin, end); }
+  void Rotate(int n) { m_revision++; InstructionSequence::Rotate(n); }
 
   void operator=(const cCPUMemory& other_memory);
   void operator=(const InstructionSequence& other_genome);
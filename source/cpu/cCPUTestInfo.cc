@@ -70,6 +70,7 @@ cCPUTestInfo& cCPUTestInfo::operator=(const cCPUTestInfo& test_info)
   depth_found = test_info.depth_found;
   max_cycle = test_info.max_cycle;
   cycle_to = test_info.cycle_to;
+  cycles_saved = test_info.cycles_saved;
   used_inputs = test_info.used_inputs; 
   org_array = test_info.org_array;
   m_res_method = test_info.m_res_method;
@@ -95,6 +96,7 @@ void cCPUTestInfo::Clear()
   depth_found = -1;
   max_cycle = 0;
   cycle_to = -1;
+  cycles_saved = 0;
 
   for (int i = 0; i < generation_tests; i++) {
     if (org_array[i] == NULL) break;
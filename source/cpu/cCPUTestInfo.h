@@ -64,6 +64,7 @@ private:
   int depth_found;        // Depth actually found (often same as max_depth)
   int max_cycle;          // Longest cycle found.
   int cycle_to;           // Cycle path of the last genotype.
+  int cycles_saved;       // Cycles skipped by stopping runs early (see TEST_CPU_EARLY_STOP)
 	Apto::Array<int> used_inputs; //Depth 0 inputs
 
   Apto::Array<cOrganism*> org_array;
@@ -110,6 +111,7 @@ public:
   int GetDepthFound() const { return depth_found; }
   int GetMaxCycle() const { return max_cycle; }
   int GetCycleTo() const { return cycle_to; }
+  int GetCyclesSaved() const { return cycles_saved; }
 
   // Genotype Stats...
   inline cOrganism* GetTestOrganism(int level = 0);
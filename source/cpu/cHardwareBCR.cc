@@ -50,6 +50,7 @@ using namespace AvidaTools;
 
 
 tInstLib<cHardwareBCR::tMethod>* cHardwareBCR::s_inst_slib = cHardwareBCR::initInstLib();
+cFreeListPool* const cHardwareBCR::s_pool = new cFreeListPool("cHardwareBCR", sizeof(cHardwareBCR));
 
 tInstLib<cHardwareBCR::tMethod>* cHardwareBCR::initInstLib(void)
 {
@@ -334,6 +335,7 @@ void cHardwareBCR::internalReset()
 
   // Genes
   m_genes.Resize(0);
+  m_nop_search.Clear();
   setupGenes();
 }
 
@@ -829,42 +831,22 @@ void cHardwareBCR::FindLabelStart(Head& head, Head& default_pos, bool mark_execu
   }
   
   cCPUMemory& memory = head.GetMemory();
-  int pos = 0;
+  const cNopSearchCache::sResult& result =
+    m_nop_search.Find(*m_inst_set, memory, cNopSearchCache::LABEL_START, search_label, 0);
   
-  while (pos < memory.GetSize()) {
-    if (m_inst_set->IsLabel(memory[pos])) { // starting label found
-      pos++;
-      
-      // Check for direct matched label pattern, can be substring of 'label'ed target
-      // - must match all NOPs in search_label
-      // - extra NOPs in 'label'ed target are ignored
-      int size_matched = 0;
-      while (size_matched < search_label.GetSize() && pos < memory.GetSize()) {
-        if (!m_inst_set->IsNop(memory[pos]) || search_label[size_matched] != m_inst_set->GetNopMod(memory[pos])) break;
-        size_matched++;
-        pos++;
-      }
-      
-      // Check that the label matches and has examined the full sequence of nops following the 'label' instruction
-      if (size_matched == search_label.GetSize()) {
-        // Return Head pointed at last NOP of label sequence
-        if (mark_executed) {
-          size_matched++; // Increment size matched so that it includes the label instruction
-          const int start = pos - size_matched;
-          const int max = m_world->GetConfig().MAX_LABEL_EXE_SIZE.Get() + 1; // Max label + 1 for the label instruction itself
-          for (int i = 0; i < size_matched && i < max; i++) memory.SetFlagExecuted(start + i);
-        }
-        head.SetPosition(pos - 1);
-        return;
-      }
-      
-      continue; 
-    }
-    pos++;
+  // Return start point if not found
+  if (result.found_pos < 0) {
+    head.Set(default_pos);
+    return;
   }
   
-  // Return start point if not found
-  head.Set(default_pos);
+  if (mark_executed) {
+    const int max = m_world->GetConfig().MAX_LABEL_EXE_SIZE.Get() + 1; // Max label + 1 for the label instruction itself
+    cNopSearchCache::MarkExecuted(memory, result, max);
+  }
+  
+  // Return Head pointed at last NOP of label sequence
+  head.SetPosition(result.found_pos);
 }
 
 void cHardwareBCR::FindNopSequenceStart(Head& head, Head& default_pos, bool mark_executed)
@@ -878,38 +860,22 @@ void cHardwareBCR::FindNopSequenceStart(Head& head, Head& default_pos, bool mark
   }
   
   cCPUMemory& memory = head.GetMemory();
-  int pos = 0;
+  const cNopSearchCache::sResult& result =
+    m_nop_search.Find(*m_inst_set, memory, cNopSearchCache::NOP_SEQUENCE_START, search_label, 0);
   
-  while (pos < memory.GetSize()) {
-    if (m_inst_set->IsNop(memory[pos])) { // start of sequence found
-      
-      // Check for direct matched label pattern, can be substring of 'label'ed target
-      // - must match all NOPs in search_label
-      // - extra NOPs in 'label'ed target are ignored
-      int size_matched = 0;
-      while (size_matched < search_label.GetSize() && pos < memory.GetSize()) {
-        if (!m_inst_set->IsNop(memory[pos]) || search_label[size_matched] != m_inst_set->GetNopMod(memory[pos])) break;
-        size_matched++;
-        pos++;
-      }
-      
-      // Check that the label matches and has examined the full sequence of nops following the 'label' instruction
-      if (size_matched == search_label.GetSize()) {
-        // Return Head pointed at last NOP of label sequence
-        if (mark_executed) {
-          const int start = pos - size_matched;
-          const int max = m_world->GetConfig().MAX_LABEL_EXE_SIZE.Get();
-          for (int i = 0; i < size_matched && i < max; i++) memory.SetFlagExecuted(start + i);
-        }
-        head.SetPosition(pos - 1);
-        return;
-      }
-    }
-    pos++;
+  // Return start point if not found
+  if (result.found_pos < 0) {
+    head.Set(default_pos);
+    return;
   }
   
-  // Return start point if not found
-  head.Set(default_pos);
+  if (mark_executed) {
+    const int max = m_world->GetConfig().MAX_LABEL_EXE_SIZE.Get();
+    cNopSearchCache::MarkExecuted(memory, result, max);
+  }
+  
+  // Return Head pointed at last NOP of label sequence
+  head.SetPosition(result.found_pos);
 }
 
 
@@ -925,47 +891,23 @@ void cHardwareBCR::FindLabelForward(Head& head, Head& default_pos, bool mark_exe
   
   head.Adjust();
   
-  Head pos(head);
-  pos++;
+  cCPUMemory& memory = head.GetMemory();
+  const cNopSearchCache::sResult& result =
+    m_nop_search.Find(*m_inst_set, memory, cNopSearchCache::LABEL_FORWARD, search_label, head.Position());
   
-  while (pos.Position() != head.Position()) {
-    if (m_inst_set->IsLabel(pos.GetInst())) { // starting label found
-      const int label_start = pos.Position();
-      pos++;
-      
-      // Check for direct matched label pattern, can be substring of 'label'ed target
-      // - must match all NOPs in search_label
-      // - extra NOPs in 'label'ed target are ignored
-      int size_matched = 0;
-      while (size_matched < search_label.GetSize() && pos.Position() != head.Position()) {
-        if (!m_inst_set->IsNop(pos.GetInst()) || search_label[size_matched] != m_inst_set->GetNopMod(pos.GetInst())) break;
-        size_matched++;
-        pos++;
-      }
-      
-      // Check that the label matches and has examined the full sequence of nops following the 'label' instruction
-      if (size_matched == search_label.GetSize()) {
-        pos--;
-        const int found_pos = pos.Position();
-        
-        if (mark_executed) {
-          pos.SetPosition(label_start);
-          const int max = m_world->GetConfig().MAX_LABEL_EXE_SIZE.Get() + 1; // Max label + 1 for the label instruction itself
-          for (int i = 0; i < size_matched && i < max; i++, pos++) pos.SetFlagExecuted();
-        }
-        
-        // Return Head pointed at last NOP of label sequence
-        head.SetPosition(found_pos);
-        return;
-      }
-      
-      continue; 
-    }
-    pos++;
+  // Return start point if not found
+  if (result.found_pos < 0) {
+    head.Set(default_pos);
+    return;
   }
   
-  // Return start point if not found
-  head.Set(default_pos);
+  if (mark_executed) {
+    const int max = m_world->GetConfig().MAX_LABEL_EXE_SIZE.Get() + 1; // Max label + 1 for the label instruction itself
+    cNopSearchCache::MarkExecuted(memory, result, max);
+  }
+  
+  // Return Head pointed at last NOP of label sequence
+  head.SetPosition(result.found_pos);
 }
 
 void cHardwareBCR::FindLabelBackward(Head& head, Head& default_pos, bool mark_executed)
@@ -1036,46 +978,23 @@ void cHardwareBCR::FindNopSequenceForward(Head& head, Head& default_pos, bool ma
   
   head.Adjust();
   
-  Head pos(head);
-  pos++;
+  cCPUMemory& memory = head.GetMemory();
+  const cNopSearchCache::sResult& result =
+    m_nop_search.Find(*m_inst_set, memory, cNopSearchCache::NOP_SEQUENCE_FORWARD, search_label, head.Position());
   
-  while (pos.Position() != head.Position()) {
-    if (m_inst_set->IsNop(pos.GetInst())) { // starting label found
-      const int label_start = pos.Position();
-      
-      // Check for direct matched nop sequence, can be substring of target
-      // - must match all NOPs in search_label
-      // - extra NOPs in target are ignored
-      int size_matched = 0;
-      while (size_matched < search_label.GetSize() && pos.Position() != head.Position()) {
-        if (!m_inst_set->IsNop(pos.GetInst()) || search_label[size_matched] != m_inst_set->GetNopMod(pos.GetInst())) break;
-        size_matched++;
-        pos++;
-      }
-      
-      // Check that the label matches and has examined the full sequence of nops
-      if (size_matched == search_label.GetSize()) {
-        pos--;
-        const int found_pos = pos.Position();
-        
-        if (mark_executed) {
-          pos.SetPosition(label_start);
-          const int max = m_world->GetConfig().MAX_LABEL_EXE_SIZE.Get();
-          for (int i = 0; i < size_matched && i < max; i++, pos++) pos.SetFlagExecuted();
-        }
-        
-        // Return Head pointed at last NOP of label sequence
-        head.SetPosition(found_pos);
-        return;
-      }
-    }
-    
-    if (pos.Position() == head.Position()) break;
-    pos++;
+  // Return start point if not found
+  if (result.found_pos < 0) {
+    head.Set(default_pos);
+    return;
   }
   
-  // Return start point if not found
-  head.Set(default_pos);
+  if (mark_executed) {
+    const int max = m_world->GetConfig().MAX_LABEL_EXE_SIZE.Get();
+    cNopSearchCache::MarkExecuted(memory, result, max);
+  }
+  
+  // Return Head pointed at last NOP of label sequence
+  head.SetPosition(result.found_pos);
 }
 
 
@@ -1285,12 +1204,8 @@ inline int cHardwareBCR::FindUpstreamModifiedRegister(int offset, int default_re
 
 int cHardwareBCR::calcCopiedSize(const int parent_size, const int child_size)
 {
-  int copied_size = 0;
   const cCPUMemory& memory = m_mem_array[m_cur_offspring];
-  for (int i = 0; i < memory.GetSize(); i++) {
-    if (memory.FlagCopied(i)) copied_size++;
-	}
-  return copied_size;
+  return memory.CountFlagCopied(0, memory.GetSize());
 }
 
 
@@ -2397,9 +2312,7 @@ bool cHardwareBCR::Inst_Repro(cAvidaContext& ctx)
   m_organism->OffspringGenome() = offspring;  
   m_organism->GetPhenotype().SetLinesCopied(memory.GetSize());
   
-  int lines_executed = 0;
-  for (int i = 0; i < memory.GetSize(); i++) if (memory.FlagExecuted(i)) lines_executed++;
-  m_organism->GetPhenotype().SetLinesExecuted(lines_executed);
+  m_organism->GetPhenotype().SetLinesExecuted(memory.CountFlagExecuted(0, memory.GetSize()));
   
   const Genome& org = m_organism->GetGenome();
   ConstInstructionSequencePtr org_seq_p;
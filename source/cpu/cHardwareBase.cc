@@ -129,12 +129,7 @@ void cHardwareBase::ResizeCostArrays(int new_size)
 
 int cHardwareBase::calcExecutedSize(const int parent_size)
 {
-  int executed_size = 0;
-  const cCPUMemory& memory = GetMemory();
-  for (int i = 0; i < parent_size; i++) {
-    if (memory.FlagExecuted(i)) executed_size++;
-  }  
-  return executed_size;
+  return GetMemory().CountFlagExecuted(0, parent_size);
 }
 
 bool cHardwareBase::Divide_CheckViable(cAvidaContext& ctx, const int parent_size, const int child_size, bool using_repro)
@@ -868,6 +863,8 @@ bool cHardwareBase::Divide_TestFitnessMeasures(cAvidaContext& ctx)
 {
   cPhenotype & phenotype = m_organism->GetPhenotype();
   phenotype.CopyTrue() = ( m_organism->OffspringGenome() == m_organism->GetGenome() );
+  // Breed true offspring share the parent's genome storage from here on
+  if (phenotype.CopyTrue()) m_organism->OffspringGenome() = m_organism->GetGenome();
   phenotype.ChildFertile() = true;
 	
   // Only continue if we're supposed to do a fitness test on divide...
@@ -980,6 +977,8 @@ bool cHardwareBase::Divide_TestFitnessMeasures1(cAvidaContext& ctx)
 {
   cPhenotype & phenotype = m_organism->GetPhenotype();
   phenotype.CopyTrue() = (m_organism->OffspringGenome() == m_organism->GetGenome());
+  // Breed true offspring share the parent's genome storage from here on
+  if (phenotype.CopyTrue()) m_organism->OffspringGenome() = m_organism->GetGenome();
   phenotype.ChildFertile() = true;
 	
   // Only continue if we're supposed to do a fitness test on divide...
@@ -1087,9 +1086,6 @@ bool cHardwareBase::Divide_TestFitnessMeasures1(cAvidaContext& ctx)
 
 int cHardwareBase::PointMutate(cAvidaContext& ctx, double override_mut_rate)
 {
-  const int max_genome_size = m_world->GetConfig().MAX_GENOME_SIZE.Get();
-  const int min_genome_size = m_world->GetConfig().MIN_GENOME_SIZE.Get();
-  
   cCPUMemory& memory = GetMemory();
   int totalMutations = 0;
   
@@ -1111,13 +1107,28 @@ int cHardwareBase::PointMutate(cAvidaContext& ctx, double override_mut_rate)
     // If we have lines to mutate...
     if (num_mut > 0) {
       for (int i = 0; i < num_mut; i++) {
-        int site = ctx.GetRandom().GetUInt(memory.GetSize());
-        memory[site] = m_inst_set->GetRandomInst(ctx);
+        PointSubstitute(ctx, ctx.GetRandom().GetUInt(memory.GetSize()));
         totalMutations++;
       }
     }
   }
   
+  return totalMutations + PointMutateIndels(ctx);
+}
+
+void cHardwareBase::PointSubstitute(cAvidaContext& ctx, int site)
+{
+  GetMemory()[site] = m_inst_set->GetRandomInst(ctx);
+}
+
+int cHardwareBase::PointMutateIndels(cAvidaContext& ctx)
+{
+  const int max_genome_size = m_world->GetConfig().MAX_GENOME_SIZE.Get();
+  const int min_genome_size = m_world->GetConfig().MIN_GENOME_SIZE.Get();
+  
+  cCPUMemory& memory = GetMemory();
+  int totalMutations = 0;
+  
   // Point Insert Mutations (per site)
   if (m_organism->GetPointInsProb() > 0.0) {
     int num_mut = ctx.GetRandom().GetRandBinomial(memory.GetSize(), m_organism->GetPointInsProb());
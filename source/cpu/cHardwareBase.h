@@ -217,6 +217,8 @@ public:
     
   // --------  Mutation  --------
   virtual int PointMutate(cAvidaContext& ctx, double override_mut_rate = 0.0);
+  void PointSubstitute(cAvidaContext& ctx, int site);  // replace one site with a random instruction
+  int PointMutateIndels(cAvidaContext& ctx);           // just the insertion and deletion stages of PointMutate
 
   
   // --------  Input/Output Buffers  --------
@@ -227,6 +229,11 @@ public:
   // --------  State Transfer  --------
   virtual void InheritState(cHardwareBase&) { ; }
   
+  // Appends everything that decides what this hardware does next, so that the test CPU can tell when an organism has
+  // returned to an earlier state and can only repeat itself.  Hardware that cannot fully capture its state (the
+  // default) returns false, and its organisms are always run to completion.
+  virtual bool CaptureExecutionState(Apto::Array<int>& state) const { (void)state; return false; }
+  
   
   // --------  Alarm  --------
   virtual bool Jump_To_Alarm_Label(int) { return false; }
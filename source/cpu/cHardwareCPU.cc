@@ -61,6 +61,7 @@ using namespace AvidaTools;
 
 
 tInstLib<cHardwareCPU::tMethod>* cHardwareCPU::s_inst_slib = cHardwareCPU::initInstLib();
+cFreeListPool* const cHardwareCPU::s_pool = new cFreeListPool("cHardwareCPU", sizeof(cHardwareCPU));
 
 tInstLib<cHardwareCPU::tMethod>* cHardwareCPU::initInstLib(void)
 {
@@ -768,6 +769,8 @@ cHardwareCPU::cHardwareCPU(cAvidaContext& ctx, cWorld* world, cOrganism* in_orga
   
   m_slip_read_head = !m_world->GetConfig().SLIP_COPY_MODE.Get();
   
+  m_state_capturable = checkStateCapturable();
+  
   // Initialize memory...
   const Genome& in_genome = in_organism->GetGenome();
   ConstInstructionSequencePtr in_seq_p;
@@ -1092,6 +1095,80 @@ void cHardwareCPU::ProcessBonusInst(cAvidaContext& ctx, const Instruction& inst)
 }
 
 
+// Only the default heads instructions are known to act on nothing but the state captured below.  Costs, failure
+// probabilities, promoters, regulation, implicit reproduction and age limits on divide all depend on time or chance.
+bool cHardwareCPU::checkStateCapturable() const
+{
+  if (m_has_any_costs || m_implicit_repro_active || m_promoters_enabled || m_constitutive_regulation) return false;
+  if (m_world->GetConfig().JUV_PERIOD.Get() > 0 || m_world->GetConfig().MIN_CYCLES.Get() > 0) return false;
+  if (m_world->GetConfig().USE_FORM_GROUPS.Get()) return false;
+  
+  const tMethod deterministic_insts[] = {
+    &cHardwareCPU::Inst_Nop, &cHardwareCPU::Inst_IfNEqu, &cHardwareCPU::Inst_IfLess, &cHardwareCPU::Inst_IfLabel,
+    &cHardwareCPU::Inst_MoveHead, &cHardwareCPU::Inst_JumpHead, &cHardwareCPU::Inst_GetHead, &cHardwareCPU::Inst_SetFlow,
+    &cHardwareCPU::Inst_ShiftR, &cHardwareCPU::Inst_ShiftL, &cHardwareCPU::Inst_Inc, &cHardwareCPU::Inst_Dec,
+    &cHardwareCPU::Inst_Push, &cHardwareCPU::Inst_Pop, &cHardwareCPU::Inst_SwitchStack, &cHardwareCPU::Inst_Swap,
+    &cHardwareCPU::Inst_Add, &cHardwareCPU::Inst_Sub, &cHardwareCPU::Inst_Nand, &cHardwareCPU::Inst_HeadCopy,
+    &cHardwareCPU::Inst_MaxAlloc, &cHardwareCPU::Inst_HeadDivide, &cHardwareCPU::Inst_TaskIO,
+    &cHardwareCPU::Inst_HeadSearch
+  };
+  const int num_deterministic = sizeof(deterministic_insts) / sizeof(deterministic_insts[0]);
+  
+  for (int i = 0; i < m_inst_set->GetSize(); i++) {
+    const Instruction inst(i);
+    if (m_inst_set->GetProbFail(inst) > 0.0) return false;
+    
+    const tMethod inst_fun = m_functions[m_inst_set->GetLibFunctionIndex(inst)];
+    int j = 0;
+    while (j < num_deterministic && deterministic_insts[j] != inst_fun) j++;
+    if (j == num_deterministic) return false;
+  }
+  
+  return true;
+}
+
+// Captures the registers, heads, labels and full stacks of every thread, the shared hardware state, the memory's size
+// and revision, its executed and copied flag counts (divide checks them), and the IO totals so that a loop performing
+// IO never looks repeated.  Flags are only ever set between divides, so equal counts mean equal flags.
+bool cHardwareCPU::CaptureExecutionState(Apto::Array<int>& state) const
+{
+  if (!m_state_capturable) return false;
+  
+  for (int t = 0; t < m_threads.GetSize(); t++) {
+    const cLocalThread& thread = m_threads[t];
+    for (int i = 0; i < NUM_REGISTERS; i++) state.Push(thread.reg[i]);
+    for (int i = 0; i < NUM_HEADS; i++) {
+      state.Push(thread.heads[i].GetMemSpace());
+      state.Push(thread.heads[i].GetPosition());
+    }
+    for (int i = 0; i < nHardware::STACK_SIZE; i++) state.Push(thread.stack.Get(i));
+    state.Push(thread.cur_stack);
+    state.Push(thread.cur_head);
+    state.Push(thread.read_label.GetSize());
+    for (int i = 0; i < thread.read_label.GetSize(); i++) state.Push(thread.read_label[i]);
+    state.Push(thread.next_label.GetSize());
+    for (int i = 0; i < thread.next_label.GetSize(); i++) state.Push(thread.next_label[i]);
+  }
+  
+  for (int i = 0; i < nHardware::STACK_SIZE; i++) state.Push(m_global_stack.Get(i));
+  state.Push(m_threads.GetSize());
+  state.Push(m_cur_thread);
+  state.Push(m_mal_active);
+  state.Push(m_executedmatchstrings);
+  state.Push(m_spec_die);
+  
+  state.Push(m_memory.GetSize());
+  state.Push(static_cast<int>(m_memory.GetRevision()));
+  state.Push(m_memory.CountFlagExecuted(0, m_memory.GetSize()));
+  state.Push(m_memory.CountFlagCopied(0, m_memory.GetSize()));
+  
+  state.Push(m_organism->GetInputBuf().GetTotal());
+  state.Push(m_organism->GetOutputBuf().GetTotal());
+  
+  return true;
+}
+
+
 void cHardwareCPU::PrintStatus(ostream& fp)
 {
   fp << m_organism->GetPhenotype().GetCPUCyclesUsed() << " ";
@@ -1205,6 +1282,11 @@ int cHardwareCPU::FindLabel_Forward(const cCodeLabel & search_label,
 {
   assert (pos < search_genome.GetSize() && pos >= 0);
   
+  int found_pos;
+  if (&search_genome == &m_memory && m_label_index.FindForward(*m_inst_set, m_memory, search_label, pos, found_pos)) {
+    return found_pos;
+  }
+  
   int search_start = pos;
   int label_size = search_label.GetSize();
   bool found_label = false;
@@ -1287,6 +1369,11 @@ int cHardwareCPU::FindLabel_Backward(const cCodeLabel & search_label,
 {
   assert (pos < search_genome.GetSize());
   
+  int found_pos;
+  if (&search_genome == &m_memory && m_label_index.FindBackward(*m_inst_set, m_memory, search_label, pos, found_pos)) {
+    return found_pos;
+  }
+  
   int search_start = pos;
   int label_size = search_label.GetSize();
   bool found_label = false;
@@ -1607,9 +1694,10 @@ inline int cHardwareCPU::FindModifiedRegister(int default_register)
 {
   assert(default_register < NUM_REGISTERS);  // Reg ID too high.
   
-  if (m_inst_set->IsNop(getIP().GetNextInst())) {
+  const int nop_mod = m_inst_set->GetModifier(getIP().GetNextInst());
+  if (nop_mod >= 0) {
     getIP().Advance();
-    default_register = m_inst_set->GetNopMod(getIP().GetInst());
+    default_register = nop_mod;
     getIP().SetFlagExecuted();
   }
   return default_register;
@@ -1619,9 +1707,10 @@ inline int cHardwareCPU::FindModifiedNextRegister(int default_register)
 {
   assert(default_register < NUM_REGISTERS);  // Reg ID too high.
   
-  if (m_inst_set->IsNop(getIP().GetNextInst())) {
+  const int nop_mod = m_inst_set->GetModifier(getIP().GetNextInst());
+  if (nop_mod >= 0) {
     getIP().Advance();
-    default_register = m_inst_set->GetNopMod(getIP().GetInst());
+    default_register = nop_mod;
     getIP().SetFlagExecuted();
   } else {
     default_register = (default_register + 1) % NUM_REGISTERS;
@@ -1633,9 +1722,10 @@ inline int cHardwareCPU::FindModifiedPreviousRegister(int default_register)
 {
   assert(default_register < NUM_REGISTERS);  // Reg ID too high.
   
-  if (m_inst_set->IsNop(getIP().GetNextInst())) {
+  const int nop_mod = m_inst_set->GetModifier(getIP().GetNextInst());
+  if (nop_mod >= 0) {
     getIP().Advance();
-    default_register = m_inst_set->GetNopMod(getIP().GetInst());
+    default_register = nop_mod;
     getIP().SetFlagExecuted();
   } else {
     default_register = (default_register + NUM_REGISTERS - 1) % NUM_REGISTERS;
@@ -1648,9 +1738,10 @@ inline int cHardwareCPU::FindModifiedHead(int default_head)
 {
   assert(default_head < NUM_HEADS); // Head ID too high.
   
-  if (m_inst_set->IsNop(getIP().GetNextInst())) {
+  const int nop_mod = m_inst_set->GetModifier(getIP().GetNextInst());
+  if (nop_mod >= 0) {
     getIP().Advance();
-    default_head = m_inst_set->GetNopMod(getIP().GetInst());
+    default_head = nop_mod;
     getIP().SetFlagExecuted();
   }
   return default_head;
@@ -1728,7 +1819,13 @@ bool cHardwareCPU::Allocate_Main(cAvidaContext& ctx, const int allocated_size)
                                            old_size, max_old_size));
     return false;
   }
-  
+
+  // Reserve room for the largest offspring this parent may allocate, so that neither the allocation nor insertions
+  // while copying reallocate memory, now or in later gestations.  Bounded by the configured genome size, if any.
+  const int max_genome_size = m_world->GetConfig().MAX_GENOME_SIZE.Get();
+  const int reserve_limit = (max_genome_size > 0) ? Apto::Min(max_genome_size, MAX_GENOME_LENGTH) : MAX_GENOME_LENGTH;
+  m_memory.Reserve(Apto::Min(old_size + max_alloc_size, reserve_limit));
+
   switch (m_world->GetConfig().ALLOC_METHOD.Get()) {
     case ALLOC_METHOD_NECRO:
       // Only break if this succeeds -- otherwise just do random.
@@ -1748,11 +1845,7 @@ bool cHardwareCPU::Allocate_Main(cAvidaContext& ctx, const int allocated_size)
 
 int cHardwareCPU::calcCopiedSize(const int parent_size, const int child_size)
 {
-  int copied_size = 0;
-  for (int i = parent_size; i < parent_size + child_size; i++) {
-    if (m_memory.FlagCopied(i)) copied_size++;
-  }
-  return copied_size;
+  return m_memory.CountFlagCopied(parent_size, parent_size + child_size);
 }  
 
 
@@ -4826,7 +4919,7 @@ bool cHardwareCPU::Inst_DonateEditDist(cAvidaContext& ctx)
         neighbor_seq_p.DynamicCastFrom(neighbor_genome.Representation());
         const InstructionSequence& neighbor_seq = *neighbor_seq_p;
         
-        edit_dist = InstructionSequence::FindEditDistance(org_seq, neighbor_seq);
+        edit_dist = InstructionSequence::FindEditDistance(org_seq, neighbor_seq, max_dist);
       }
       if (edit_dist <= max_dist) {
         found = true;
@@ -5762,8 +5855,8 @@ bool cHardwareCPU::Inst_RotateToMostNeedy(cAvidaContext&)
   double neighbor_energy;
   
   // Look at the energy levels of neighbors
-  for (int i = 0; i < mycell.ConnectionList().GetSize(); i++) {
-    mycell.ConnectionList().CircNext();
+  for (int i = 0; i < mycell.GetNumNeighbors(); i++) {
+    mycell.RotateFacing();
     neighbor = m_organism->GetNeighbor();
     
     // If this neighbor is alive and has a request for energy or we're allowing pushing of energy, look at it
@@ -5780,7 +5873,7 @@ bool cHardwareCPU::Inst_RotateToMostNeedy(cAvidaContext&)
   
   //Rotate to face the most needy neighbor
   for (int i = 0; i < num_rotations; i++) {
-    mycell.ConnectionList().CircNext();
+    mycell.RotateFacing();
   }
   
   return true;
@@ -6886,7 +6979,7 @@ bool cHardwareCPU::HeadCopy_ErrorCorrect(cAvidaContext& ctx, double reduction)
   Instruction read_inst = read_head.GetInst();
   ReadInst(read_inst.GetOp());
   //checkNoMutList for head to head kaboom experiments
-  if ( ctx.GetRandom().P(m_organism->GetCopyMutProb() / reduction) && !(checkNoMutList(read_head))) {
+  if (m_organism->TestCopyMut(ctx, reduction) && !(checkNoMutList(read_head))) {
     read_inst = m_inst_set->GetRandomInst(ctx);
     write_head.SetFlagMutated();
     write_head.SetFlagCopyMut();
@@ -6895,10 +6988,10 @@ bool cHardwareCPU::HeadCopy_ErrorCorrect(cAvidaContext& ctx, double reduction)
   write_head.SetInst(read_inst);
   write_head.SetFlagCopied();  // Set the copied flag...
   
-  if (ctx.GetRandom().P(m_organism->GetCopyInsProb() / reduction)) write_head.InsertInst(m_inst_set->GetRandomInst(ctx));
-  if (ctx.GetRandom().P(m_organism->GetCopyDelProb() / reduction)) write_head.RemoveInst();
-  if (ctx.GetRandom().P(m_organism->GetCopyUniformProb() / reduction)) doUniformCopyMutation(ctx, write_head);
-  if (ctx.GetRandom().P(m_organism->GetCopySlipProb() / reduction)) {
+  if (m_organism->TestCopyIns(ctx, reduction)) write_head.InsertInst(m_inst_set->GetRandomInst(ctx));
+  if (m_organism->TestCopyDel(ctx, reduction)) write_head.RemoveInst();
+  if (m_organism->TestCopyUniform(ctx, reduction)) doUniformCopyMutation(ctx, write_head);
+  if (m_organism->TestCopySlip(ctx, reduction)) {
     if (m_slip_read_head) {
       read_head.Set(ctx.GetRandom().GetInt(m_memory.GetSize()));
     } else {
@@ -8391,7 +8484,7 @@ bool cHardwareCPU::Inst_Exploit(cAvidaContext& ctx)
     num_rotations = ctx.GetRandom().GetUInt(m_organism->GetNeighborhoodSize());
   } else {
     // Find which neighbor has the strongest pheromone
-    for (int i = 0; i < mycell.ConnectionList().GetSize(); i++) {
+    for (int i = 0; i < mycell.GetNumNeighbors(); i++) {
       
       phero_amount = 0;
       cell_resources = deme_resource_count.GetCellResources(deme.GetRelativeCellID(mycell.GetCellFaced().GetID()), ctx); 
@@ -8407,13 +8500,13 @@ bool cHardwareCPU::Inst_Exploit(cAvidaContext& ctx)
         max_pheromone = phero_amount;
       }
       
-      mycell.ConnectionList().CircNext();
+      mycell.RotateFacing();
     }
   }
   
   // Rotate until we face the neighbor with the strongest pheromone.
   // If there was no winner, just move forward.
-  for (int i = 0; i < num_rotations; i++) mycell.ConnectionList().CircNext();
+  for (int i = 0; i < num_rotations; i++) mycell.RotateFacing();
   
   m_organism->Move(ctx);
   
@@ -8449,11 +8542,11 @@ bool cHardwareCPU::Inst_ExploitForward5(cAvidaContext& ctx)
     num_rotations = ctx.GetRandom().GetUInt(m_organism->GetNeighborhoodSize());
   } else {
     // Find which neighbor has the strongest pheromone
-    for (int i = 0; i < mycell.ConnectionList().GetSize(); i++) {
+    for (int i = 0; i < mycell.GetNumNeighbors(); i++) {
       
       // Skip the cells in the back
       if (i == 3 || i == 4 || i == 5) {
-        mycell.ConnectionList().CircNext();
+        mycell.RotateFacing();
         continue;
       }
       
@@ -8471,14 +8564,14 @@ bool cHardwareCPU::Inst_ExploitForward5(cAvidaContext& ctx)
         max_pheromone = phero_amount;
       }
       
-      mycell.ConnectionList().CircNext();
+      mycell.RotateFacing();
     }
   }
   
   // Rotate until we face the neighbor with the strongest pheromone.
   // If there was no winner, just move forward.
   for (int i = 0; i < num_rotations; i++) {
-    mycell.ConnectionList().CircNext();
+    mycell.RotateFacing();
   }
   
   m_organism->Move(ctx);
@@ -8514,11 +8607,11 @@ bool cHardwareCPU::Inst_ExploitForward3(cAvidaContext& ctx)
     num_rotations = ctx.GetRandom().GetUInt(m_organism->GetNeighborhoodSize());
   } else {
     // Find which neighbor has the strongest pheromone
-    for (int i = 0; i < mycell.ConnectionList().GetSize(); i++) {
+    for (int i = 0; i < mycell.GetNumNeighbors(); i++) {
       
       // Skip the cells in the back
       if (i == 2 || i == 3 || i == 4 || i == 5 || i == 6) {
-        mycell.ConnectionList().CircNext();
+        mycell.RotateFacing();
         continue;
       }
       
@@ -8536,14 +8629,14 @@ bool cHardwareCPU::Inst_ExploitForward3(cAvidaContext& ctx)
         max_pheromone = phero_amount;
       }
       
-      mycell.ConnectionList().CircNext();
+      mycell.RotateFacing();
     }
   }
   
   // Rotate until we face the neighbor with the strongest pheromone.
   // If there was no winner, just move forward.
   for (int i = 0; i < num_rotations; i++) {
-    mycell.ConnectionList().CircNext();
+    mycell.RotateFacing();
   }
   
   m_organism->Move(ctx);
@@ -8594,20 +8687,20 @@ bool cHardwareCPU::Inst_MoveTarget(cAvidaContext& ctx)
   cPopulationCell faced = mycell.GetCellFaced();
   
   // Find if any neighbor is a target
-  for (int i = 0; i < mycell.ConnectionList().GetSize(); i++) {
+  for (int i = 0; i < mycell.GetNumNeighbors(); i++) {
     cell_data = mycell.GetCellFaced().GetCellData();
     
     if (cell_data > 0) {
       num_rotations = i;
     }
     
-    mycell.ConnectionList().CircNext();
+    mycell.RotateFacing();
   }
   
   // Rotate until we face the neighbor with a target.
   // If there was no winner, just move forward.
   for (int i = 0; i < num_rotations; i++) {
-    mycell.ConnectionList().CircNext();
+    mycell.RotateFacing();
   }
   
   m_organism->Move(ctx);
@@ -8640,11 +8733,11 @@ bool cHardwareCPU::Inst_MoveTargetForward5(cAvidaContext& ctx)
   cPopulationCell faced = mycell.GetCellFaced();
   
   // Find if any neighbor is a target
-  for (int i = 0; i < mycell.ConnectionList().GetSize(); i++) {
+  for (int i = 0; i < mycell.GetNumNeighbors(); i++) {
     
     // Skip the cells behind
     if (i == 3 || i == 4 || i == 5) {
-      mycell.ConnectionList().CircNext();
+      mycell.RotateFacing();
       continue;
     }
     
@@ -8654,13 +8747,13 @@ bool cHardwareCPU::Inst_MoveTargetForward5(cAvidaContext& ctx)
       num_rotations = i;
     }
     
-    mycell.ConnectionList().CircNext();
+    mycell.RotateFacing();
   }
   
   // Rotate until we face the neighbor with a target.
   // If there was no winner, just move forward.
   for (int i = 0; i < num_rotations; i++) {
-    mycell.ConnectionList().CircNext();
+    mycell.RotateFacing();
   }
   
   m_organism->Move(ctx);
@@ -8692,11 +8785,11 @@ bool cHardwareCPU::Inst_MoveTargetForward3(cAvidaContext& ctx)
   cPopulationCell faced = mycell.GetCellFaced();
   
   // Find if any neighbor is a target
-  for (int i = 0; i < mycell.ConnectionList().GetSize(); i++) {
+  for (int i = 0; i < mycell.GetNumNeighbors(); i++) {
     
     // Skip the cells behind
     if (i==2 || i == 3 || i == 4 || i == 5 || i == 6) {
-      mycell.ConnectionList().CircNext();
+      mycell.RotateFacing();
       continue;
     }
     
@@ -8706,13 +8799,13 @@ bool cHardwareCPU::Inst_MoveTargetForward3(cAvidaContext& ctx)
       num_rotations = i;
     }
     
-    mycell.ConnectionList().CircNext();
+    mycell.RotateFacing();
   }
   
   // Rotate until we face the neighbor with a target.
   // If there was no winner, just move forward.
   for (int i = 0; i < num_rotations; i++) {
-    mycell.ConnectionList().CircNext();
+    mycell.RotateFacing();
   }
   
   m_organism->Move(ctx);
@@ -8748,7 +8841,7 @@ bool cHardwareCPU::Inst_SuperMove(cAvidaContext& ctx)
   
   
   // Find the neighbor with highest pheromone -- medium priority
-  for (int i = 0; i < mycell.ConnectionList().GetSize(); i++) {
+  for (int i = 0; i < mycell.GetNumNeighbors(); i++) {
     
     phero_amount = 0;
     cell_resources = deme_resource_count.GetCellResources(deme.GetRelativeCellID(mycell.GetCellFaced().GetID()), ctx); 
@@ -8764,24 +8857,24 @@ bool cHardwareCPU::Inst_SuperMove(cAvidaContext& ctx)
       max_pheromone = phero_amount;
     }
     
-    mycell.ConnectionList().CircNext();
+    mycell.RotateFacing();
   }
   
   // Find if any neighbor is a target -- highest priority
-  for (int i = 0; i < mycell.ConnectionList().GetSize(); i++) {
+  for (int i = 0; i < mycell.GetNumNeighbors(); i++) {
     cell_data = mycell.GetCellFaced().GetCellData();
     
     if (cell_data > 0) {
       num_rotations = i;
     }
     
-    mycell.ConnectionList().CircNext();
+    mycell.RotateFacing();
   }
   
   // Rotate until we face the neighbor with a target.
   // If there was no winner, just move forward.
   for (int i = 0; i < num_rotations; i++) {
-    mycell.ConnectionList().CircNext();
+    mycell.RotateFacing();
   }
   
   m_organism->Move(ctx);
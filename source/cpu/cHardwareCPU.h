@@ -26,10 +26,12 @@
 #include "avida/Avida.h"
 
 #include "cCodeLabel.h"
+#include "cFreeListPool.h"
 #include "cHeadCPU.h"
 #include "cCPUMemory.h"
 #include "cCPUStack.h"
 #include "cHardwareBase.h"
+#include "cLabelIndex.h"
 #include "cString.h"
 #include "cStats.h"
 #include "tInstLib.h"
@@ -99,6 +101,7 @@ protected:
 
   // --------  Static Variables  --------
   static tInstLib<tMethod>* s_inst_slib;
+  static cFreeListPool* const s_pool;
   static tInstLib<tMethod>* initInstLib(void);
 
 
@@ -106,6 +109,7 @@ protected:
   const tMethod* m_functions;
 
   cCPUMemory m_memory;          // Memory...
+  cLabelIndex m_label_index;    // Labels in m_memory, for repeated template searches
   cCPUStack m_global_stack;     // A stack that all threads share.
 
   Apto::Array<cLocalThread> m_threads;
@@ -126,6 +130,8 @@ protected:
     bool m_constitutive_regulation:1;
 
     bool m_slip_read_head:1;
+
+    bool m_state_capturable:1;   // Is the next instruction decided by the hardware state alone?
   };
 
   // <-- Promoter model
@@ -230,6 +236,7 @@ protected:
   bool Inst_HeadDivideMut(cAvidaContext& ctx, double mut_multiplier = 1);
 
   void ReadInst(const int in_inst);
+  bool checkStateCapturable() const;
 
 
   cHardwareCPU& operator=(const cHardwareCPU&); // @not_implemented
@@ -237,6 +244,10 @@ protected:
 public:
   cHardwareCPU(cAvidaContext& ctx, cWorld* world, cOrganism* in_organism, cInstSet* in_inst_set);
   ~cHardwareCPU() { ; }
+  
+  // Hardware storage is recycled through a free list rather than returned to the system allocator
+  static void* operator new(size_t size) { return s_pool->Allocate(size); }
+  static void operator delete(void* ptr, size_t size) { s_pool->Release(ptr, size); }
 
   static tInstLib<tMethod>* GetInstLib() { return s_inst_slib; }
   static cString GetDefaultInstFilename() { return "instset-heads.cfg"; }
@@ -252,6 +263,7 @@ public:
   void SetupMiniTraceFileHeader(Avida::Output::File& df, const int gen_id, const Apto::String& genotype);
   void PrintMiniTraceStatus(cAvidaContext& ctx, std::ostream& fp) { (void)ctx, (void)fp; }
   void PrintMiniTraceSuccess(std::ostream& fp, const int exec_success) { (void)fp, (void)exec_success; }
+  bool CaptureExecutionState(Apto::Array<int>& state) const;
 
   // --------  Stack Manipulation...  --------
   inline int GetStack(int depth=0, int stack_id=-1, int in_thread=-1) const;
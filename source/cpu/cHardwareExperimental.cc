@@ -63,6 +63,7 @@ inline unsigned int cHardwareExperimental::BitCount(unsigned int value) const
 
 
 tInstLib<cHardwareExperimental::tMethod>* cHardwareExperimental::s_inst_slib = cHardwareExperimental::initInstLib();
+cFreeListPool* const cHardwareExperimental::s_pool = new cFreeListPool("cHardwareExperimental", sizeof(cHardwareExperimental));
 
 tInstLib<cHardwareExperimental::tMethod>* cHardwareExperimental::initInstLib(void)
 {
@@ -792,7 +793,7 @@ void cHardwareExperimental::PrintStatus(ostream& fp)
     DataValue& reg = m_threads[m_cur_thread].reg[i];
     fp << static_cast<char>('A' + i) << "X:" << GetRegister(i) << " ";
     fp << setbase(16) << "[0x" << reg.value <<  "] " << setbase(10);
-    fp << "(" << reg.from_env << " " << reg.env_component << " " << reg.originated << " " << reg.oldest_component << ")  ";
+    fp << "(" << reg.FromEnv() << " " << reg.EnvComponent() << " " << reg.Originated() << " " << reg.OldestComponent() << ")  ";
   }
   
   // Add some extra information if additional time costs are used for instructions,
@@ -887,7 +888,7 @@ void cHardwareExperimental::PrintMiniTraceStatus(cAvidaContext& ctx, ostream& fp
   for (int i = 0; i < NUM_REGISTERS; i++) {
     DataValue& reg = m_threads[m_cur_thread].reg[i];
     fp << GetRegister(i) << " ";
-    fp << "(" << reg.originated << ") ";
+    fp << "(" << reg.Originated() << ") ";
   }    
   // genome loc info
   fp << m_cur_thread << " ";
@@ -972,41 +973,19 @@ cHeadCPU cHardwareExperimental::FindLabelStart(bool mark_executed)
   if (search_label.GetSize() == 0) return ip;
   
   cCPUMemory& memory = m_memory;
-  int pos = 0;
+  const cNopSearchCache::sResult& result =
+    m_nop_search.Find(*m_inst_set, memory, cNopSearchCache::LABEL_START, search_label, 0);
   
-  while (pos < memory.GetSize()) {
-    if (m_inst_set->IsLabel(memory[pos])) { // starting label found
-      pos++;
-      
-      // Check for direct matched label pattern, can be substring of 'label'ed target
-      // - must match all NOPs in search_label
-      // - extra NOPs in 'label'ed target are ignored
-      int size_matched = 0;
-      while (size_matched < search_label.GetSize() && pos < memory.GetSize()) {
-        if (!m_inst_set->IsNop(memory[pos]) || search_label[size_matched] != m_inst_set->GetNopMod(memory[pos])) break;
-        size_matched++;
-        pos++;
-      }
-      
-      // Check that the label matches and has examined the full sequence of nops following the 'label' instruction
-      if (size_matched == search_label.GetSize()) {
-        // Return Head pointed at last NOP of label sequence
-        if (mark_executed) {
-          size_matched++; // Increment size matched so that it includes the label instruction
-          const int start = pos - size_matched;
-          const int max = m_world->GetConfig().MAX_LABEL_EXE_SIZE.Get() + 1; // Max label + 1 for the label instruction itself
-          for (int i = 0; i < size_matched && i < max; i++) memory.SetFlagExecuted(start + i);
-        }
-        return cHeadCPU(this, pos - 1, ip.GetMemSpace());
-      }
-      
-      continue; 
-    }
-    pos++;
+  // Return start point if not found
+  if (result.found_pos < 0) return ip;
+  
+  if (mark_executed) {
+    const int max = m_world->GetConfig().MAX_LABEL_EXE_SIZE.Get() + 1; // Max label + 1 for the label instruction itself
+    cNopSearchCache::MarkExecuted(memory, result, max);
   }
   
-  // Return start point if not found
-  return ip;
+  // Return Head pointed at last NOP of label sequence
+  return cHeadCPU(this, result.found_pos, ip.GetMemSpace());
 }
 
 cHeadCPU cHardwareExperimental::FindNopSequenceStart(bool mark_executed)
@@ -1018,37 +997,19 @@ cHeadCPU cHardwareExperimental::FindNopSequenceStart(bool mark_executed)
   if (search_label.GetSize() == 0) return ip;
   
   cCPUMemory& memory = m_memory;
-  int pos = 0;
+  const cNopSearchCache::sResult& result =
+    m_nop_search.Find(*m_inst_set, memory, cNopSearchCache::NOP_SEQUENCE_START, search_label, 0);
   
-  while (pos < memory.GetSize()) {
-    if (m_inst_set->IsNop(memory[pos])) { // start of sequence found
-      
-      // Check for direct matched label pattern, can be substring of 'label'ed target
-      // - must match all NOPs in search_label
-      // - extra NOPs in 'label'ed target are ignored
-      int size_matched = 0;
-      while (size_matched < search_label.GetSize() && pos < memory.GetSize()) {
-        if (!m_inst_set->IsNop(memory[pos]) || search_label[size_matched] != m_inst_set->GetNopMod(memory[pos])) break;
-        size_matched++;
-        pos++;
-      }
-      
-      // Check that the label matches and has examined the full sequence of nops following the 'label' instruction
-      if (size_matched == search_label.GetSize()) {
-        // Return Head pointed at last NOP of label sequence
-        if (mark_executed) {
-          const int start = pos - size_matched;
-          const int max = m_world->GetConfig().MAX_LABEL_EXE_SIZE.Get();
-          for (int i = 0; i < size_matched && i < max; i++) memory.SetFlagExecuted(start + i);
-        }
-        return cHeadCPU(this, pos - 1, ip.GetMemSpace());
-      }
-    }
-    pos++;
+  // Return start point if not found
+  if (result.found_pos < 0) return ip;
+  
+  if (mark_executed) {
+    const int max = m_world->GetConfig().MAX_LABEL_EXE_SIZE.Get();
+    cNopSearchCache::MarkExecuted(memory, result, max);
   }
   
-  // Return start point if not found
-  return ip;
+  // Return Head pointed at last NOP of label sequence
+  return cHeadCPU(this, result.found_pos, ip.GetMemSpace());
 }
 
 
@@ -1060,46 +1021,20 @@ cHeadCPU cHardwareExperimental::FindLabelForward(bool mark_executed)
   // Make sure the label is of size > 0.
   if (search_label.GetSize() == 0) return ip;
   
-  cHeadCPU pos(ip);
-  pos++;
+  cCPUMemory& memory = ip.GetMemory();
+  const cNopSearchCache::sResult& result =
+    m_nop_search.Find(*m_inst_set, memory, cNopSearchCache::LABEL_FORWARD, search_label, ip.GetPosition());
   
-  while (pos.GetPosition() != ip.GetPosition()) {
-    if (m_inst_set->IsLabel(pos.GetInst())) { // starting label found
-      const int label_start = pos.GetPosition();
-      pos++;
-      
-      // Check for direct matched label pattern, can be substring of 'label'ed target
-      // - must match all NOPs in search_label
-      // - extra NOPs in 'label'ed target are ignored
-      int size_matched = 0;
-      while (size_matched < search_label.GetSize() && pos.GetPosition() != ip.GetPosition()) {
-        if (!m_inst_set->IsNop(pos.GetInst()) || search_label[size_matched] != m_inst_set->GetNopMod(pos.GetInst())) break;
-        size_matched++;
-        pos++;
-      }
-      
-      // Check that the label matches and has examined the full sequence of nops following the 'label' instruction
-      if (size_matched == search_label.GetSize()) {
-        pos--;
-        const int found_pos = pos.GetPosition();
-        
-        if (mark_executed) {
-          pos.Set(label_start);
-          const int max = m_world->GetConfig().MAX_LABEL_EXE_SIZE.Get() + 1; // Max label + 1 for the label instruction itself
-          for (int i = 0; i < size_matched && i < max; i++, pos++) pos.SetFlagExecuted();
-        }
-        
-        // Return Head pointed at last NOP of label sequence
-        return cHeadCPU(this, found_pos, ip.GetMemSpace());
-      }
-      
-      continue; 
-    }
-    pos++;
+  // Return start point if not found
+  if (result.found_pos < 0) return ip;
+  
+  if (mark_executed) {
+    const int max = m_world->GetConfig().MAX_LABEL_EXE_SIZE.Get() + 1; // Max label + 1 for the label instruction itself
+    cNopSearchCache::MarkExecuted(memory, result, max);
   }
   
-  // Return start point if not found
-  return ip;
+  // Return Head pointed at last NOP of label sequence
+  return cHeadCPU(this, result.found_pos, ip.GetMemSpace());
 }
 
 cHeadCPU cHardwareExperimental::FindLabelBackward(bool mark_executed)
@@ -1161,45 +1096,20 @@ cHeadCPU cHardwareExperimental::FindNopSequenceForward(bool mark_executed)
   // Make sure the label is of size > 0.
   if (search_label.GetSize() == 0) return ip;
   
-  cHeadCPU pos(ip);
-  pos++;
+  cCPUMemory& memory = ip.GetMemory();
+  const cNopSearchCache::sResult& result =
+    m_nop_search.Find(*m_inst_set, memory, cNopSearchCache::NOP_SEQUENCE_FORWARD, search_label, ip.GetPosition());
   
-  while (pos.GetPosition() != ip.GetPosition()) {
-    if (m_inst_set->IsNop(pos.GetInst())) { // starting label found
-      const int label_start = pos.GetPosition();
-      
-      // Check for direct matched nop sequence, can be substring of target
-      // - must match all NOPs in search_label
-      // - extra NOPs in target are ignored
-      int size_matched = 0;
-      while (size_matched < search_label.GetSize() && pos.GetPosition() != ip.GetPosition()) {
-        if (!m_inst_set->IsNop(pos.GetInst()) || search_label[size_matched] != m_inst_set->GetNopMod(pos.GetInst())) break;
-        size_matched++;
-        pos++;
-      }
-      
-      // Check that the label matches and has examined the full sequence of nops
-      if (size_matched == search_label.GetSize()) {
-        pos--;
-        const int found_pos = pos.GetPosition();
-        
-        if (mark_executed) {
-          pos.Set(label_start);
-          const int max = m_world->GetConfig().MAX_LABEL_EXE_SIZE.Get();
-          for (int i = 0; i < size_matched && i < max; i++, pos++) pos.SetFlagExecuted();
-        }
-        
-        // Return Head pointed at last NOP of label sequence
-        return cHeadCPU(this, found_pos, ip.GetMemSpace());
-      }
-    }
-    
-    if (pos.GetPosition() == ip.GetPosition()) break;
-    pos++;
+  // Return start point if not found
+  if (result.found_pos < 0) return ip;
+  
+  if (mark_executed) {
+    const int max = m_world->GetConfig().MAX_LABEL_EXE_SIZE.Get();
+    cNopSearchCache::MarkExecuted(memory, result, max);
   }
   
-  // Return start point if not found
-  return ip;
+  // Return Head pointed at last NOP of label sequence
+  return cHeadCPU(this, result.found_pos, ip.GetMemSpace());
 }
 
 
@@ -1395,9 +1305,10 @@ inline int cHardwareExperimental::FindModifiedRegister(int default_register)
 {
   assert(default_register < NUM_REGISTERS);  // Reg ID too high.
   
-  if (m_inst_set->IsNop(getIP().GetNextInst())) {
+  const int nop_mod = m_inst_set->GetModifier(getIP().GetNextInst());
+  if (nop_mod >= 0) {
     getIP().Advance();
-    default_register = m_inst_set->GetNopMod(getIP().GetInst());
+    default_register = nop_mod;
     getIP().SetFlagExecuted();
   }
   return default_register;
@@ -1407,9 +1318,10 @@ inline int cHardwareExperimental::FindModifiedNextRegister(int default_register)
 {
   assert(default_register < NUM_REGISTERS);  // Reg ID too high.
   
-  if (m_inst_set->IsNop(getIP().GetNextInst())) {
+  const int nop_mod = m_inst_set->GetModifier(getIP().GetNextInst());
+  if (nop_mod >= 0) {
     getIP().Advance();
-    default_register = m_inst_set->GetNopMod(getIP().GetInst());
+    default_register = nop_mod;
     getIP().SetFlagExecuted();
   } else {
     default_register = (default_register + 1) % NUM_REGISTERS;
@@ -1421,9 +1333,10 @@ inline int cHardwareExperimental::FindModifiedPreviousRegister(int default_regis
 {
   assert(default_register < NUM_REGISTERS);  // Reg ID too high.
   
-  if (m_inst_set->IsNop(getIP().GetNextInst())) {
+  const int nop_mod = m_inst_set->GetModifier(getIP().GetNextInst());
+  if (nop_mod >= 0) {
     getIP().Advance();
-    default_register = m_inst_set->GetNopMod(getIP().GetInst());
+    default_register = nop_mod;
     getIP().SetFlagExecuted();
   } else {
     default_register = (default_register + NUM_REGISTERS - 1) % NUM_REGISTERS;
@@ -1436,9 +1349,10 @@ inline int cHardwareExperimental::FindModifiedHead(int default_head)
 {
   assert(default_head < NUM_HEADS); // Head ID too high.
   
-  if (m_inst_set->IsNop(getIP().GetNextInst())) {
+  const int nop_mod = m_inst_set->GetModifier(getIP().GetNextInst());
+  if (nop_mod >= 0) {
     getIP().Advance();
-    default_head = m_inst_set->GetNopMod(getIP().GetInst());
+    default_head = nop_mod;
     getIP().SetFlagExecuted();
   }
   return default_head;
@@ -1536,11 +1450,7 @@ bool cHardwareExperimental::Allocate_Main(cAvidaContext& ctx, const int allocate
 
 int cHardwareExperimental::calcCopiedSize(const int parent_size, const int child_size)
 {
-  int copied_size = 0;
-  for (int i = parent_size; i < parent_size + child_size; i++) {
-    if (m_memory.FlagCopied(i)) copied_size++;
-  }
-  return copied_size;
+  return m_memory.CountFlagCopied(parent_size, parent_size + child_size);
 }  
 
 bool cHardwareExperimental::Divide_Main(cAvidaContext& ctx, const int div_point, const int extra_lines, double mut_multiplier)
@@ -1608,11 +1518,12 @@ void cHardwareExperimental::checkWaitingThreads(int cur_thread, int reg_num)
         
         // Set destination register to be the check value
         DataValue& dest = m_threads[i].reg[m_threads[i].wait_dst];
+        const unsigned int kept = DataValue::FROM_SENSOR | DataValue::FROM_MESSAGE | DataValue::SENSOR_COMPONENT |
+                                  DataValue::MESSAGE_COMPONENT;
+        const unsigned int src = m_threads[cur_thread].reg[reg_num].provenance;
         dest.value = check_value;
-        dest.from_env = false;
-        dest.originated = m_cycle_count;
-        dest.oldest_component = m_threads[cur_thread].reg[reg_num].oldest_component;
-        dest.env_component = m_threads[cur_thread].reg[reg_num].env_component;
+        dest.provenance = (dest.provenance & kept) | (m_cycle_count & DataValue::AGE_MASK) |
+                          (src & (DataValue::OLDEST_COMPONENT | DataValue::ENV_COMPONENT));
         
         // Cascade check
         if (m_waiting_threads) checkWaitingThreads(i, m_threads[i].wait_dst);
@@ -2096,7 +2007,7 @@ bool cHardwareExperimental::Inst_TaskIOExpire(cAvidaContext& ctx)
   const int reg_used = FindModifiedRegister(rBX);
   DataValue& reg = m_threads[m_cur_thread].reg[reg_used];
   
-  if (m_io_expire && reg.env_component && reg.oldest_component < m_last_output) return false;
+  if (m_io_expire && reg.EnvComponent() && reg.OldestComponent() < m_last_output) return false;
   
   // Do the "put" component
   m_organism->DoOutput(ctx, reg.value);  // Check for tasks completed.
@@ -2161,7 +2072,7 @@ bool cHardwareExperimental::Inst_TaskOutputExpire(cAvidaContext& ctx)
   const int reg_used = FindModifiedRegister(rBX);
   DataValue& reg = m_threads[m_cur_thread].reg[reg_used];
   
-  if (m_io_expire && reg.env_component && reg.oldest_component < m_last_output) return false;
+  if (m_io_expire && reg.EnvComponent() && reg.OldestComponent() < m_last_output) return false;
   
   // Do the "put" component
   m_organism->DoOutput(ctx, reg.value);  // Check for tasks completed.
@@ -2983,9 +2894,7 @@ bool cHardwareExperimental::Inst_Repro(cAvidaContext& ctx)
   m_organism->OffspringGenome() = offspring;  
   m_organism->GetPhenotype().SetLinesCopied(m_memory.GetSize());
   
-  int lines_executed = 0;
-  for (int i = 0; i < m_memory.GetSize(); i++) if (m_memory.FlagExecuted(i)) lines_executed++;
-  m_organism->GetPhenotype().SetLinesExecuted(lines_executed);
+  m_organism->GetPhenotype().SetLinesExecuted(m_memory.CountFlagExecuted(0, m_memory.GetSize()));
   
   const Genome& org = m_organism->GetGenome();
   ConstInstructionSequencePtr org_seq_p;
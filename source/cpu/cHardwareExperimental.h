@@ -29,8 +29,10 @@
 #include "cCPUMemory.h"
 #include "cEnvReqs.h"
 #include "cEnvironment.h"
+#include "cFreeListPool.h"
 #include "cHardwareBase.h"
 #include "cHeadCPU.h"
+#include "cNopSearchCache.h"
 #include "cOrgSensor.h"
 #include "cStats.h"
 #include "cString.h"
@@ -71,6 +73,7 @@ private:
   
   // --------  Static Variables  --------
   static tInstLib<cHardwareExperimental::tMethod>* s_inst_slib;
+  static cFreeListPool* const s_pool;
   static tInstLib<cHardwareExperimental::tMethod>* initInstLib(void);
   
   
@@ -79,21 +82,36 @@ private:
   {
     int value;
     
-    // Actual age of this value
-    unsigned int originated:13; // warning: this is now only good up to 8,100 updates
-    unsigned int from_env:1;
-    unsigned int from_sensor:1;
-    unsigned int from_message:1;
+    // Provenance of this value, packed into a single word so that each register write updates it with one store:
+    //   bits  0-12  originated - actual age of this value (warning: this is now only good up to 8,100 updates)
+    //   bit  13     from_env, bit 14 from_sensor, bit 15 from_message
+    //   bits 16-28  oldest_component - age of the oldest component used to create this value
+    //   bit  29     env_component, bit 30 sensor_component, bit 31 message_component
+    unsigned int provenance;
     
-    // Age of the oldest component used to create this value
-    unsigned int oldest_component:13;
-    unsigned int env_component:1;
-    unsigned int sensor_component:1;
-    unsigned int message_component:1;
+    static const int AGE_BITS = 13;
+    static const unsigned int AGE_MASK = (1u << AGE_BITS) - 1;
+    static const int OLDEST_SHIFT = 16;
+    static const unsigned int ORIGINATED = AGE_MASK;
+    static const unsigned int FROM_ENV = 1u << 13;
+    static const unsigned int FROM_SENSOR = 1u << 14;
+    static const unsigned int FROM_MESSAGE = 1u << 15;
+    static const unsigned int OLDEST_COMPONENT = AGE_MASK << OLDEST_SHIFT;
+    static const unsigned int ENV_COMPONENT = 1u << 29;
+    static const unsigned int SENSOR_COMPONENT = 1u << 30;
+    static const unsigned int MESSAGE_COMPONENT = 1u << 31;
+    static const unsigned int COMPONENTS = ENV_COMPONENT | SENSOR_COMPONENT | MESSAGE_COMPONENT;
     
     inline DataValue() { Clear(); }
-    inline void Clear() { value = 0; originated = 0; from_env = 0, from_sensor = 0, from_message = 0, oldest_component = 0; env_component = 0, sensor_component = 0, message_component = 0; }
+    inline void Clear() { value = 0; provenance = 0; }
     inline DataValue& operator=(const DataValue& i);
+    
+    inline int Originated() const { return provenance & ORIGINATED; }
+    inline bool FromEnv() const { return (provenance & FROM_ENV) != 0; }
+    inline bool FromSensor() const { return (provenance & FROM_SENSOR) != 0; }
+    inline bool FromMessage() const { return (provenance & FROM_MESSAGE) != 0; }
+    inline int OldestComponent() const { return (provenance >> OLDEST_SHIFT) & AGE_MASK; }
+    inline bool EnvComponent() const { return (provenance & ENV_COMPONENT) != 0; }
   };
   
   
@@ -188,6 +206,7 @@ private:
   const tMethod* m_functions;
   
   cCPUMemory m_memory;          // Memory...
+  cNopSearchCache m_nop_search; // Recent label and nop sequence searches of m_memory
   Stack m_global_stack;     // A stack that all threads share.
   
   Apto::Array<cLocalThread, Apto::ManagedPointer> m_threads;
@@ -240,6 +259,10 @@ public:
   cHardwareExperimental(cAvidaContext& ctx, cWorld* world, cOrganism* in_organism, cInstSet* in_inst_set);
   ~cHardwareExperimental() { ; }
   
+  // Hardware storage is recycled through a free list rather than returned to the system allocator
+  static void* operator new(size_t size) { return s_pool->Allocate(size); }
+  static void operator delete(void* ptr, size_t size) { s_pool->Release(ptr, size); }
+  
   static tInstLib<cHardwareExperimental::tMethod>* GetInstLib() { return s_inst_slib; }
   static cString GetDefaultInstFilename() { return "instset-experimental.cfg"; }
   
@@ -288,8 +311,8 @@ public:
   // --------  Register Manipulation  --------
   int GetRegister(int reg_id) const { return m_threads[m_cur_thread].reg[reg_id].value; }
   int GetNumRegisters() const { return NUM_REGISTERS; }
-  bool FromSensor(int reg_id) const { return m_threads[m_cur_thread].reg[reg_id].from_sensor; }
-  bool FromMessage(int reg_id) const { return m_threads[m_cur_thread].reg[reg_id].from_message; }
+  bool FromSensor(int reg_id) const { return m_threads[m_cur_thread].reg[reg_id].FromSensor(); }
+  bool FromMessage(int reg_id) const { return m_threads[m_cur_thread].reg[reg_id].FromMessage(); }
   
   
   // --------  Thread Manipulation  --------
@@ -740,11 +763,10 @@ public:
 
 inline cHardwareExperimental::DataValue& cHardwareExperimental::DataValue::operator=(const DataValue& i)
 {
+  // Assignment carries the age and environment provenance, the sensor and message flags stay with the destination
+  const unsigned int copied = ORIGINATED | FROM_ENV | OLDEST_COMPONENT | ENV_COMPONENT;
   value = i.value;
-  originated = i.originated;
-  from_env = i.from_env;
-  oldest_component = i.oldest_component;
-  env_component = i.env_component;
+  provenance = (provenance & ~copied) | (i.provenance & copied);
   return *this;
 }
 
@@ -798,15 +820,12 @@ inline int cHardwareExperimental::GetStack(int depth, int stack_id, int in_threa
 inline void cHardwareExperimental::setInternalValue(int reg_num, int value, bool from_env, bool from_sensor, bool from_message)
 {
   DataValue& dest = m_threads[m_cur_thread].reg[reg_num];
+  const unsigned int age = m_cycle_count & DataValue::AGE_MASK;
   dest.value = value;
-  dest.from_env = from_env;
-  dest.originated = m_cycle_count;
-  dest.oldest_component = m_cycle_count;
-  dest.env_component = from_env;
-  dest.from_sensor = from_sensor;
-  dest.from_message = from_message;
-  dest.sensor_component = from_sensor;
-  dest.message_component = from_message;
+  dest.provenance = age | (age << DataValue::OLDEST_SHIFT) |
+    (from_env ? (DataValue::FROM_ENV | DataValue::ENV_COMPONENT) : 0) |
+    (from_sensor ? (DataValue::FROM_SENSOR | DataValue::SENSOR_COMPONENT) : 0) |
+    (from_message ? (DataValue::FROM_MESSAGE | DataValue::MESSAGE_COMPONENT) : 0);
   if (m_waiting_threads) checkWaitingThreads(m_cur_thread, reg_num);
 }
 
@@ -815,14 +834,8 @@ inline void cHardwareExperimental::setInternalValue(int reg_num, int value, cons
 {
   DataValue& dest = m_threads[m_cur_thread].reg[reg_num];
   dest.value = value;
-  dest.from_env = false;
-  dest.from_sensor = false;
-  dest.from_message = false;
-  dest.originated = m_cycle_count;
-  dest.oldest_component = src.oldest_component;
-  dest.env_component = src.env_component;
-  dest.sensor_component = src.sensor_component;
-  dest.message_component = src.message_component;
+  dest.provenance = (m_cycle_count & DataValue::AGE_MASK) |
+    (src.provenance & (DataValue::OLDEST_COMPONENT | DataValue::COMPONENTS));
   if (m_waiting_threads) checkWaitingThreads(m_cur_thread, reg_num);
 }
 
@@ -830,15 +843,11 @@ inline void cHardwareExperimental::setInternalValue(int reg_num, int value, cons
 inline void cHardwareExperimental::setInternalValue(int reg_num, int value, const DataValue& op1, const DataValue& op2)
 {
   DataValue& dest = m_threads[m_cur_thread].reg[reg_num];
+  const unsigned int oldest1 = op1.provenance & DataValue::OLDEST_COMPONENT;
+  const unsigned int oldest2 = op2.provenance & DataValue::OLDEST_COMPONENT;
   dest.value = value;
-  dest.from_env = false;
-  dest.from_sensor = false;
-  dest.from_message = false;
-  dest.originated = m_cycle_count;
-  dest.oldest_component = (op1.oldest_component < op2.oldest_component) ? op1.oldest_component : op2.oldest_component;
-  dest.env_component = (op1.env_component || op2.env_component);
-  dest.sensor_component = (op1.sensor_component || op2.sensor_component);
-  dest.message_component = (op1.message_component || op2.message_component);
+  dest.provenance = (m_cycle_count & DataValue::AGE_MASK) | ((oldest1 < oldest2) ? oldest1 : oldest2) |
+    ((op1.provenance | op2.provenance) & DataValue::COMPONENTS);
   if (m_waiting_threads) checkWaitingThreads(m_cur_thread, reg_num);
 }
 
@@ -30,8 +30,10 @@
 #include "cCPUMemory.h"
 #include "cEnvReqs.h"
 #include "cEnvironment.h"
+#include "cFreeListPool.h"
 #include "cHardwareBase.h"
 #include "cHeadCPU.h"
+#include "cNopSearchCache.h"
 #include "cOrgSensor.h"
 #include "cStats.h"
 #include "cString.h"
@@ -78,6 +80,7 @@ private:
 
   // --------  Static Variables  --------
   static GP8InstLib* s_inst_slib;
+  static cFreeListPool* const s_pool;
   
 
 private:
@@ -117,6 +120,7 @@ private:
       { m_hw = hw; m_pos = pos; m_ms = ms; m_is_gene = is_gene; }
     
     inline cCPUMemory& GetMemory() { return (m_is_gene) ? m_hw->m_genes[m_ms].memory : m_hw->m_mem_array[m_ms]; }
+    inline const cCPUMemory& GetMemory() const { return (m_is_gene) ? m_hw->m_genes[m_ms].memory : m_hw->m_mem_array[m_ms]; }
     
     inline void Adjust();
     
@@ -135,8 +139,8 @@ private:
     
     inline void Advance() { m_pos++; Adjust(); }
     
-    inline const Instruction& GetInst() { return GetMemory()[m_pos]; }
-    inline const Instruction& GetInst(int offset) { return GetMemory()[m_pos + offset]; }
+    inline const Instruction& GetInst() const { return GetMemory()[m_pos]; }
+    inline const Instruction& GetInst(int offset) const { return GetMemory()[m_pos + offset]; }
     inline Instruction NextInst();
     inline Instruction PrevInst();
     
@@ -257,6 +261,8 @@ private:
   Apto::Array<cCPUMemory, Apto::ManagedPointer> m_mem_array;
   char m_mem_ids[MAX_MEM_SPACES];
   
+  cNopSearchCache m_nop_search;  // Recent label and nop sequence searches, of both genes and memory spaces
+  
   // Stacks
   Stack m_global_stack;     // A stack that all threads share.
   
@@ -322,6 +328,10 @@ public:
   cHardwareGP8(cAvidaContext& ctx, cWorld* world, cOrganism* in_organism, cInstSet* in_inst_set);
   ~cHardwareGP8() { ; }
   
+  // Hardware storage is recycled through a free list rather than returned to the system allocator
+  static void* operator new(size_t size) { return s_pool->Allocate(size); }
+  static void operator delete(void* ptr, size_t size) { s_pool->Release(ptr, size); }
+  
   static cInstLib* GetInstLib() { return s_inst_slib; }
   
   
@@ -44,6 +44,7 @@ using namespace std;
 using namespace AvidaTools;
 
 tInstLib<cHardwareTransSMT::tMethod>* cHardwareTransSMT::s_inst_slib = cHardwareTransSMT::initInstLib();
+cFreeListPool* const cHardwareTransSMT::s_pool = new cFreeListPool("cHardwareTransSMT", sizeof(cHardwareTransSMT));
 
 tInstLib<cHardwareTransSMT::tMethod>* cHardwareTransSMT::initInstLib(void)
 {
@@ -1030,12 +1031,8 @@ inline int cHardwareTransSMT::FindComplementStack(int base_stack)
 
 int cHardwareTransSMT::calcCopiedSize(const int, const int)
 {
-  int copied_size = 0;
   const cCPUMemory& memory = m_mem_array[m_cur_child];
-  for (int i = 0; i < memory.GetSize(); i++) {
-    if (memory.FlagCopied(i)) copied_size++;
-	}
-  return copied_size;
+  return memory.CountFlagCopied(0, memory.GetSize());
 }
 
 void cHardwareTransSMT::Inject_DoMutations(cAvidaContext& ctx, double mut_multiplier, cCPUMemory& injected_code)
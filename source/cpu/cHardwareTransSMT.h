@@ -29,8 +29,10 @@
 #include "cContextPhenotype.h"
 #include "cCPUMemory.h"
 #include "cCPUStack.h"
+#include "cFreeListPool.h"
 #include "cHeadCPU.h"
 #include "cHardwareBase.h"
+#include "cLabelIdMap.h"
 #include "cString.h"
 #include "tInstLib.h"
 
@@ -50,10 +52,6 @@ protected:
   static const int MAX_THREAD_LABEL = 3;
 
   enum tStacks { STACK_AX = 0, STACK_BX, STACK_CX, STACK_DX };
-  
-  // --------  Performance Constants --------
-  static const int MEM_LBLS_HASH_FACTOR = 4; // Sets hast table size to (NUM_NOPS^MAX_MEMSPACE_LABEL) / FACTOR
-  static const int THREAD_LBLS_HASH_FACTOR = 4; // Sets hast table size to (NUM_NOPS^MAX_THREAD_LABEL) / FACTOR
 
   // --------  Data Structures  --------
   class cLocalThread
@@ -82,6 +80,7 @@ protected:
   
   // --------  Static Variables  --------
   static tInstLib<cHardwareTransSMT::tMethod>* s_inst_slib;
+  static cFreeListPool* const s_pool;
   static tInstLib<cHardwareTransSMT::tMethod>* initInstLib(void);
     
 
@@ -93,11 +92,11 @@ protected:
 	
   // Memory
   Apto::Array<cCPUMemory, Apto::ManagedPointer> m_mem_array;
-  Apto::Map<int, int> m_mem_lbls;
+  cLabelIdMap m_mem_lbls;
 
   // Threads
   Apto::Array<cLocalThread, Apto::ManagedPointer> m_threads;
-  Apto::Map<int, int> m_thread_lbls;
+  cLabelIdMap m_thread_lbls;
   int m_cur_thread;
   int m_cur_child;
 
@@ -180,6 +179,10 @@ protected:
 public:
   cHardwareTransSMT(cAvidaContext& ctx, cWorld* world, cOrganism* in_organism, cInstSet* in_inst_set);
   ~cHardwareTransSMT() { ; }
+  
+  // Hardware storage is recycled through a free list rather than returned to the system allocator
+  static void* operator new(size_t size) { return s_pool->Allocate(size); }
+  static void operator delete(void* ptr, size_t size) { s_pool->Release(ptr, size); }
 
   static cInstLib* GetInstLib() { return s_inst_slib; }
   static cString GetDefaultInstFilename() { return "instset-transsmt.cfg"; }
@@ -43,6 +43,8 @@ cInstSet::cInstSet(const cInstSet& _in)
   , m_hw_type(_in.m_hw_type)
   , m_inst_lib(_in.m_inst_lib)
   , m_lib_name_map(_in.m_lib_name_map)
+  , m_lib_nopmod_map(_in.m_lib_nopmod_map)
+  , m_nop_mods(_in.m_nop_mods)
   , m_mutation_index(NULL)
   , m_has_costs(_in.m_has_costs)
   , m_has_ft_costs(_in.m_has_ft_costs)
@@ -64,6 +66,8 @@ cInstSet& cInstSet::operator=(const cInstSet& _in)
   m_hw_type = _in.m_hw_type;
   m_inst_lib = _in.m_inst_lib;
   m_lib_name_map = _in.m_lib_name_map;
+  m_lib_nopmod_map = _in.m_lib_nopmod_map;
+  m_nop_mods = _in.m_nop_mods;
   m_mutation_index = NULL;
   m_has_costs = _in.m_has_costs;
   m_has_ft_costs = _in.m_has_ft_costs;
@@ -292,6 +296,7 @@ bool cInstSet::LoadWithStringList(const cStringList& sl, cUserFeedback* feedback
 
       m_lib_nopmod_map.Resize(inst_id + 1);
       m_lib_nopmod_map[inst_id] = fun_id;
+      m_nop_mods[inst_id] = m_inst_lib->GetNopMod(fun_id);
     }
     
     // Clean up the argument container for this instruction
@@ -76,6 +76,7 @@ public:
   Apto::Array<sInstEntry, Apto::Smart> m_lib_name_map;
   
   Apto::Array<int> m_lib_nopmod_map;
+  Apto::Array<int> m_nop_mods;  // decoded nop modifier of every opcode, including the error instruction, -1 if not a nop
   
   cOrderedWeightedIndex* m_mutation_index;     // Weighted index for instructions 
   
@@ -96,10 +97,10 @@ public:
 
 public:
   inline cInstSet(cWorld* world, const cString& name, int hw_type, cInstLib* inst_lib, int stack_size, int uops_per_cycle)
-    : m_world(world), m_name(name), m_hw_type(hw_type), m_inst_lib(inst_lib), m_mutation_index(NULL)
+    : m_world(world), m_name(name), m_hw_type(hw_type), m_inst_lib(inst_lib), m_nop_mods(MAX_INSTSET_SIZE + 1), m_mutation_index(NULL)
     , m_has_costs(false), m_has_ft_costs(false), m_has_energy_costs(false), m_has_res_costs(false), m_has_fem_res_costs(false)
     , m_has_female_costs(false), m_has_choosy_female_costs(false), m_has_post_costs(false), m_has_bonus_costs(false), m_stack_size(stack_size)
-    , m_uops_per_cycle(uops_per_cycle) { ; }
+    , m_uops_per_cycle(uops_per_cycle) { m_nop_mods.SetAll(-1); }
   cInstSet(const cInstSet&); 
   cInstSet& operator=(const cInstSet&); 
   inline ~cInstSet() { if (m_mutation_index != NULL) delete m_mutation_index; }
@@ -127,11 +128,10 @@ public:
   
   int GetLibFunctionIndex(const Instruction& inst) const { return m_lib_name_map[inst.GetOp()].lib_fun_id; }
 
-  int GetNopMod(const Instruction& inst) const
-  {
-    int nopmod = m_lib_nopmod_map[inst.GetOp()];
-    return m_inst_lib->GetNopMod(nopmod);
-  }
+  int GetNopMod(const Instruction& inst) const { assert(IsNop(inst)); return m_nop_mods[inst.GetOp()]; }
+  
+  // Nop modifier of inst, or -1 if inst is not a nop; a single lookup in place of IsNop followed by GetNopMod
+  int GetModifier(const Instruction& inst) const { return m_nop_mods[inst.GetOp()]; }
 
   Instruction GetRandomInst(cAvidaContext& ctx) const;
   int GetRandFunctionIndex(cAvidaContext& ctx) const { return m_lib_name_map[ GetRandomInst(ctx).GetOp() ].lib_fun_id; }
@@ -0,0 +1,119 @@
+/*
+ *  cLabelIdMap.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cLabelIdMap_h
+#define cLabelIdMap_h
+
+#include <cassert>
+#include <cstddef>
+
+
+// cLabelIdMap - map from label keys (see cCodeLabel::AsInt) to small integer ids, such as memory space or thread ids
+//
+// The map is an open-addressed hash table with linear probing, kept at most half full.  The first INLINE_SLOTS slots
+// live inside the object, so a map holding up to INLINE_SLOTS / 2 (8) labels never touches the heap.  Labels of up to
+// three nops can form as many as 64 distinct keys; a map that grows past 8 entries moves to a heap table, doubling as
+// needed (128 slots hold all 64).  Entries are never removed individually, only all at once by Clear, which keeps any
+// heap storage for reuse.
+class cLabelIdMap
+{
+private:
+  static const int INLINE_SLOTS = 16;   // must be a power of two
+
+  struct sSlot
+  {
+    int key;
+    int value;
+    bool used;
+  };
+
+  sSlot m_inline[INLINE_SLOTS];
+  sSlot* m_slots;
+  int m_capacity;                       // always a power of two
+  int m_size;
+
+  cLabelIdMap(const cLabelIdMap&); // @not_implemented
+  cLabelIdMap& operator=(const cLabelIdMap&); // @not_implemented
+
+public:
+  cLabelIdMap() : m_slots(m_inline), m_capacity(INLINE_SLOTS), m_size(0) { clearSlots(); }
+  ~cLabelIdMap() { if (m_slots != m_inline) delete [] m_slots; }
+
+  int GetSize() const { return m_size; }
+
+  void Clear() { m_size = 0; clearSlots(); }
+
+  // Returns true and sets value if key is present, otherwise leaves value untouched
+  bool Get(int key, int& value) const
+  {
+    for (int i = slotFor(key); m_slots[i].used; i = (i + 1) & (m_capacity - 1)) {
+      if (m_slots[i].key == key) {
+        value = m_slots[i].value;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void Set(int key, int value)
+  {
+    int i = slotFor(key);
+    for (; m_slots[i].used; i = (i + 1) & (m_capacity - 1)) {
+      if (m_slots[i].key == key) {
+        m_slots[i].value = value;
+        return;
+      }
+    }
+    if ((m_size + 1) * 2 > m_capacity) {
+      grow();
+      i = slotFor(key);
+      while (m_slots[i].used) i = (i + 1) & (m_capacity - 1);
+    }
+    m_slots[i].key = key;
+    m_slots[i].value = value;
+    m_slots[i].used = true;
+    m_size++;
+  }
+
+private:
+  inline int slotFor(int key) const { return static_cast<int>((static_cast<unsigned int>(key) * 2654435761u) & (m_capacity - 1)); }
+
+  void clearSlots() { for (int i = 0; i < m_capacity; i++) m_slots[i].used = false; }
+
+  void grow()
+  {
+    sSlot* old_slots = m_slots;
+    const int old_capacity = m_capacity;
+
+    m_capacity *= 2;
+    m_slots = new sSlot[m_capacity];
+    clearSlots();
+    for (int i = 0; i < old_capacity; i++) {
+      if (!old_slots[i].used) continue;
+      int j = slotFor(old_slots[i].key);
+      while (m_slots[j].used) j = (j + 1) & (m_capacity - 1);
+      m_slots[j] = old_slots[i];
+    }
+
+    if (old_slots != m_inline) delete [] old_slots;
+  }
+};
+
+#endif
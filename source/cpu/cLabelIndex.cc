@@ -0,0 +1,134 @@
+/*
+ *  cLabelIndex.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cLabelIndex.h"
+
+#include "cCPUMemory.h"
+#include "cInstSet.h"
+
+#include <cassert>
+
+
+// Index of the first site >= value
+static int lowerBound(const Apto::Array<int, Apto::Smart>& sites, int value)
+{
+  int lo = 0;
+  int hi = sites.GetSize();
+  while (lo < hi) {
+    const int mid = (lo + hi) / 2;
+    if (sites[mid] < value) lo = mid + 1;
+    else hi = mid;
+  }
+  return lo;
+}
+
+
+bool cLabelIndex::FindForward(const cInstSet& inst_set, const cCPUMemory& memory, const cCodeLabel& label, int pos,
+                              int& found_pos)
+{
+  assert(pos >= 0 && pos < memory.GetSize());
+  if (label.GetSize() == 0 || !prepare(inst_set, memory)) return false;
+
+  const Apto::Array<int, Apto::Smart>& sites = labelSites(label);
+  const int label_size = label.GetSize();
+
+  // The linear search never looks before pos, and only examines runs of nops that extend past pos + label_size.  The
+  // one occurrence at or after pos that can sit in a run ending at or before that point is an exact fit at pos.
+  int idx = lowerBound(sites, pos);
+  if (idx < sites.GetSize() && sites[idx] == pos && m_run_end[pos] == pos + label_size) idx++;
+
+  found_pos = (idx < sites.GetSize()) ? sites[idx] + label_size : -1;
+  return true;
+}
+
+
+bool cLabelIndex::FindBackward(const cInstSet& inst_set, const cCPUMemory& memory, const cCodeLabel& label, int pos,
+                               int& found_pos)
+{
+  assert(pos < memory.GetSize());
+  if (label.GetSize() == 0 || !prepare(inst_set, memory)) return false;
+
+  const Apto::Array<int, Apto::Smart>& sites = labelSites(label);
+  const int label_size = label.GetSize();
+
+  // The linear search takes the last run holding an occurrence that ends at or before pos, and returns the end of that
+  // run, cut off at pos.
+  const int idx = lowerBound(sites, pos - label_size + 1) - 1;
+  if (idx < 0) found_pos = -1;
+  else found_pos = (m_run_end[sites[idx]] < pos) ? m_run_end[sites[idx]] : pos;
+  return true;
+}
+
+
+bool cLabelIndex::prepare(const cInstSet& inst_set, const cCPUMemory& memory)
+{
+  if (m_memory != &memory || m_revision != memory.GetRevision()) {
+    m_memory = &memory;
+    m_revision = memory.GetRevision();
+    m_num_searches = 0;
+    m_built = false;
+    m_labels.Resize(0);
+  }
+  if (m_built) return true;
+  if (++m_num_searches < SEARCHES_BEFORE_BUILD) return false;
+
+  const int size = memory.GetSize();
+  m_nop_mod.Resize(size);
+  m_run_end.Resize(size);
+  for (int i = 0; i < size; i++) m_nop_mod[i] = inst_set.IsNop(memory[i]) ? inst_set.GetNopMod(memory[i]) : -1;
+
+  int run_end = size;
+  for (int i = size - 1; i >= 0; i--) {
+    if (m_nop_mod[i] < 0) run_end = i;
+    m_run_end[i] = run_end;
+  }
+
+  m_built = true;
+  return true;
+}
+
+
+const Apto::Array<int, Apto::Smart>& cLabelIndex::labelSites(const cCodeLabel& label)
+{
+  for (int i = 0; i < m_labels.GetSize(); i++) if (m_labels[i].label == label) return m_labels[i].sites;
+
+  m_labels.Resize(m_labels.GetSize() + 1);
+  sLabelSites& entry = m_labels[m_labels.GetSize() - 1];
+  entry.label = label;
+  entry.sites.Resize(0);
+
+  const int label_size = label.GetSize();
+  const int size = m_nop_mod.GetSize();
+  for (int start = 0; start + label_size <= size; start++) {
+    if (m_nop_mod[start] < 0) continue;
+
+    // Skip the rest of any run too short to hold the label
+    if (m_run_end[start] - start < label_size) {
+      start = m_run_end[start];
+      continue;
+    }
+
+    int matches = 0;
+    while (matches < label_size && m_nop_mod[start + matches] == label[matches]) matches++;
+    if (matches == label_size) entry.sites.Push(start);
+  }
+
+  return entry.sites;
+}
@@ -0,0 +1,77 @@
+/*
+ *  cLabelIndex.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cLabelIndex_h
+#define cLabelIndex_h
+
+#include "apto/core.h"
+
+#include "cCodeLabel.h"
+
+class cCPUMemory;
+class cInstSet;
+
+
+// cLabelIndex - index of the labels (runs of nops) in a memory, for template matching
+//
+// The index records the nop modifier of every site, the extent of each run of nops, and, on demand, the sorted start
+// positions of every occurrence of a searched label.  Forward and backward searches then reduce to a binary search
+// over those positions, returning exactly what cHardwareCPU's linear FindLabel_Forward/Backward scans return,
+// including matches nested inside longer labels.
+//
+// The index is tied to one revision of one memory (see cCPUMemory::GetRevision).  It is only built once the same
+// revision has been searched more than once; until then the Find methods return false and the caller should scan
+// linearly, so code that writes to memory between every search (e.g. copy loops) never pays for building it.
+class cLabelIndex
+{
+private:
+  static const int SEARCHES_BEFORE_BUILD = 2;
+
+  struct sLabelSites
+  {
+    cCodeLabel label;
+    Apto::Array<int, Apto::Smart> sites;  // start position of every occurrence, ascending
+  };
+
+  const cCPUMemory* m_memory;
+  unsigned int m_revision;
+  int m_num_searches;                       // searches of this revision made before the index was built
+  bool m_built;
+  Apto::Array<int, Apto::Smart> m_nop_mod;  // nop modifier of each site, -1 for any other instruction
+  Apto::Array<int, Apto::Smart> m_run_end;  // for nop sites, one past the last site of the enclosing run of nops
+  Apto::Array<sLabelSites> m_labels;
+
+  cLabelIndex(const cLabelIndex&); // @not_implemented
+  cLabelIndex& operator=(const cLabelIndex&); // @not_implemented
+
+public:
+  cLabelIndex() : m_memory(NULL), m_revision(0), m_num_searches(0), m_built(false) { ; }
+
+  // Each returns false if no index is available for the memory's current revision, otherwise sets found_pos to the
+  // result of the equivalent cHardwareCPU::FindLabel_Forward/Backward call (-1 if the label is not found)
+  bool FindForward(const cInstSet& inst_set, const cCPUMemory& memory, const cCodeLabel& label, int pos, int& found_pos);
+  bool FindBackward(const cInstSet& inst_set, const cCPUMemory& memory, const cCodeLabel& label, int pos, int& found_pos);
+
+private:
+  bool prepare(const cInstSet& inst_set, const cCPUMemory& memory);
+  const Apto::Array<int, Apto::Smart>& labelSites(const cCodeLabel& label);
+};
+
+#endif
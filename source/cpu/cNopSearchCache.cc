@@ -0,0 +1,133 @@
+/*
+ *  cNopSearchCache.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cNopSearchCache.h"
+
+#include "cCPUMemory.h"
+#include "cInstSet.h"
+
+#include <cassert>
+
+
+const cNopSearchCache::sResult& cNopSearchCache::Find(const cInstSet& inst_set, const cCPUMemory& memory,
+                                                      eSearchType type, const cCodeLabel& label, int start)
+{
+  assert(label.GetSize() > 0);
+  if (type == LABEL_START || type == NOP_SEQUENCE_START) start = 0;
+
+  unsigned int hash = static_cast<unsigned int>(type) * 31 + static_cast<unsigned int>(start);
+  for (int i = 0; i < label.GetSize(); i++) hash = hash * 7 + static_cast<unsigned int>(label[i]);
+  sEntry& entry = m_entries[hash & (NUM_ENTRIES - 1)];
+
+  if (entry.memory == &memory && entry.revision == memory.GetRevision() && entry.type == type &&
+      entry.start == start && entry.label == label) {
+    return entry.result;
+  }
+
+  scan(inst_set, memory, type, label, start, entry.result);
+  entry.memory = &memory;
+  entry.revision = memory.GetRevision();
+  entry.type = type;
+  entry.start = start;
+  entry.label = label;
+  return entry.result;
+}
+
+
+void cNopSearchCache::MarkExecuted(cCPUMemory& memory, const sResult& result, int max_size)
+{
+  assert(result.found_pos >= 0);
+  const int size = memory.GetSize();
+  for (int i = 0; i < result.mark_size && i < max_size; i++) memory.SetFlagExecuted((result.mark_start + i) % size);
+}
+
+
+// The scans below reproduce the hardware's original head based loops exactly, including their handling of the
+// starting position and of matches that run into the end of memory, so cached and uncached searches agree.
+void cNopSearchCache::scan(const cInstSet& inst_set, const cCPUMemory& memory, eSearchType type,
+                           const cCodeLabel& label, int start, sResult& result)
+{
+  const int size = memory.GetSize();
+  const int label_size = label.GetSize();
+  const bool is_label = (type == LABEL_START || type == LABEL_FORWARD);
+
+  result.found_pos = -1;
+  result.mark_start = 0;
+  result.mark_size = 0;
+
+  if (type == LABEL_START || type == NOP_SEQUENCE_START) {
+    int pos = 0;
+    while (pos < size) {
+      if (is_label ? inst_set.IsLabel(memory[pos]) : inst_set.IsNop(memory[pos])) {
+        if (is_label) pos++;
+
+        // Must match all nops in label, extra nops in memory are ignored
+        int size_matched = 0;
+        while (size_matched < label_size && pos < size) {
+          if (!inst_set.IsNop(memory[pos]) || label[size_matched] != inst_set.GetNopMod(memory[pos])) break;
+          size_matched++;
+          pos++;
+        }
+
+        if (size_matched == label_size) {
+          result.found_pos = pos - 1;
+          result.mark_size = (is_label) ? label_size + 1 : label_size;  // labels also flag the label instruction
+          result.mark_start = pos - result.mark_size;
+          return;
+        }
+
+        if (is_label) continue;
+      }
+      pos++;
+    }
+    return;
+  }
+
+  if (size == 0) return;
+  assert(start >= 0 && start < size);
+
+  // Positions advance like a head, wrapping at the end of memory, and the scan stops on returning to start
+  int pos = (start + 1 < size) ? start + 1 : 0;
+  while (pos != start) {
+    if (is_label ? inst_set.IsLabel(memory[pos]) : inst_set.IsNop(memory[pos])) {
+      const int label_start = pos;
+      if (is_label) pos = (pos + 1 < size) ? pos + 1 : 0;
+
+      int size_matched = 0;
+      while (size_matched < label_size && pos != start) {
+        if (!inst_set.IsNop(memory[pos]) || label[size_matched] != inst_set.GetNopMod(memory[pos])) break;
+        size_matched++;
+        pos = (pos + 1 < size) ? pos + 1 : 0;
+      }
+
+      if (size_matched == label_size) {
+        // Stepping a head back from position 0 leaves it at 0
+        result.found_pos = (pos > 0) ? pos - 1 : 0;
+        result.mark_start = label_start;
+        result.mark_size = size_matched;
+        return;
+      }
+
+      if (is_label) continue;
+      if (pos == start) break;
+    }
+    pos = (pos + 1 < size) ? pos + 1 : 0;
+  }
+}
@@ -0,0 +1,97 @@
+/*
+ *  cNopSearchCache.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cNopSearchCache_h
+#define cNopSearchCache_h
+
+#include "apto/core.h"
+
+#include "cCodeLabel.h"
+
+class cCPUMemory;
+class cInstSet;
+
+
+// cNopSearchCache - memo of recent label and nop sequence searches, shared by the head based hardware types
+//
+// cHardwareExperimental, cHardwareBCR and cHardwareGP8 all search memory for a label (a label instruction followed by
+// a run of nops) or a bare nop sequence, either from the start of memory or forward from a head.  Find runs the one
+// shared scan for all of them and remembers its result, keyed by search type, starting position and label, for the
+// revision of the memory that was searched (see cCPUMemory::GetRevision).  Any write to that memory invalidates the
+// result, so a loop that repeatedly jumps to the same label only scans memory once per revision.
+//
+// Entries also hold the memory's address, so the owning hardware must Clear the cache whenever a memory it searches
+// may have been destroyed or moved (e.g. when resizing its memory spaces).
+class cNopSearchCache
+{
+public:
+  enum eSearchType {
+    LABEL_START = 0,        // label instruction followed by the nops, scanning from the start of memory
+    LABEL_FORWARD,          // label instruction followed by the nops, scanning forward from a position
+    NOP_SEQUENCE_START,     // bare run of nops, scanning from the start of memory
+    NOP_SEQUENCE_FORWARD    // bare run of nops, scanning forward from a position
+  };
+
+  struct sResult
+  {
+    int found_pos;    // last nop of the matched sequence, -1 if not found
+    int mark_start;   // first site the original search flags as executed when asked to
+    int mark_size;    // number of sites, wrapping around memory, before the MAX_LABEL_EXE_SIZE limit is applied
+  };
+
+private:
+  static const int NUM_ENTRIES = 16;  // direct mapped, must be a power of two
+
+  struct sEntry
+  {
+    const cCPUMemory* memory;
+    unsigned int revision;
+    eSearchType type;
+    int start;
+    cCodeLabel label;
+    sResult result;
+
+    sEntry() : memory(NULL), revision(0), type(LABEL_START), start(0) { ; }
+  };
+
+  sEntry m_entries[NUM_ENTRIES];
+
+  cNopSearchCache(const cNopSearchCache&); // @not_implemented
+  cNopSearchCache& operator=(const cNopSearchCache&); // @not_implemented
+
+public:
+  cNopSearchCache() { ; }
+
+  void Clear() { for (int i = 0; i < NUM_ENTRIES; i++) m_entries[i].memory = NULL; }
+
+  // Returns the result of searching memory for label, starting at start for the forward search types (ignored by the
+  // others).  The label must not be empty.
+  const sResult& Find(const cInstSet& inst_set, const cCPUMemory& memory, eSearchType type, const cCodeLabel& label,
+                      int start);
+
+  // Flags the sites of a successful search as executed, stopping after max_size sites
+  static void MarkExecuted(cCPUMemory& memory, const sResult& result, int max_size);
+
+private:
+  static void scan(const cInstSet& inst_set, const cCPUMemory& memory, eSearchType type, const cCodeLabel& label,
+                   int start, sResult& result);
+};
+
+#endif
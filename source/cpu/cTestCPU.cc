@@ -25,11 +25,13 @@
 #include "avida/output/File.h"
 
 #include "cAvidaContext.h"
+#include "cCPUMemory.h"
 #include "cCPUTestInfo.h"
 #include "cEnvironment.h"
 #include "cHardwareBase.h"
 #include "cHardwareManager.h"
 #include "cHardwareTracer.h"
+#include "cHeadCPU.h"
 #include "cInstSet.h"
 #include "cOrganism.h"
 #include "cPhenotype.h"
@@ -37,6 +39,7 @@
 #include "cResourceCount.h"
 #include "cResourceHistory.h"
 #include "cResourceLib.h"
+#include "cStats.h"
 #include "cStringUtil.h"
 #include "cTestCPUInterface.h"
 #include "cWorld.h"
@@ -157,6 +160,15 @@ bool cTestCPU::ProcessGestation(cAvidaContext& ctx, cCPUTestInfo& test_info, int
   // This way of keeping track of time is only used to update resources...
   int time_used = m_res_cpu_cycle_offset; // Note: the offset is zero by default if no resources being used @JEB
   
+  // Early stopping compares the hardware state after every cycle against a snapshot retaken at cycles that are
+  // powers of two (Brent's cycle detection), so a loop is caught within about twice its length plus its start.
+  // Depletable resources change between cycles outside of the hardware, so those runs are never stopped early.
+  const bool early_stop = m_world->GetConfig().TEST_CPU_EARLY_STOP.Get() && m_res_method < RES_UPDATED_DEPLETABLE &&
+                          !test_info.GetTracer();
+  int num_cycles = 0;
+  int next_snapshot = 1;
+  m_saved_state.Resize(0);
+  
   organism.GetHardware().SetTrace(test_info.GetTracer());
   while (time_used < time_allocated && organism.GetPhenotype().GetNumDivides() == 0 && !organism.IsDead())
   {
@@ -168,6 +180,20 @@ bool cTestCPU::ProcessGestation(cAvidaContext& ctx, cCPUTestInfo& test_info, int
     UpdateResources(ctx, time_used);
     
     organism.GetHardware().SingleProcess(ctx);
+    
+    if (early_stop && organism.GetPhenotype().GetNumDivides() == 0 && CaptureState(organism.GetHardware(), m_cur_state)) {
+      num_cycles++;
+      if (SameState(m_cur_state, m_saved_state)) {
+        // Back in a state already seen, so this organism will only repeat itself until time runs out
+        test_info.cycles_saved += time_allocated - time_used;
+        m_world->GetStats().AddTestCPUCyclesSaved(time_allocated - time_used);
+        break;
+      }
+      if (num_cycles == next_snapshot) {
+        m_saved_state = m_cur_state;
+        next_snapshot *= 2;
+      }
+    }
   }
   
   organism.GetHardware().SetTrace(HardwareTracerPtr(NULL));
@@ -223,6 +249,24 @@ bool cTestCPU::TestGenome(cAvidaContext& ctx, cCPUTestInfo& test_info, const Gen
   return test_info.is_viable;
 }
 
+// The test CPU's own input and receive positions, followed by the hardware's complete execution state.  Returns false
+// when the hardware cannot capture its state, so the organism is never stopped early.
+bool cTestCPU::CaptureState(const cHardwareBase& hardware, Apto::Array<int>& state) const
+{
+  state.Resize(0);
+  state.Push(cur_input);
+  state.Push(cur_receive);
+  return hardware.CaptureExecutionState(state);
+}
+
+bool cTestCPU::SameState(const Apto::Array<int>& state1, const Apto::Array<int>& state2)
+{
+  if (state1.GetSize() != state2.GetSize()) return false;
+  for (int i = 0; i < state1.GetSize(); i++) if (state1[i] != state2[i]) return false;
+  return true;
+}
+
+
 bool cTestCPU::TestGenome_Body(cAvidaContext& ctx, cCPUTestInfo& test_info, const Genome& genome, int cur_depth)
 {
   assert(cur_depth < test_info.generation_tests);
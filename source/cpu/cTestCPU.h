@@ -33,6 +33,7 @@
 
 class cAvidaContext;
 class cBioGroup;
+class cHardwareBase;
 class cInstSet;
 class cResourceCount;
 class cResourceHistory;
@@ -66,10 +67,16 @@ private:
   cResourceCount m_faced_cell_resource_count;
   cResourceCount m_deme_resource_count;
   cResourceCount m_cell_resource_count;
+  
+  // Hardware state snapshots used to catch organisms stuck in a loop (see TEST_CPU_EARLY_STOP)
+  Apto::Array<int> m_saved_state;
+  Apto::Array<int> m_cur_state;
     
 
   bool ProcessGestation(cAvidaContext& ctx, cCPUTestInfo& test_info, int cur_depth);
   bool TestGenome_Body(cAvidaContext& ctx, cCPUTestInfo& test_info, const Genome& genome, int cur_depth);
+  bool CaptureState(const cHardwareBase& hardware, Apto::Array<int>& state) const;
+  static bool SameState(const Apto::Array<int>& state1, const Apto::Array<int>& state2);
 
   
   cTestCPU(); // @not_implemented
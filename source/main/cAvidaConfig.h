@@ -514,6 +514,7 @@ public:
   CONFIG_ADD_VAR(DEMES_TRACK_SHANNON_INFO, int, 0, "Enable shannon mutual information tracking for demes.");
   CONFIG_ADD_VAR(DEMES_MUT_ORGS_ON_REPLICATION, int, 0, "Mutate orgs using germline mutation rates when they are copied to a new deme (using DEMES_SEED_METHOD 1): 0=OFF, 1=ON");
   CONFIG_ADD_VAR(DEMES_ORGS_START_IN_GERM, int, 0, "Are orgs considered part of the germline at start?");
+  CONFIG_ADD_VAR(DEMES_ORGANISM_ARENAS, int, 0, "Allocate organisms and their hardware from per-deme memory arenas,\nkeeping each deme's organisms together in memory? 0=OFF, 1=ON");
   
   
   // -------- Reversion config options --------
@@ -588,6 +589,7 @@ public:
   CONFIG_ADD_GROUP(GENEOLOGY_GROUP, "Geneology");
   CONFIG_ADD_VAR(THRESHOLD, int, 3, "Number of organisms in a genotype needed for it\n  to be considered viable.");
   CONFIG_ADD_VAR(TEST_CPU_TIME_MOD, int, 20, "Time allocated in test CPUs (multiple of length)");
+  CONFIG_ADD_VAR(TEST_CPU_EARLY_STOP, int, 0, "Stop test CPU runs early once the organism returns to an earlier\n  hardware state, so it can never divide.  Applies only to the\n  original CPU with the default heads instructions and no costs.");
   
 
   // -------- Organism Network config options --------
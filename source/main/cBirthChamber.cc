@@ -44,6 +44,8 @@ cBirthChamber::~cBirthChamber()
 
 cBirthSelectionHandler* cBirthChamber::getSelectionHandler(int hw_type)
 {
+  Apto::MutexAutoLock lock(m_handler_mutex);
+  
   cBirthSelectionHandler* handler = NULL;
   if (!m_handler_map.Get(hw_type, handler)) {
     const int birth_method = m_world->GetConfig().BIRTH_METHOD.Get();
@@ -86,6 +88,22 @@ cBirthSelectionHandler* cBirthChamber::getSelectionHandler(int hw_type)
   return handler;
 }
 
+bool cBirthChamber::claimMate(cAvidaContext& ctx, const Genome& offspring, cOrganism* parent, cBirthEntry& mate)
+{
+  // Only selection itself happens under the shard's lock.  The chosen entry is copied out and its slot released before
+  // the lock is dropped, so recombination and offspring construction run unlocked on the private copy, and a waiting
+  // entry can never be handed to two submitters.
+  cBirthSelectionHandler* shard = getSelectionHandler(offspring.HardwareType())->GetShard(parent);
+  Apto::MutexAutoLock lock(shard->GetMutex());
+  
+  cBirthEntry* waiting = shard->SelectOffspring(ctx, offspring, parent);
+  if (waiting == NULL) return false;
+  
+  mate = *waiting;
+  ClearEntry(*waiting);
+  return true;
+}
+
 bool cBirthChamber::ValidBirthEntry(const cBirthEntry& entry) const
 {
   // If there is no organism in the entry, return false.
@@ -453,33 +471,33 @@ bool cBirthChamber::SubmitOffspring(cAvidaContext& ctx, const Genome& offspring,
   // organism (which is the same as sexual with 0 recombination points)
   
   // Find a waiting entry (locally or globally)
-  cBirthEntry* old_entry = getSelectionHandler(offspring.HardwareType())->SelectOffspring(ctx, offspring, parent);
+  cBirthEntry old_entry;
 
   // If we couldn't find a waiting entry, this one was saved -- stop here!
-  if (old_entry == NULL) return false;
+  if (!claimMate(ctx, offspring, parent, old_entry)) return false;
 
   // If we've made it this far, it means we've selected a mate from the birth chamber, so let's record its statistics
   // Set up a temporary dummy birth entry so we can record information about the "chooser"
   cBirthEntry temp_entry(offspring, parent, m_world->GetStats().GetUpdate());
-  m_world->GetStats().RecordSuccessfulMate(*old_entry, temp_entry); 
+  m_world->GetStats().RecordSuccessfulMate(old_entry, temp_entry); 
 
   // If we are NOT recombining, handle that here.
   if (parent_phenotype.CrossNum() == 0 || ctx.GetRandom().GetDouble() > m_world->GetConfig().RECOMBINATION_PROB.Get()) {
-    bool ret = DoPairAsexBirth(ctx, *old_entry, offspring, *parent, child_array, merit_array);
-    ClearEntry(*old_entry);
+    bool ret = DoPairAsexBirth(ctx, old_entry, offspring, *parent, child_array, merit_array);
+    ClearEntry(old_entry);
     return ret;
   }
   // If we made it this far, RECOMBINATION will happen!
-  Genome genome0(old_entry->genome);
+  Genome genome0(old_entry.genome);
   Genome genome1(offspring);
   double meritOrEnergy0;
   double meritOrEnergy1;
 
   if(m_world->GetConfig().ENERGY_ENABLED.Get() == 1) {
-    meritOrEnergy0 = old_entry->energy4Offspring;
+    meritOrEnergy0 = old_entry.energy4Offspring;
     meritOrEnergy1 = parent_phenotype.ExtractParentEnergy();
   } else {
-    meritOrEnergy0 = old_entry->merit.GetDouble();
+    meritOrEnergy0 = old_entry.merit.GetDouble();
     meritOrEnergy1 = parent_phenotype.GetMerit().GetDouble();
   }
 
@@ -526,7 +544,7 @@ bool cBirthChamber::SubmitOffspring(cAvidaContext& ctx, const Genome& offspring,
 
   const int two_fold_cost = m_world->GetConfig().TWO_FOLD_COST_SEX.Get();
 
-  Systematics::ConstGroupMembershipPtr parent0_groups = old_entry->groups;
+  Systematics::ConstGroupMembershipPtr parent0_groups = old_entry.groups;
   Systematics::ConstGroupMembershipPtr parent1_groups = parent->SystematicsGroupMembership();
   
   if (two_fold_cost == 0) {	// Build the two organisms.
@@ -578,7 +596,7 @@ bool cBirthChamber::SubmitOffspring(cAvidaContext& ctx, const Genome& offspring,
     }
   } 
 
-  ClearEntry(*old_entry);
+  ClearEntry(old_entry);
   return true;
 }
 
@@ -586,6 +604,7 @@ int cBirthChamber::GetWaitingOffspringNumber(int which_mating_type, int hw_type)
 {
   //Get handler
   cBirthSelectionHandler* temp_handler = getSelectionHandler(hw_type);
+  Apto::MutexAutoLock lock(temp_handler->GetMutex());
   //Get offspring number
   int waiting_num = temp_handler->GetWaitingOffspringNumber(which_mating_type);
   return waiting_num;
@@ -594,5 +613,6 @@ int cBirthChamber::GetWaitingOffspringNumber(int which_mating_type, int hw_type)
 void cBirthChamber::PrintBirthChamber(const cString& filename, int hw_type)
 {
   cBirthSelectionHandler* temp_handler = getSelectionHandler(hw_type);
+  Apto::MutexAutoLock lock(temp_handler->GetMutex());
   temp_handler->PrintBirthChamber(filename);
 }
@@ -25,6 +25,8 @@
 
 #include "avida/systematics/Group.h"
 
+#include "apto/core/Mutex.h"
+
 #include "cBirthEntry.h"
 
 /**
@@ -48,6 +50,7 @@ class cBirthChamber
 private:
   cWorld* m_world;
   Apto::Map<int, cBirthSelectionHandler*> m_handler_map;
+  Apto::Mutex m_handler_mutex;
 
 
   cBirthChamber(); // @not_implemented
@@ -74,6 +77,7 @@ public:
 
 private:
   cBirthSelectionHandler* getSelectionHandler(int hw_type);
+  bool claimMate(cAvidaContext& ctx, const Genome& offspring, cOrganism* parent, cBirthEntry& mate);
   
   bool RegionSwap(InstructionSequence& genome0, InstructionSequence& genome1, int start0, int end0, int start1, int end1);
   void GenomeSwap(InstructionSequence& genome0, InstructionSequence& genome1, double& merit0, double& merit1);
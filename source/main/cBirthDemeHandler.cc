@@ -57,6 +57,11 @@ cBirthDemeHandler::cBirthDemeHandler(cWorld* world, cBirthChamber* bc)
   }
 }
 
+cBirthSelectionHandler* cBirthDemeHandler::GetShard(cOrganism* parent)
+{
+  return m_deme_handlers[parent->GetDemeID()]->GetShard(parent);
+}
+
 cBirthEntry* cBirthDemeHandler::SelectOffspring(cAvidaContext& ctx, const Genome& offspring, cOrganism* parent)
 {
   return m_deme_handlers[parent->GetDemeID()]->SelectOffspring(ctx, offspring, parent);
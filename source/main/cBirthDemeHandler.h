@@ -39,6 +39,7 @@ private:
 public:
   cBirthDemeHandler(cWorld* world, cBirthChamber* bc);
   
+  cBirthSelectionHandler* GetShard(cOrganism* parent);
   cBirthEntry* SelectOffspring(cAvidaContext& ctx, const Genome& offspring, cOrganism* parent);
 };
 
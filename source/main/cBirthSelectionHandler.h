@@ -22,6 +22,8 @@
 #ifndef cBirthSelectionHandler_h
 #define cBirthSelectionHandler_h
 
+#include "apto/core/Mutex.h"
+
 namespace Avida {
   class Genome;
 };
@@ -39,10 +41,19 @@ using namespace Avida;
 
 class cBirthSelectionHandler
 {
+private:
+  Apto::Mutex m_mutex;
+  
 public:
   cBirthSelectionHandler() { ; }
   virtual ~cBirthSelectionHandler() = 0;
   
+  // Waiting entries may only be selected (and the selected entry copied out) while holding the shard's mutex.  Handlers
+  // that partition their entries into independent sub-handlers return the one responsible for the parent, so that
+  // unrelated births do not contend for the same lock.
+  virtual cBirthSelectionHandler* GetShard(cOrganism*) { return this; }
+  Apto::Mutex& GetMutex() { return m_mutex; }
+  
   virtual cBirthEntry* SelectOffspring(cAvidaContext& ctx, const Genome& offspring, cOrganism* parent) = 0;
   
   virtual int GetWaitingOffspringNumber(int which_mating_type);
@@ -0,0 +1,112 @@
+/*
+ *  cCellQueue.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cCellQueue_h
+#define cCellQueue_h
+
+#include "apto/core.h"
+
+#include <cassert>
+
+
+// cCellQueue - ordered queue of cell ids with constant time removal of arbitrary cells
+//
+// The queue is a doubly linked list threaded through two arrays indexed by cell id, so each cell may appear at most
+// once.  Pushing a cell that is already queued moves it to the new position.
+class cCellQueue
+{
+private:
+  static const int NONE = -1;
+  static const int UNLINKED = -2;
+
+  Apto::Array<int, Apto::Smart> m_prev;   // UNLINKED for cells that are not in the queue
+  Apto::Array<int, Apto::Smart> m_next;
+  int m_front;
+  int m_rear;
+  int m_size;
+
+  cCellQueue(const cCellQueue&); // @not_implemented
+  cCellQueue& operator=(const cCellQueue&); // @not_implemented
+
+public:
+  cCellQueue() : m_front(NONE), m_rear(NONE), m_size(0) { ; }
+
+  // Empties the queue and sizes it to hold the cell ids 0 through num_cells - 1
+  void ResizeClear(int num_cells)
+  {
+    m_prev.ResizeClear(num_cells);
+    m_next.ResizeClear(num_cells);
+    for (int i = 0; i < num_cells; i++) m_prev[i] = UNLINKED;
+    m_front = m_rear = NONE;
+    m_size = 0;
+  }
+  void Clear() { ResizeClear(m_prev.GetSize()); }
+
+  int GetSize() const { return m_size; }
+  bool Contains(int cell_id) const { return m_prev[cell_id] != UNLINKED; }
+
+  void Push(int cell_id)
+  {
+    Remove(cell_id);
+    m_prev[cell_id] = NONE;
+    m_next[cell_id] = m_front;
+    if (m_front != NONE) m_prev[m_front] = cell_id;
+    else m_rear = cell_id;
+    m_front = cell_id;
+    m_size++;
+  }
+
+  void PushRear(int cell_id)
+  {
+    Remove(cell_id);
+    m_prev[cell_id] = m_rear;
+    m_next[cell_id] = NONE;
+    if (m_rear != NONE) m_next[m_rear] = cell_id;
+    else m_front = cell_id;
+    m_rear = cell_id;
+    m_size++;
+  }
+
+  // Returns the cell id removed from the rear of the queue, or -1 if the queue is empty
+  int PopRear()
+  {
+    const int cell_id = m_rear;
+    if (cell_id != NONE) Remove(cell_id);
+    return cell_id;
+  }
+
+  void Remove(int cell_id)
+  {
+    if (m_prev[cell_id] == UNLINKED) return;
+
+    const int prev = m_prev[cell_id];
+    const int next = m_next[cell_id];
+    if (prev != NONE) m_next[prev] = next;
+    else m_front = next;
+    if (next != NONE) m_prev[next] = prev;
+    else m_rear = prev;
+
+    m_prev[cell_id] = UNLINKED;
+    m_size--;
+    assert(m_size >= 0);
+  }
+};
+
+#endif
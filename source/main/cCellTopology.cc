@@ -0,0 +1,125 @@
+/*
+ *  cCellTopology.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cCellTopology.h"
+
+#include "cPopulationCell.h"
+
+#include <cassert>
+
+
+int cCellTopology::cBuilder::GetSize(const cPopulationCell& cell) const
+{
+  return m_links[cell.GetID()].GetSize();
+}
+
+bool cCellTopology::cBuilder::Contains(const cPopulationCell& cell, const cPopulationCell& neighbor) const
+{
+  const Apto::Array<int, Apto::Smart>& links = m_links[cell.GetID()];
+  const int neighbor_id = neighbor.GetID();
+  for (int i = 0; i < links.GetSize(); i++) if (links[i] == neighbor_id) return true;
+  return false;
+}
+
+void cCellTopology::cBuilder::Push(const cPopulationCell& cell, const cPopulationCell& neighbor)
+{
+  m_links[cell.GetID()].Push(neighbor.GetID());
+}
+
+void cCellTopology::cBuilder::Remove(const cPopulationCell& cell, const cPopulationCell& neighbor)
+{
+  // Removes the front most occurrence, which is the last one in storage order
+  Apto::Array<int, Apto::Smart>& links = m_links[cell.GetID()];
+  const int neighbor_id = neighbor.GetID();
+  for (int i = links.GetSize() - 1; i >= 0; i--) {
+    if (links[i] == neighbor_id) {
+      for (int j = i + 1; j < links.GetSize(); j++) links[j - 1] = links[j];
+      links.Resize(links.GetSize() - 1);
+      return;
+    }
+  }
+}
+
+
+void cCellTopology::Build(const cBuilder& links, Apto::Array<cPopulationCell>& cells)
+{
+  assert(links.GetNumCells() == cells.GetSize());
+  const int num_cells = cells.GetSize();
+
+  m_offsets.ResizeClear(num_cells + 1);
+  int total = 0;
+  for (int i = 0; i < num_cells; i++) {
+    m_offsets[i] = total;
+    total += links.GetSize(i);
+  }
+  m_offsets[num_cells] = total;
+
+  m_neighbors.ResizeClear(total);
+  for (int i = 0; i < num_cells; i++) {
+    const int offset = m_offsets[i];
+    const int num_neighbors = links.GetSize(i);
+    for (int j = 0; j < num_neighbors; j++) m_neighbors[offset + j] = links.GetNeighborID(i, j);
+  }
+
+  m_cells = (num_cells) ? &cells[0] : NULL;
+  for (int i = 0; i < num_cells; i++) {
+    cells[i].m_topology = this;
+    cells[i].m_rotation = 0;
+  }
+}
+
+
+int cCellTopology::FindNeighbor(int cell_id, int neighbor_id, int start) const
+{
+  const int offset = m_offsets[cell_id];
+  const int num_neighbors = GetNumNeighbors(cell_id);
+  int pos = start;
+  for (int i = 0; i < num_neighbors; i++) {
+    if (pos >= num_neighbors) pos = 0;
+    if (m_neighbors[offset + pos] == neighbor_id) return pos;
+    pos++;
+  }
+  return -1;
+}
+
+
+void cCellTopology::InsertConnection(int cell_id, int pos, int neighbor_id)
+{
+  assert(pos >= 0 && pos <= GetNumNeighbors(cell_id));
+  const int insert_at = m_offsets[cell_id] + pos;
+
+  m_neighbors.Resize(m_neighbors.GetSize() + 1);
+  for (int i = m_neighbors.GetSize() - 1; i > insert_at; i--) m_neighbors[i] = m_neighbors[i - 1];
+  m_neighbors[insert_at] = neighbor_id;
+
+  for (int i = cell_id + 1; i < m_offsets.GetSize(); i++) m_offsets[i]++;
+}
+
+
+void cCellTopology::RemoveConnection(int cell_id, int pos)
+{
+  assert(pos >= 0 && pos < GetNumNeighbors(cell_id));
+  const int remove_at = m_offsets[cell_id] + pos;
+
+  for (int i = remove_at + 1; i < m_neighbors.GetSize(); i++) m_neighbors[i - 1] = m_neighbors[i];
+  m_neighbors.Resize(m_neighbors.GetSize() - 1);
+
+  for (int i = cell_id + 1; i < m_offsets.GetSize(); i++) m_offsets[i]--;
+}
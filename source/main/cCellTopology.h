@@ -0,0 +1,97 @@
+/*
+ *  cCellTopology.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cCellTopology_h
+#define cCellTopology_h
+
+#include "apto/core.h"
+
+class cPopulationCell;
+
+
+// cCellTopology - neighbor connections of all cells in the population, stored in compressed sparse row form
+//
+// The neighbors of cell i are m_neighbors[m_offsets[i]] through m_neighbors[m_offsets[i + 1] - 1], kept in the order
+// the topology builders produced them.  Facing is not stored here; each cell keeps the position of the neighbor it
+// currently faces within its row (see cPopulationCell::GetNeighbor).
+//
+// Connections are normally fixed once the cell grid has been set up.  Insert/RemoveConnection are provided for the
+// occasional topology-altering actions and are linear in the total number of connections.
+class cCellTopology
+{
+public:
+  // Adjacency lists used while the topology builders (cTopology.h) are running.  The operations mirror the tList
+  // operations the builders were written against; Push places the new neighbor at the front of the list.
+  class cBuilder
+  {
+  private:
+    // Lists are stored back to front, so that the front insertions performed by the builders are appends
+    Apto::Array<Apto::Array<int, Apto::Smart>, Apto::ManagedPointer> m_links;
+
+    cBuilder(); // @not_implemented
+    cBuilder(const cBuilder&); // @not_implemented
+    cBuilder& operator=(const cBuilder&); // @not_implemented
+
+  public:
+    cBuilder(int num_cells) : m_links(num_cells) { ; }
+
+    int GetNumCells() const { return m_links.GetSize(); }
+
+    int GetSize(const cPopulationCell& cell) const;
+    bool Contains(const cPopulationCell& cell, const cPopulationCell& neighbor) const;
+    void Push(const cPopulationCell& cell, const cPopulationCell& neighbor);
+    void Remove(const cPopulationCell& cell, const cPopulationCell& neighbor);
+
+    // Neighbor idx (counting from the front) of the given cell id
+    int GetNeighborID(int cell_id, int idx) const { return m_links[cell_id][m_links[cell_id].GetSize() - 1 - idx]; }
+    int GetSize(int cell_id) const { return m_links[cell_id].GetSize(); }
+  };
+
+
+private:
+  cPopulationCell* m_cells;
+  Apto::Array<int, Apto::Smart> m_offsets;
+  Apto::Array<int, Apto::Smart> m_neighbors;
+
+  cCellTopology(const cCellTopology&); // @not_implemented
+  cCellTopology& operator=(const cCellTopology&); // @not_implemented
+
+public:
+  cCellTopology() : m_cells(NULL) { ; }
+  ~cCellTopology() { ; }
+
+  // Compacts the builder lists into the shared arrays and attaches every cell to this topology
+  void Build(const cBuilder& links, Apto::Array<cPopulationCell>& cells);
+
+  int GetNumCells() const { return m_offsets.GetSize() - 1; }
+  int GetNumConnections() const { return m_neighbors.GetSize(); }
+
+  inline int GetNumNeighbors(int cell_id) const { return m_offsets[cell_id + 1] - m_offsets[cell_id]; }
+  inline int GetNeighborID(int cell_id, int pos) const { return m_neighbors[m_offsets[cell_id] + pos]; }
+  inline cPopulationCell* GetCells() const { return m_cells; }
+
+  // Returns the position of neighbor_id within the row of cell_id, scanning circularly from position start, or -1
+  int FindNeighbor(int cell_id, int neighbor_id, int start = 0) const;
+
+  void InsertConnection(int cell_id, int pos, int neighbor_id);
+  void RemoveConnection(int cell_id, int pos);
+};
+
+#endif
@@ -0,0 +1,53 @@
+/*
+ *  cEldestIndex.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cEldestIndex.h"
+
+#include <cassert>
+
+
+void cEldestIndex::SetOrigin(int slot, int origin)
+{
+  assert(slot >= 0);
+  
+  // Grow to the next power of two that covers the slot, carrying the existing leaves over
+  if (slot >= m_num_leaves) {
+    if (origin == EMPTY_SLOT) return;
+    int num_leaves = (m_num_leaves > 0) ? m_num_leaves : 64;
+    while (num_leaves <= slot) num_leaves *= 2;
+    
+    Apto::Array<int, Apto::Smart> new_min(2 * num_leaves);
+    new_min.SetAll(EMPTY_SLOT);
+    for (int i = 0; i < m_num_leaves; i++) new_min[num_leaves + i] = m_min[m_num_leaves + i];
+    for (int node = num_leaves - 1; node > 0; node--) {
+      new_min[node] = (new_min[node * 2] < new_min[node * 2 + 1]) ? new_min[node * 2] : new_min[node * 2 + 1];
+    }
+    m_min = new_min;
+    m_num_leaves = num_leaves;
+  }
+  
+  int node = m_num_leaves + slot;
+  m_min[node] = origin;
+  for (node /= 2; node > 0; node /= 2) {
+    const int node_min = (m_min[node * 2] < m_min[node * 2 + 1]) ? m_min[node * 2] : m_min[node * 2 + 1];
+    if (m_min[node] == node_min) break;
+    m_min[node] = node_min;
+  }
+}
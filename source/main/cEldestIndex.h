@@ -0,0 +1,93 @@
+/*
+ *  cEldestIndex.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cEldestIndex_h
+#define cEldestIndex_h
+
+#include "apto/core.h"
+
+#include <climits>
+
+
+// cEldestIndex - min tree of age origins over the slots of the live organism list
+//
+// Each slot holds the point at which the age of the organism in that slot of cPopulation's live organism list was last
+// zero (the population's age clock minus the organism's age), so older organisms have smaller origins.  The tree lets
+// a scan in list order skip every run of organisms younger than the eldest seen so far.  A stored origin may be lower
+// than the organism's true one (ages are reset by divides without notifying the index), but never higher; stale slots
+// are corrected by the scan that reaches them.
+class cEldestIndex
+{
+public:
+  static const int UNKNOWN_ORIGIN = INT_MIN;  // Always visited by the next scan, which stores the true origin
+
+private:
+  static const int EMPTY_SLOT = INT_MAX;
+
+  int m_num_leaves;
+  Apto::Array<int, Apto::Smart> m_min;   // Implicit binary tree, leaves at [m_num_leaves, 2 * m_num_leaves)
+
+  cEldestIndex(const cEldestIndex&); // @not_implemented
+  cEldestIndex& operator=(const cEldestIndex&); // @not_implemented
+
+public:
+  cEldestIndex() : m_num_leaves(0) { ; }
+
+  void Clear() { m_num_leaves = 0; m_min.Resize(0); }
+
+  int GetOrigin(int slot) const { return (slot < m_num_leaves) ? m_min[m_num_leaves + slot] : EMPTY_SLOT; }
+  void SetOrigin(int slot, int origin);
+  void ClearSlot(int slot) { SetOrigin(slot, EMPTY_SLOT); }
+
+  // Visits, in slot order, every eligible slot whose origin is no greater than that of every eligible slot before it
+  // (starting from start_origin), calling visitor.Record(slot, is_tie) where is_tie means the origin equals the
+  // running minimum.  The visitor supplies visitor.GetOrigin(slot), the true origin, and visitor.IsEligible(slot).
+  template <class Visitor> void VisitRecords(Visitor& visitor, int start_origin)
+  {
+    if (m_num_leaves > 0) visitRecords(1, start_origin, visitor);
+  }
+
+private:
+  template <class Visitor> int visitRecords(int node, int cur_origin, Visitor& visitor);
+};
+
+
+template <class Visitor> int cEldestIndex::visitRecords(int node, int cur_origin, Visitor& visitor)
+{
+  // Stored origins are lower bounds, so a subtree whose minimum is above the running minimum holds no record
+  if (m_min[node] > cur_origin) return cur_origin;
+
+  if (node >= m_num_leaves) {
+    const int slot = node - m_num_leaves;
+    m_min[node] = visitor.GetOrigin(slot);
+    if (m_min[node] <= cur_origin && visitor.IsEligible(slot)) {
+      visitor.Record(slot, m_min[node] == cur_origin);
+      cur_origin = m_min[node];
+    }
+    return cur_origin;
+  }
+
+  cur_origin = visitRecords(node * 2, cur_origin, visitor);
+  cur_origin = visitRecords(node * 2 + 1, cur_origin, visitor);
+  m_min[node] = (m_min[node * 2] < m_min[node * 2 + 1]) ? m_min[node * 2] : m_min[node * 2 + 1];
+  return cur_origin;
+}
+
+#endif
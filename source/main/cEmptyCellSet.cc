@@ -0,0 +1,72 @@
+/*
+ *  cEmptyCellSet.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cEmptyCellSet.h"
+
+#include <cassert>
+
+
+void cEmptyCellSet::Setup(int num_groups, int group_size)
+{
+  m_empty.ResizeClear(num_groups * group_size);
+  m_empty.SetAll(true);
+  m_tree.ResizeClear(num_groups * group_size);
+  m_group_count.ResizeClear(num_groups);
+  m_group_count.SetAll(group_size);
+  m_group_size = group_size;
+  
+  m_top_step = 1;
+  while (m_top_step * 2 <= group_size) m_top_step *= 2;
+  
+  // With every cell empty, node i of each tree covers (i & -i) cells
+  for (int i = 0; i < m_tree.GetSize(); i++) {
+    const int node = i % group_size + 1;
+    m_tree[i] = node & -node;
+  }
+}
+
+
+void cEmptyCellSet::adjust(int cell_id, int delta)
+{
+  m_empty[cell_id] = (delta > 0);
+  const int group_id = cell_id / m_group_size;
+  const int base = group_id * m_group_size - 1;
+  m_group_count[group_id] += delta;
+  for (int node = cell_id - group_id * m_group_size + 1; node <= m_group_size; node += node & -node) {
+    m_tree[base + node] += delta;
+  }
+}
+
+
+int cEmptyCellSet::Get(int group_id, int idx) const
+{
+  assert(idx >= 0 && idx < m_group_count[group_id]);
+  
+  // Descend to the last node whose prefix holds no more than idx empty cells; the next cell is the one sought
+  const int base = group_id * m_group_size - 1;
+  int node = 0;
+  for (int step = m_top_step; step > 0; step /= 2) {
+    if (node + step <= m_group_size && m_tree[base + node + step] <= idx) {
+      node += step;
+      idx -= m_tree[base + node];
+    }
+  }
+  return group_id * m_group_size + node;
+}
@@ -0,0 +1,63 @@
+/*
+ *  cEmptyCellSet.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cEmptyCellSet_h
+#define cEmptyCellSet_h
+
+#include "apto/core.h"
+
+
+// cEmptyCellSet - the empty cells of each group (deme) of contiguous cells, in cell order
+//
+// Group g covers cell ids g * group_size through (g + 1) * group_size - 1; cells past the last full group are not
+// tracked.  Each group keeps a binary indexed (Fenwick) tree of empty flags, so insertion, removal and finding the
+// idx-th empty cell of a group in ascending cell id order all take O(log group_size) time.  Selecting by rank gives the
+// same cell a full scan of the group would, so callers draw exactly as they did against a rescanned list.
+class cEmptyCellSet
+{
+private:
+  Apto::Array<bool, Apto::Smart> m_empty;      // indexed by cell id
+  Apto::Array<int, Apto::Smart> m_tree;        // Fenwick tree of group g stored 1-based from g * m_group_size onward
+  Apto::Array<int, Apto::Smart> m_group_count;
+  int m_group_size;
+  int m_top_step;                              // largest power of two not above m_group_size
+
+  cEmptyCellSet(const cEmptyCellSet&); // @not_implemented
+  cEmptyCellSet& operator=(const cEmptyCellSet&); // @not_implemented
+
+  void adjust(int cell_id, int delta);
+
+public:
+  cEmptyCellSet() : m_group_size(0), m_top_step(0) { ; }
+
+  // Sizes the set for num_groups groups of group_size cells, all of which start out empty
+  void Setup(int num_groups, int group_size);
+
+  int GetSize(int group_id) const { return m_group_count[group_id]; }
+  bool Contains(int cell_id) const { return cell_id < m_empty.GetSize() && m_empty[cell_id]; }
+
+  // The idx-th empty cell of the group, counting from the lowest cell id
+  int Get(int group_id, int idx) const;
+
+  void Insert(int cell_id) { if (cell_id < m_empty.GetSize() && !m_empty[cell_id]) adjust(cell_id, 1); }
+  void Remove(int cell_id) { if (cell_id < m_empty.GetSize() && m_empty[cell_id]) adjust(cell_id, -1); }
+};
+
+#endif
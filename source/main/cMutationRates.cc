@@ -25,6 +25,9 @@
 #include "cWorld.h"
 #include "cAvidaConfig.h"
 
+#include <climits>
+#include <cmath>
+
 
 void cMutationRates::Setup(cWorld* world)
 {
@@ -122,6 +125,8 @@ void cMutationRates::Clear()
   meta.standard_dev = 0.0;
 
   update.death_prob = 0.0;
+  
+  resetCopySkips();
 }
 
 void cMutationRates::Copy(const cMutationRates& in_muts)
@@ -132,4 +137,27 @@ void cMutationRates::Copy(const cMutationRates& in_muts)
   inject = in_muts.inject;
   meta = in_muts.meta;
   update = in_muts.update;
+  
+  // Pending skips are not copied, otherwise parent and offspring would mutate at the same future copies
+  resetCopySkips();
+}
+
+
+void cMutationRates::resetCopySkips() const
+{
+  for (int i = 0; i < NUM_COPY_SKIPS; i++) {
+    copy_skip[i].prob = 0.0;
+    copy_skip[i].remaining = -1;
+  }
+}
+
+
+int cMutationRates::drawCopySkip(cAvidaContext& ctx, double prob)
+{
+  if (prob >= 1.0) return 0;
+  
+  // Inversion of the geometric distribution, with u drawn from (0, 1] so that the log is finite
+  const double u = 1.0 - ctx.GetRandom().GetDouble();
+  const double skip = floor(log(u) / log(1.0 - prob));
+  return (skip < INT_MAX) ? static_cast<int>(skip) : INT_MAX;
 }
@@ -41,6 +41,17 @@ private:
     double slip_prob;
   };
   sCopyMuts copy;
+  
+  // Copy mutations are sampled by geometric skip: the number of copies until the next mutation of each class is drawn
+  // once and counted down, rather than consulting the random number generator on every copy.  Since the skip is
+  // memoryless this yields the same per-copy distribution.  A skip is redrawn whenever the probability it was drawn
+  // for changes, and is never inherited by copies of the rates.
+  enum { SKIP_MUT = 0, SKIP_INS, SKIP_DEL, SKIP_UNIFORM, SKIP_SLIP, NUM_COPY_SKIPS };
+  struct sCopySkip {
+    double prob;    // probability the skip was drawn for
+    int remaining;  // copies left before the next mutation, -1 if a new skip must be drawn
+  };
+  mutable sCopySkip copy_skip[NUM_COPY_SKIPS];
 
   // ...at the divide...
   struct sDivideMuts {
@@ -108,14 +119,25 @@ public:
   void Clear();
   void Copy(const cMutationRates& in_muts);
 
-  // Copy muts should always check if they are 0.0 before consulting the random number generator for performance
-  bool TestCopyMut(cAvidaContext& ctx) const { return (copy.mut_prob == 0.0) ? false : ctx.GetRandom().P(copy.mut_prob); }
-  bool TestCopyIns(cAvidaContext& ctx) const { return (copy.ins_prob == 0.0) ? false : ctx.GetRandom().P(copy.ins_prob); }
-  bool TestCopyDel(cAvidaContext& ctx) const { return (copy.del_prob == 0.0) ? false : ctx.GetRandom().P(copy.del_prob); }
-  bool TestCopySlip(cAvidaContext& ctx) const { return (copy.slip_prob == 0.0) ? false : ctx.GetRandom().P(copy.slip_prob); }
+  // Copy muts are tested on every copy, so they count down a geometric skip rather than drawing each time
+  bool TestCopyMut(cAvidaContext& ctx) const { return testCopySkip(ctx, copy.mut_prob, copy_skip[SKIP_MUT]); }
+  bool TestCopyIns(cAvidaContext& ctx) const { return testCopySkip(ctx, copy.ins_prob, copy_skip[SKIP_INS]); }
+  bool TestCopyDel(cAvidaContext& ctx) const { return testCopySkip(ctx, copy.del_prob, copy_skip[SKIP_DEL]); }
+  bool TestCopySlip(cAvidaContext& ctx) const { return testCopySkip(ctx, copy.slip_prob, copy_skip[SKIP_SLIP]); }
   bool TestCopyUniform(cAvidaContext& ctx) const
   {
-    return (copy.uniform_prob == 0.0) ? false : ctx.GetRandom().P(copy.uniform_prob);
+    return testCopySkip(ctx, copy.uniform_prob, copy_skip[SKIP_UNIFORM]);
+  }
+  
+  // Error correcting copies test at the copy rates divided by reduction (>= 1).  A mutation drawn from the full rate
+  // skip is kept with probability 1 / reduction, which thins each copy's chance to exactly prob / reduction.
+  bool TestCopyMut(cAvidaContext& ctx, double reduction) const { return TestCopyMut(ctx) && thinCopyMut(ctx, reduction); }
+  bool TestCopyIns(cAvidaContext& ctx, double reduction) const { return TestCopyIns(ctx) && thinCopyMut(ctx, reduction); }
+  bool TestCopyDel(cAvidaContext& ctx, double reduction) const { return TestCopyDel(ctx) && thinCopyMut(ctx, reduction); }
+  bool TestCopySlip(cAvidaContext& ctx, double reduction) const { return TestCopySlip(ctx) && thinCopyMut(ctx, reduction); }
+  bool TestCopyUniform(cAvidaContext& ctx, double reduction) const
+  {
+    return TestCopyUniform(ctx) && thinCopyMut(ctx, reduction);
   }
   
   bool TestDivideMut(cAvidaContext& ctx) const { return ctx.GetRandom().P(divide.divide_mut_prob); }
@@ -239,6 +261,34 @@ public:
   void SetMetaStandardDev(double in_dev)    { meta.standard_dev     = in_dev; }
 
   void SetDeathProb(double in_prob)         { update.death_prob      = in_prob; }
+
+  
+  // Returns the number of failures before the first success of a Bernoulli process with the given probability
+  static int drawCopySkip(cAvidaContext& ctx, double prob);
+  
+private:
+  void resetCopySkips() const;
+  
+  inline bool testCopySkip(cAvidaContext& ctx, double prob, sCopySkip& skip) const
+  {
+    // Check for 0.0 before consulting the random number generator for performance
+    if (prob == 0.0) return false;
+    if (skip.remaining < 0 || skip.prob != prob) {
+      skip.prob = prob;
+      skip.remaining = drawCopySkip(ctx, prob);
+    }
+    if (skip.remaining == 0) {
+      skip.remaining = -1;
+      return true;
+    }
+    skip.remaining--;
+    return false;
+  }
+  
+  inline bool thinCopyMut(cAvidaContext& ctx, double reduction) const
+  {
+    return (reduction <= 1.0) || ctx.GetRandom().P(1.0 / reduction);
+  }
 };
 
 #endif
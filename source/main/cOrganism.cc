@@ -54,6 +54,9 @@ using namespace Avida;
 static const Apto::BasicString<Apto::ThreadSafe> s_ext_prop_name_instset("instset");
 
 
+cFreeListPool* const cOrganism::s_pool = new cFreeListPool("cOrganism", sizeof(cOrganism));
+
+
 // Internal cOrganism Properties
 // --------------------------------------------------------------------------------------------------------------
 
@@ -29,6 +29,7 @@
 #include "avida/private/systematics/GenomeTestMetrics.h"
 
 #include "cCPUMemory.h"
+#include "cFreeListPool.h"
 #include "cMutationRates.h"
 #include "cPhenotype.h"
 #include "cOrgInterface.h"
@@ -108,6 +109,8 @@ private:
 
   bool killed_event;
 
+  static cFreeListPool* const s_pool;
+
   cOrganism(); // @not_implemented
   cOrganism(const cOrganism&); // @not_implemented
   cOrganism& operator=(const cOrganism&); // @not_implemented
@@ -116,6 +119,11 @@ public:
   cOrganism(cWorld* world, cAvidaContext& ctx, const Genome& genome, int parent_generation, Systematics::Source src);
   ~cOrganism();
   
+  // Organism storage is recycled through a free list rather than returned to the system allocator.  This covers the
+  // cOrganism object itself (including the embedded cPhenotype), not the Apto::Array storage the members allocate.
+  static void* operator new(size_t size) { return s_pool->Allocate(size); }
+  static void operator delete(void* ptr, size_t size) { s_pool->Release(ptr, size); }
+  
   static void Initialize();
   
   
@@ -307,6 +315,11 @@ public:
   bool TestCopyDel(cAvidaContext& ctx) const { return m_mut_rates.TestCopyDel(ctx); }
   bool TestCopyUniform(cAvidaContext& ctx) const { return m_mut_rates.TestCopyUniform(ctx); }
   bool TestCopySlip(cAvidaContext& ctx) const { return m_mut_rates.TestCopySlip(ctx); }
+  bool TestCopyMut(cAvidaContext& ctx, double reduction) const { return m_mut_rates.TestCopyMut(ctx, reduction); }
+  bool TestCopyIns(cAvidaContext& ctx, double reduction) const { return m_mut_rates.TestCopyIns(ctx, reduction); }
+  bool TestCopyDel(cAvidaContext& ctx, double reduction) const { return m_mut_rates.TestCopyDel(ctx, reduction); }
+  bool TestCopyUniform(cAvidaContext& ctx, double reduction) const { return m_mut_rates.TestCopyUniform(ctx, reduction); }
+  bool TestCopySlip(cAvidaContext& ctx, double reduction) const { return m_mut_rates.TestCopySlip(ctx, reduction); }
 
   bool TestDivideMut(cAvidaContext& ctx) const { return m_mut_rates.TestDivideMut(ctx); }
   bool TestDivideIns(cAvidaContext& ctx) const { return m_mut_rates.TestDivideIns(ctx); }
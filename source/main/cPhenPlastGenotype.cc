@@ -21,19 +21,74 @@
 
 #include "cPhenPlastGenotype.h"
 #include "cPhenPlastSummary.h"
+
+#include "apto/rng.h"
+
+#include "cAnalyzeJobQueue.h"
+#include "cAvidaContext.h"
+#include "tAnalyzeJobBatch.h"
+
 #include <iostream>
 #include <cmath>
 #include <cfloat>
 
 const Apto::String cPhenPlastSummary::ObjectKey("cPhenPlastSummary");
 
+
+// A single plasticity trial, run as an analyze job.  The trial seeds its own context so that its result does not
+// depend on which worker thread runs it, or in what order, and works on its own copy of the genome.
+class cPhenPlastTrial
+{
+private:
+  cWorld* m_world;
+  Genome m_genome;
+  cCPUTestInfo m_test_info;
+  int m_num_trials;
+  int m_seed;
+  cPlasticPhenotype* m_phenotype;
+  
+  cPhenPlastTrial(const cPhenPlastTrial&); // @not_implemented
+  cPhenPlastTrial& operator=(const cPhenPlastTrial&); // @not_implemented
+  
+public:
+  cPhenPlastTrial(cWorld* world, const Genome& genome, const cCPUTestInfo& test_info, int num_trials, int seed)
+    : m_world(world), m_genome(genome), m_test_info(test_info), m_num_trials(num_trials), m_seed(seed), m_phenotype(NULL) { ; }
+  
+  // The caller takes ownership of the phenotype
+  cPlasticPhenotype* GetPhenotype() { return m_phenotype; }
+  
+  void Run(cAvidaContext&)
+  {
+    Apto::RNG::AvidaRNG rng(m_seed);
+    cAvidaContext ctx(&m_world->GetDriver(), rng);
+    ctx.SetAnalyzeMode();
+    
+    cTestCPU* test_cpu = m_world->GetHardwareManager().CreateTestCPU(ctx);
+    test_cpu->TestGenome(ctx, m_test_info, m_genome);
+    m_phenotype = new cPlasticPhenotype(m_test_info, m_num_trials);
+    m_test_info.Clear();  // Release the test organisms now, rather than holding them until every trial is done
+    delete test_cpu;
+  }
+};
+
+
 cPhenPlastGenotype::cPhenPlastGenotype(const Genome& in_genome, int num_trials, cCPUTestInfo& test_info,  cWorld* world, cAvidaContext& ctx)
 : m_genome(in_genome), m_num_trials(num_trials), m_world(world)
 {
   // Override input mode if more than one recalculation requested
   if (num_trials > 1)  
     test_info.UseRandomInputs(true);
-  Process(test_info, world, ctx);
+  Process(test_info, world, ctx, NULL);
+}
+
+cPhenPlastGenotype::cPhenPlastGenotype(const Genome& in_genome, int num_trials, cCPUTestInfo& test_info,  cWorld* world, cAvidaContext& ctx,
+                                       cAnalyzeJobQueue& jobqueue)
+: m_genome(in_genome), m_num_trials(num_trials), m_world(world)
+{
+  // Override input mode if more than one recalculation requested
+  if (num_trials > 1)  
+    test_info.UseRandomInputs(true);
+  Process(test_info, world, ctx, &jobqueue);
 }
 
 cPhenPlastGenotype::~cPhenPlastGenotype()
@@ -45,26 +100,32 @@ cPhenPlastGenotype::~cPhenPlastGenotype()
   }
 }
 
-void cPhenPlastGenotype::Process(cCPUTestInfo& test_info, cWorld* world, cAvidaContext& ctx)
+void cPhenPlastGenotype::Process(cCPUTestInfo& test_info, cWorld* world, cAvidaContext& ctx, cAnalyzeJobQueue* jobqueue)
 {
-  cTestCPU* test_cpu = m_world->GetHardwareManager().CreateTestCPU(ctx);
-
   if (m_num_trials > 1) test_info.UseRandomInputs(true);
   
-  for (int k = 0; k < m_num_trials; k++){
-    test_cpu->TestGenome(ctx, test_info, m_genome);
-    //Is this a new phenotype?
-    UniquePhenotypes::iterator uit = m_unique.find(&test_info.GetTestPhenotype());
-    if (uit == m_unique.end()){  // Yes, make a new entry for it
-      cPlasticPhenotype* new_phen = new cPlasticPhenotype(test_info, m_num_trials);
-      m_plastic_phenotypes.Push(new_phen);
-      m_unique.insert( static_cast<cPhenotype*>(new_phen) );
-    } else{   // No, add an observation to existing entry, make sure it is equivalent
-      if (!static_cast<cPlasticPhenotype*>((*uit))->AddObservation(test_info)){
-        cerr << "Error with this plastic phenotype. Abort." << endl;
-        exit(3);
+  if (jobqueue && m_num_trials > 1) {
+    ProcessTrials(test_info, ctx, *jobqueue);
+  } else {
+    cTestCPU* test_cpu = m_world->GetHardwareManager().CreateTestCPU(ctx);
+    
+    for (int k = 0; k < m_num_trials; k++){
+      test_cpu->TestGenome(ctx, test_info, m_genome);
+      //Is this a new phenotype?
+      UniquePhenotypes::iterator uit = m_unique.find(&test_info.GetTestPhenotype());
+      if (uit == m_unique.end()){  // Yes, make a new entry for it
+        cPlasticPhenotype* new_phen = new cPlasticPhenotype(test_info, m_num_trials);
+        m_plastic_phenotypes.Push(new_phen);
+        m_unique.insert( static_cast<cPhenotype*>(new_phen) );
+      } else{   // No, add an observation to existing entry, make sure it is equivalent
+        if (!static_cast<cPlasticPhenotype*>((*uit))->AddObservation(test_info)){
+          cerr << "Error with this plastic phenotype. Abort." << endl;
+          exit(3);
+        }
       }
     }
+    
+    delete test_cpu;
   }
   
   // Update statistics
@@ -105,8 +166,39 @@ void cPhenPlastGenotype::Process(cCPUTestInfo& test_info, cWorld* world, cAvidaC
     m_viable_probability += (this_phen->IsViable() > 0) ? freq : 0;
     ++uit;
   }
+}
+
+
+void cPhenPlastGenotype::ProcessTrials(cCPUTestInfo& test_info, cAvidaContext& ctx, cAnalyzeJobQueue& jobqueue)
+{
+  // Each trial gets a copy of the test settings, which must not carry any test organisms along with it
+  test_info.Clear();
+  
+  Apto::Array<cPhenPlastTrial*> trials(m_num_trials);
+  tAnalyzeJobBatch<cPhenPlastTrial> jobbatch(jobqueue);
+  for (int k = 0; k < m_num_trials; k++) {
+    trials[k] = new cPhenPlastTrial(m_world, m_genome, test_info, m_num_trials, ctx.GetRandom().GetInt(ctx.GetRandom().MaxSeed()));
+    jobbatch.AddJob(trials[k], &cPhenPlastTrial::Run);
+  }
+  jobbatch.RunBatch();
   
-  if (test_cpu) delete test_cpu;
+  // Merge in trial order, so the first trial to show each phenotype is the one that represents it
+  for (int k = 0; k < m_num_trials; k++) {
+    cPlasticPhenotype* trial_phen = trials[k]->GetPhenotype();
+    delete trials[k];
+    
+    UniquePhenotypes::iterator uit = m_unique.find(trial_phen);
+    if (uit == m_unique.end()) {
+      m_plastic_phenotypes.Push(trial_phen);
+      m_unique.insert(static_cast<cPhenotype*>(trial_phen));
+    } else {
+      if (!static_cast<cPlasticPhenotype*>((*uit))->AddObservations(*trial_phen)) {
+        cerr << "Error with this plastic phenotype. Abort." << endl;
+        exit(3);
+      }
+      delete trial_phen;
+    }
+  }
 }
 
 
@@ -36,6 +36,7 @@
 #include <set>
 #include <utility>
 
+class cAnalyzeJobQueue;
 class cAvidaContext;
 class cTestCPU;
 class cWorld;
@@ -69,10 +70,16 @@ private:
     
     
   
-  void Process(cCPUTestInfo& test_info, cWorld* world, cAvidaContext& ctx);
+  void Process(cCPUTestInfo& test_info, cWorld* world, cAvidaContext& ctx, cAnalyzeJobQueue* jobqueue);
+  void ProcessTrials(cCPUTestInfo& test_info, cAvidaContext& ctx, cAnalyzeJobQueue& jobqueue);
   
 public:
   cPhenPlastGenotype(const Genome& in_genome, int num_trails, cCPUTestInfo& test_info,  cWorld* world, cAvidaContext& ctx);
+  
+  // Runs the trials as jobs on the analyze job queue, each with its own random seed drawn from ctx.  test_info is
+  // cleared first and only its settings are used, so it holds no test organisms afterward.
+  cPhenPlastGenotype(const Genome& in_genome, int num_trails, cCPUTestInfo& test_info,  cWorld* world, cAvidaContext& ctx,
+                     cAnalyzeJobQueue& jobqueue);
   ~cPhenPlastGenotype();
     
   // Accessors
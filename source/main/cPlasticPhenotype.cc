@@ -41,6 +41,14 @@ bool cPlasticPhenotype::AddObservation( cCPUTestInfo& test_info )
 }
 
 
+bool cPlasticPhenotype::AddObservations( const cPlasticPhenotype& phenotype )
+{
+  if (cPhenotype::Compare(&phenotype, this) != 0) return false;  //Wrong phenotype
+  m_num_observations += phenotype.m_num_observations;
+  return true;
+}
+
+
 void cPlasticPhenotype::SetExecutedFlags(cCPUTestInfo& test_info)
 {
   cCPUMemory& cpu_memory = test_info.GetTestOrganism()->GetHardware().GetMemory();
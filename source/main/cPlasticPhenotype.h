@@ -51,6 +51,7 @@ class cPlasticPhenotype : public cPhenotype{
     
     //Modifiers
     bool AddObservation(  cCPUTestInfo& test_info );
+    bool AddObservations( const cPlasticPhenotype& phenotype );  // Merges in the observations of an equal phenotype
     
     //Accessors
     int GetNumObservations()      const { return m_num_observations; }
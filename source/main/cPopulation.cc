@@ -29,6 +29,7 @@
 #include "avida/data/Package.h"
 #include "avida/data/Util.h"
 #include "avida/output/File.h"
+#include "avida/output/Manager.h"
 #include "avida/systematics/Arbiter.h"
 #include "avida/systematics/Group.h"
 #include "avida/systematics/Manager.h"
@@ -36,6 +37,7 @@
 #include "avida/private/systematics/GenomeTestMetrics.h"
 #include "avida/private/systematics/Genotype.h"
 
+#include "apto/core/FileSystem.h"
 #include "apto/rng.h"
 #include "apto/scheduler.h"
 #include "apto/stat/Accumulator.h"
@@ -47,15 +49,18 @@
 #include "cCodeLabel.h"
 #include "cDemePlaceholderUnit.h"
 #include "cEnvironment.h"
+#include "cFreeListPool.h"
 #include "cHardwareBase.h"
 #include "cHardwareManager.h"
 #include "cInitFile.h"
 #include "cInstSet.h"
+#include "cMappedInitFile.h"
 #include "cMigrationMatrix.h"   
 #include "cOrganism.h"
 #include "cParasite.h"
 #include "cPhenotype.h"
 #include "cPopulationCell.h"
+#include "cPopulationCheckpoint.h"
 #include "cResource.h"
 #include "cResourceCount.h"
 #include "cStats.h"
@@ -266,6 +271,8 @@ cPopulation::cPopulation(cWorld* world)
 : m_world(world)
 , m_scheduler(NULL)
 , birth_chamber(world)
+, m_eldest_index_active(false)
+, m_age_clock(0)
 , print_mini_trace_genomes(false)
 , use_micro_traces(false)
 , m_next_prey_q(0)
@@ -277,6 +284,7 @@ cPopulation::cPopulation(cWorld* world)
 , num_top_pred_organisms(0)
 , sync_events(false)
 , m_hgt_resid(-1)
+, m_checkpoint_writer(NULL)
 {
   world_x = world->GetConfig().WORLD_X.Get();
   world_y = world->GetConfig().WORLD_Y.Get();
@@ -316,6 +324,8 @@ void cPopulation::ClearCellGrid()
 {
   delete sleep_log; sleep_log = NULL;
   reaper_queue.Clear();
+  m_eldest_index.Clear();
+  m_eldest_index_active = false;
   delete m_scheduler; m_scheduler = NULL;
 }
 
@@ -341,9 +351,10 @@ void cPopulation::SetupCellGrid()
   
   // Setup the cells.  Do things that are not dependent upon topology here.
   bool fill_reaper_queue = (m_world->GetConfig().BIRTH_METHOD.Get() == POSITION_OFFSPRING_FULL_SOUP_ELDEST);
+  reaper_queue.ResizeClear(num_cells);
   for (int i = 0; i < num_cells; i++) {
     cell_array[i].Setup(m_world, i, environment.GetMutRates(), i % world_x, i / world_x);    
-    if (fill_reaper_queue) reaper_queue.Push(&(cell_array[i]));
+    if (fill_reaper_queue) reaper_queue.Push(i);
   }
   
   // What are the sizes of the demes that we're creating?
@@ -351,6 +362,7 @@ void cPopulation::SetupCellGrid()
   const int deme_size_y = world_y / num_demes;
   const int deme_size = deme_size_x * deme_size_y;
   deme_array.ResizeClear(num_demes);
+  m_empty_cells.Setup(num_demes, deme_size);
   
   // Broken setting:
   assert(m_world->GetConfig().DEMES_REPLICATE_SIZE.Get() <= deme_size);
@@ -370,29 +382,30 @@ void cPopulation::SetupCellGrid()
   // What we're doing here is chopping the cell_array up into num_demes pieces.
   // Note that having 0 demes (one population) is the same as having 1 deme.  Then
   // we send the cells that comprise each deme into the topology builder.
+  cCellTopology::cBuilder links(num_cells);
   for (int i = 0; i < num_cells; i += deme_size) {
     // We're cheating here; we're using the random access nature of an iterator to index beyond the end of the cell_array.
     switch(geometry) {
       case nGeometry::GRID:
-        build_grid(cell_array.Range(i, i + deme_size - 1), deme_size_x, deme_size_y);
+        build_grid(cell_array.Range(i, i + deme_size - 1), links, deme_size_x, deme_size_y);
         break;
       case nGeometry::TORUS:
-        build_torus(cell_array.Range(i, i + deme_size - 1), deme_size_x, deme_size_y);
+        build_torus(cell_array.Range(i, i + deme_size - 1), links, deme_size_x, deme_size_y);
         break;
       case nGeometry::CLIQUE:
-        build_clique(cell_array.Range(i, i + deme_size - 1), deme_size_x, deme_size_y);
+        build_clique(cell_array.Range(i, i + deme_size - 1), links, deme_size_x, deme_size_y);
         break;
       case nGeometry::HEX:
-        build_hex(cell_array.Range(i, i + deme_size - 1), deme_size_x, deme_size_y);
+        build_hex(cell_array.Range(i, i + deme_size - 1), links, deme_size_x, deme_size_y);
         break;
       case nGeometry::LATTICE:
-        build_lattice(cell_array.Range(i, i + deme_size - 1), deme_size_x, deme_size_y, 1);
+        build_lattice(cell_array.Range(i, i + deme_size - 1), links, deme_size_x, deme_size_y, 1);
         break;
       case nGeometry::RANDOM_CONNECTED:
-        build_random_connected_network(cell_array.Range(i, i + deme_size - 1), deme_size_x, deme_size_y, m_world->GetRandom());
+        build_random_connected_network(cell_array.Range(i, i + deme_size - 1), links, deme_size_x, deme_size_y, m_world->GetRandom());
         break;
       case nGeometry::SCALE_FREE:
-        build_scale_free(cell_array.Range(i, i + deme_size - 1), m_world->GetConfig().SCALE_FREE_M.Get(),
+        build_scale_free(cell_array.Range(i, i + deme_size - 1), links, m_world->GetConfig().SCALE_FREE_M.Get(),
                          m_world->GetConfig().SCALE_FREE_ALPHA.Get(), m_world->GetConfig().SCALE_FREE_ZERO_APPEAL.Get(),
                          m_world->GetRandom());
         break;
@@ -401,6 +414,9 @@ void cPopulation::SetupCellGrid()
     }
   }
   
+  // Compact the connections into the flat neighbor arrays shared by all cells
+  m_cell_topology.Build(links, cell_array);
+  
   BuildTimeSlicer();
   
   
@@ -602,6 +618,8 @@ bool cPopulation::IsValidArgument(const Data::DataID& data_id, Data::Argument ar
 
 cPopulation::~cPopulation()
 {
+  // Wait for any background checkpoint write, reporting if it failed
+  FinishPopulationSave();
   for (int i = 0; i < cell_array.GetSize(); i++) delete cell_array[i].GetOrganism(); 
   delete m_scheduler;
 }
@@ -621,6 +639,8 @@ inline void cPopulation::AdjustSchedule(const cPopulationCell& cell, const cMeri
 bool cPopulation::ActivateOffspring(cAvidaContext& ctx, const Genome& offspring_genome, cOrganism* parent_organism)
 {
   assert(parent_organism != NULL);
+  // Offspring are created before they are placed, so they are allocated with the parent's deme
+  cFreeListPool::cArenaScope arena(OrganismArena(parent_organism->GetCellID()));
   bool is_doomed = false;
   int doomed_cell = (world_x * world_y) - 1; //Also at the end of cPopulation::ActivateOrganism
   Apto::Array<cOrganism*> offspring_array;
@@ -1127,7 +1147,7 @@ bool cPopulation::ActivateParasite(cOrganism* host, Systematics::UnitPtr parent,
     }
     else {
       target_organism =
-      host_cell.ConnectionList().GetPos(m_world->GetRandom().GetUInt(host->GetNeighborhoodSize()))->GetOrganism();
+      host_cell.GetNeighbor(m_world->GetRandom().GetUInt(host->GetNeighborhoodSize())).GetOrganism();
     }     
   }
   
@@ -1253,7 +1273,7 @@ bool cPopulation::ActivateOrganism(cAvidaContext& ctx, cOrganism* in_organism, c
   
   // Special handling for certain birth methods.
   if (m_world->GetConfig().BIRTH_METHOD.Get() == POSITION_OFFSPRING_FULL_SOUP_ELDEST) {
-    reaper_queue.Push(&target_cell);
+    reaper_queue.Push(target_cell.GetID());
   }
   
   // If neural networking, add input and output avatars.. @JJB**
@@ -1959,10 +1979,10 @@ bool cPopulation::MoveOrganisms(cAvidaContext& ctx, int src_cell_id, int dest_ce
     
     // Find neighborhood size for facing
     if (NULL != dest_cell.GetOrganism()) {
-      actualNeighborhoodSize = dest_cell.ConnectionList().GetSize();
+      actualNeighborhoodSize = dest_cell.GetNumNeighbors();
     } else {
       if (NULL != src_cell.GetOrganism()) {
-        actualNeighborhoodSize = src_cell.ConnectionList().GetSize();
+        actualNeighborhoodSize = src_cell.GetNumNeighbors();
       } else {
         // Punt
         actualNeighborhoodSize = 8;
@@ -1980,7 +2000,7 @@ bool cPopulation::MoveOrganisms(cAvidaContext& ctx, int src_cell_id, int dest_ce
     newFacing = destFacing;
     for(int i = 0; i < actualNeighborhoodSize; i++) {
       if (src_cell.GetFacing() != newFacing) {
-        src_cell.ConnectionList().CircNext();
+        src_cell.RotateFacing();
         //cout << "MO: src_cell facing not yet at " << newFacing << endl;
       } else {
         //cout << "MO: src_cell facing successfully set to " << newFacing << endl;
@@ -1994,7 +2014,7 @@ bool cPopulation::MoveOrganisms(cAvidaContext& ctx, int src_cell_id, int dest_ce
     newFacing = fromFacing;
     for(int i = 0; i < actualNeighborhoodSize; i++) {
       if (dest_cell.GetFacing() != newFacing) {
-        dest_cell.ConnectionList().CircNext();
+        dest_cell.RotateFacing();
         // cout << "MO: dest_cell facing not yet at " << newFacing << endl;
       } else {
         // cout << "MO: dest_cell facing successfully set to " << newFacing << endl;
@@ -2271,6 +2291,26 @@ void cPopulation::SwapCells(int cell_id1, int cell_id2, cAvidaContext& ctx)
 //  For ease of use, each organism
 // is setup as if it we just injected into the population.
 
+/*! Replace each deme fitness with 2^(-rank), where the rank of a deme is one more than the number of demes with strictly
+ higher fitness, and return the new total.  Ranks come from a sorted copy of the fitness values, rather than from
+ comparing every pair of demes.
+ */
+static double RankDemeFitness(Apto::Array<double>& deme_fitness)
+{
+  const int num_demes = deme_fitness.GetSize();
+  std::vector<double> sorted_fitness(num_demes);
+  for (int deme_id = 0; deme_id < num_demes; deme_id++) sorted_fitness[deme_id] = deme_fitness[deme_id];
+  std::sort(sorted_fitness.begin(), sorted_fitness.end());
+  
+  double total_fitness = 0.0;
+  for (int deme_id = 0; deme_id < num_demes; deme_id++) {
+    const int num_higher = sorted_fitness.end() - std::upper_bound(sorted_fitness.begin(), sorted_fitness.end(), deme_fitness[deme_id]);
+    deme_fitness[deme_id] = ldexp(1.0, -(num_higher + 1));
+    total_fitness += deme_fitness[deme_id];
+  }
+  return total_fitness;
+}
+
 void cPopulation::CompeteDemes(cAvidaContext& ctx, int competition_type)
 {
   const int num_demes = deme_array.GetSize();
@@ -2336,24 +2376,8 @@ void cPopulation::CompeteDemes(cAvidaContext& ctx, int competition_type)
         }
         deme_fitness[deme_id] = single_deme_fitness.Ave();
       }
-      // ... then determine the rank of each deme based on its fitness
-      Apto::Array<double> deme_rank(num_demes);
-      deme_rank.SetAll(1);
-      for (int deme_id = 0; deme_id < num_demes; deme_id++) {
-        for (int test_deme = 0; test_deme < num_demes; test_deme++) {
-          if (deme_fitness[deme_id] < deme_fitness[test_deme]) {
-            deme_rank[deme_id]++;
-          }
-        }
-      }
-      // ... finally, make deme fitness 2^(-deme rank)
-      deme_fitness.SetAll(1);
-      for (int deme_id = 0; deme_id < num_demes; deme_id++) {
-        for (int i = 0; i < deme_rank[deme_id]; i++) {
-          deme_fitness[deme_id] = deme_fitness[deme_id]/2;
-        }
-        total_fitness += deme_fitness[deme_id];
-      }
+      // ... then replace each with 2^(-deme fitness rank)
+      total_fitness = RankDemeFitness(deme_fitness);
     }
       break;
     case 5:    // deme fitness = average organism life fitness at the current update
@@ -2384,40 +2408,24 @@ void cPopulation::CompeteDemes(cAvidaContext& ctx, int competition_type)
         }
         deme_fitness[deme_id] = single_deme_life_fitness.Ave();
       }
-      // ... then determine the rank of each deme based on its fitness
-      Apto::Array<double> deme_rank(num_demes);
-      deme_rank.SetAll(1);
-      for (int deme_id = 0; deme_id < num_demes; deme_id++) {
-        for (int test_deme = 0; test_deme < num_demes; test_deme++) {
-          if (deme_fitness[deme_id] < deme_fitness[test_deme]) {
-            deme_rank[deme_id]++;
-          }
-        }
-      }
-      // ... finally, make deme fitness 2^(-deme rank)
-      deme_fitness.SetAll(1);
-      for (int deme_id = 0; deme_id < num_demes; deme_id++) {
-        for (int i = 0; i < deme_rank[deme_id]; i++) {
-          deme_fitness[deme_id] = deme_fitness[deme_id]/2;
-        }
-        total_fitness += deme_fitness[deme_id];
-      }
+      // ... then replace each with 2^(-deme fitness rank)
+      total_fitness = RankDemeFitness(deme_fitness);
     }
       break;
   }
   
-  // Pick which demes should be in the next generation.
+  // Pick which demes should be in the next generation, searching the running fitness totals for each choice.
+  std::vector<double> fitness_totals(num_demes);
+  double test_total = 0;
+  for (int test_deme = 0; test_deme < num_demes; test_deme++) {
+    test_total += deme_fitness[test_deme];
+    fitness_totals[test_deme] = test_total;
+  }
   Apto::Array<int> new_demes(num_demes);
   for (int i = 0; i < num_demes; i++) {
     double birth_choice = (double) ctx.GetRandom().GetDouble(total_fitness);
-    double test_total = 0;
-    for (int test_deme = 0; test_deme < num_demes; test_deme++) {
-      test_total += deme_fitness[test_deme];
-      if (birth_choice < test_total) {
-        new_demes[i] = test_deme;
-        break;
-      }
-    }
+    const int chosen = std::upper_bound(fitness_totals.begin(), fitness_totals.end(), birth_choice) - fitness_totals.begin();
+    new_demes[i] = (chosen < num_demes) ? chosen : num_demes - 1;
   }
   
   // Track how many of each deme we should have.
@@ -2430,18 +2438,20 @@ void cPopulation::CompeteDemes(cAvidaContext& ctx, int competition_type)
   Apto::Array<bool> is_init(num_demes);
   is_init.SetAll(false);
   
-  // Copy demes until all deme counts are 1.
+  // Copy demes until all deme counts are 1.  Counts only ever fall to one at the source and rise to one at the target,
+  // so neither search needs to look back at demes it has already passed.
+  int from_deme_id = 0;
+  int to_deme_id = 0;
   while (true) {
     // Find the next deme to copy...
-    int from_deme_id, to_deme_id;
-    for (from_deme_id = 0; from_deme_id < num_demes; from_deme_id++) {
+    for (; from_deme_id < num_demes; from_deme_id++) {
       if (deme_count[from_deme_id] > 1) break;
     }
     
     // Stop If we didn't find another deme to copy
     if (from_deme_id == num_demes) break;
     
-    for (to_deme_id = 0; to_deme_id < num_demes; to_deme_id++) {
+    for (; to_deme_id < num_demes; to_deme_id++) {
       if (deme_count[to_deme_id] == 0) break;
     }
     
@@ -2592,18 +2602,16 @@ void cPopulation::CompeteDemes(const std::vector<double>& calculated_fitness, cA
       const double total_fitness = std::accumulate(fitness.begin(), fitness.end(), 0.0);
       assert(total_fitness > 0.0); // Must have *some* positive fitnesses...
       
-      // Sum up the fitnesses until we reach or exceed the target fitness.
+      // Find the first deme whose running fitness total reaches or exceeds the target fitness.
       // Then we're marking that deme as being part of the next generation.
+      std::vector<double> running_sums(fitness.size());
+      std::partial_sum(fitness.begin(), fitness.end(), running_sums.begin());
       for (int i=0; i<deme_array.GetSize(); ++i) {
-        double running_sum = 0.0;
         double target_sum = ctx.GetRandom().GetDouble(total_fitness);
-        for (int j=0; j<deme_array.GetSize(); ++j) {
-          running_sum += fitness[j];
-          if (running_sum >= target_sum) {
-            // j'th deme will be replicated.
-            ++deme_counts[j];
-            break;
-          }
+        std::vector<double>::iterator j = std::lower_bound(running_sums.begin(), running_sums.end(), target_sum);
+        if (j != running_sums.end()) {
+          // j'th deme will be replicated.
+          ++deme_counts[j - running_sums.begin()];
         }
       }
       break;
@@ -2671,8 +2679,10 @@ void cPopulation::CompeteDemes(const std::vector<double>& calculated_fitness, cA
   // Ok, the below algorithm relies upon the fact that we have a strict weak ordering
   // of fitness values for all demes.  We're going to loop through, find demes with a
   // count greater than one, and insert them into demes with a count of zero.
+  // As counts only fall to one at a source and rise to one at a target, both searches resume where they left off.
+  int source_id=0;
+  int target_id=0;
   while (true) {
-    int source_id=0;
     for(; source_id<(int)deme_counts.size(); ++source_id) {
       if (deme_counts[source_id] > 1) {
         --deme_counts[source_id];
@@ -2684,7 +2694,6 @@ void cPopulation::CompeteDemes(const std::vector<double>& calculated_fitness, cA
       break; // All done; we looped through the whole list of counts, and didn't find any > 1.
     }
     
-    int target_id=0;
     for(; target_id<(int)deme_counts.size(); ++target_id) {
       if (deme_counts[target_id] == 0) {
         ++deme_counts[target_id];
@@ -3139,6 +3148,9 @@ void cPopulation::ReplaceDeme(cDeme& source_deme, cDeme& target_deme, cAvidaCont
   
   // do our post-replication stats tracking.
   m_world->GetStats().DemePostReplication(source_deme, target_deme);
+  
+  ReleaseDemeArena(source_deme);
+  if (target_deme.GetDemeID() != source_deme.GetDemeID()) ReleaseDemeArena(target_deme);
 }
 
 /*! ReplaceDemeFlaggedGermline is a helper method that handles deme replication when the organisms are flagging their own germ line. It is similar to ReplaceDeme, but some events are reordered. (Demes are reset only after we know that the replication will work. In addition, it only supports a small subset of the deme replication options.) 
@@ -3305,7 +3317,8 @@ void cPopulation::ReplaceDemeFlaggedGermline(cDeme& source_deme, cDeme& target_d
   m_world->GetStats().DemePostReplication(source_deme, target_deme);
   m_world->GetStats().TrackDemeGLSReplication(source_deme.GetID(), target_deme.GetID(), track_founders);
   
-  
+  ReleaseDemeArena(source_deme);
+  if (target_deme.GetDemeID() != source_deme.GetDemeID()) ReleaseDemeArena(target_deme);
 }
 
 /*! Helper method to seed a deme from the given genome.
@@ -3987,10 +4000,8 @@ void cPopulation::DemePostInjection(cDeme& deme, cPopulationCell& cell) {
       break;
     }
     case 2: { // Spin cell to face randomly.
-      const int rotate_count = m_world->GetRandom().GetInt(0, cell.ConnectionList().GetSize());
-      for(int i=0; i<rotate_count; ++i) {
-        cell.ConnectionList().CircNext();
-      }
+      const int rotate_count = m_world->GetRandom().GetInt(0, cell.GetNumNeighbors());
+      cell.RotateFacing(rotate_count);
       break;
     }
     default: {
@@ -4080,6 +4091,7 @@ void cPopulation::ResetDemes()
       if (cell_array[cur_cell_id].IsOccupied() == false) continue;
       InjectClone(cur_cell_id, *(cell_array[cur_cell_id].GetOrganism()), cell_array[cur_cell_id].GetOrganism()->UnitSource());
     }
+    ReleaseDemeArena(deme_array[deme_id]);
   }
 }
 
@@ -4995,25 +5007,7 @@ cPopulationCell& cPopulation::PositionOffspring(cPopulationCell& parent_cell, cA
     int num_kills = 1;
     
     while (num_kills > 0) {
-      double max_age = 0.0;
-      double max_msr = 0.0;
-      int cell_id = 0;
-      for (int i = 0; i < live_org_list.GetSize(); i++) {
-        if (GetCell(live_org_list[i]->GetCellID()).IsOccupied() && live_org_list[i]->GetCellID() != parent_cell.GetID()) {       
-          double age = live_org_list[i]->GetPhenotype().GetAge();
-          if (age > max_age) {
-            max_age = age;
-            cell_id = live_org_list[i]->GetCellID();
-          }
-          else if (age == max_age) {
-            double msr = ctx.GetRandom().GetDouble();
-            if (msr > max_msr) {
-              max_msr = msr;
-              cell_id = live_org_list[i]->GetCellID();
-            }
-          }
-        }
-      }
+      int cell_id = FindEldestCell(ctx, parent_cell.GetID());
       KillOrganism(cell_array[cell_id], ctx);
       num_kills--;
     }
@@ -5093,12 +5087,13 @@ cPopulationCell& cPopulation::PositionOffspring(cPopulationCell& parent_cell, cA
   }
   
   if (birth_method == POSITION_OFFSPRING_FULL_SOUP_ELDEST) {
-    cPopulationCell * out_cell = reaper_queue.PopRear();
-    if (parent_ok == false && out_cell->GetID() == parent_cell.GetID()) {
-      out_cell = reaper_queue.PopRear();
-      reaper_queue.PushRear(&parent_cell);
+    int out_cell_id = reaper_queue.PopRear();
+    if (parent_ok == false && out_cell_id == parent_cell.GetID()) {
+      out_cell_id = reaper_queue.PopRear();
+      reaper_queue.PushRear(parent_cell.GetID());
     }
-    return *out_cell;
+    assert(out_cell_id >= 0);
+    return GetCell(out_cell_id);
   }
   
   if (birth_method == POSITION_OFFSPRING_DEME_RANDOM) {
@@ -5136,34 +5131,34 @@ cPopulationCell& cPopulation::PositionOffspring(cPopulationCell& parent_cell, cA
   // All remaining methods require us to choose among mulitple local positions.
   
   // Construct a list of equally viable locations to place the child...
-  tList<cPopulationCell> found_list;
+  // Candidates are collected in reverse order and the random choice below indexes from the back, so that placement is
+  // unchanged from the earlier linked list implementation (which pushed candidates onto the front of the list).
+  Apto::Array<cPopulationCell*, Apto::Smart> found_list;
   
   // First, check if there is an empty organism to work with (always preferred)
-  tList<cPopulationCell>& conn_list = parent_cell.ConnectionList();
-  
   const bool prefer_empty = m_world->GetConfig().PREFER_EMPTY.Get();
   
-  if (birth_method == POSITION_OFFSPRING_DISPERSAL && conn_list.GetSize() > 0) {
-    tList<cPopulationCell>* disp_list = &conn_list;
+  if (birth_method == POSITION_OFFSPRING_DISPERSAL && parent_cell.GetNumNeighbors() > 0) {
+    cPopulationCell* disp_cell = &parent_cell;
     
     // hop through connection lists based on the dispersal rate
     int hops = ctx.GetRandom().GetRandPoisson(m_world->GetConfig().DISPERSAL_RATE.Get());
     for (int i = 0; i < hops; i++) {
-      disp_list = &(disp_list->GetPos(ctx.GetRandom().GetUInt(disp_list->GetSize()))->ConnectionList());
-      if (disp_list->GetSize() == 0) break;
+      disp_cell = &disp_cell->GetNeighbor(ctx.GetRandom().GetUInt(disp_cell->GetNumNeighbors()));
+      if (disp_cell->GetNumNeighbors() == 0) break;
     }
     
     // if prefer empty, select an empty cell from the final connection list
-    if (prefer_empty) FindEmptyCell(*disp_list, found_list);
+    if (prefer_empty) FindEmptyCell(*disp_cell, found_list);
     
     // if prefer empty is off, or there are no empty cells, use the whole connection list as possiblities
     if (found_list.GetSize() == 0) {
-      found_list = *disp_list;
+      for (int i = disp_cell->GetNumNeighbors() - 1; i >= 0; i--) found_list.Push(&disp_cell->GetNeighbor(i));
       // if no hops were taken and ALLOW_PARENT is set, throw the parent cell into the hat for possible selection
       if (hops == 0 && parent_ok) found_list.Push(&parent_cell);
     }
   } else if (prefer_empty) {
-    FindEmptyCell(conn_list, found_list);
+    FindEmptyCell(parent_cell, found_list);
   }
   
   // If we have not found an empty organism, we must use the specified function
@@ -5177,7 +5172,7 @@ cPopulationCell& cPopulation::PositionOffspring(cPopulationCell& parent_cell, cA
         PositionMerit(parent_cell, found_list, parent_ok);
         break;
       case POSITION_OFFSPRING_RANDOM:
-        found_list.Append(conn_list);
+        for (int i = parent_cell.GetNumNeighbors() - 1; i >= 0; i--) found_list.Push(&parent_cell.GetNeighbor(i));
         if (parent_ok == true) found_list.Push(&parent_cell);
         break;
       case POSITION_OFFSPRING_NEIGHBORHOOD_ENERGY_USED:
@@ -5193,11 +5188,11 @@ cPopulationCell& cPopulation::PositionOffspring(cPopulationCell& parent_cell, cA
   
   // Choose the organism randomly from those in the list, and return it.
   int choice = ctx.GetRandom().GetUInt(found_list.GetSize());
-  return *( found_list.GetPos(choice) );
+  return *(found_list[found_list.GetSize() - 1 - choice]);
 }
 
-void cPopulation::PositionAge(cPopulationCell & parent_cell,
-                              tList<cPopulationCell> & found_list,
+void cPopulation::PositionAge(cPopulationCell& parent_cell,
+                              Apto::Array<cPopulationCell*, Apto::Smart>& found_list,
                               bool parent_ok)
 {
   // Start with the parent organism as the replacement, and see if we can find
@@ -5208,14 +5203,13 @@ void cPopulation::PositionAge(cPopulationCell & parent_cell,
   if (parent_ok == false) max_age = -1;
   
   // Now look at all of the neighbors.
-  tListIterator<cPopulationCell> conn_it( parent_cell.ConnectionList() );
-  
-  cPopulationCell * test_cell;
-  while ( (test_cell = conn_it.Next()) != NULL) {
+  const int num_neighbors = parent_cell.GetNumNeighbors();
+  for (int i = 0; i < num_neighbors; i++) {
+    cPopulationCell* test_cell = &parent_cell.GetNeighbor(i);
     const int cur_age = test_cell->GetOrganism()->GetPhenotype().GetAge();
     if (cur_age > max_age) {
       max_age = cur_age;
-      found_list.Clear();
+      found_list.Resize(0);
       found_list.Push(test_cell);
     }
     else if (cur_age == max_age) {
@@ -5224,8 +5218,8 @@ void cPopulation::PositionAge(cPopulationCell & parent_cell,
   }
 }
 
-void cPopulation::PositionMerit(cPopulationCell & parent_cell,
-                                tList<cPopulationCell> & found_list,
+void cPopulation::PositionMerit(cPopulationCell& parent_cell,
+                                Apto::Array<cPopulationCell*, Apto::Smart>& found_list,
                                 bool parent_ok)
 {
   // Start with the parent organism as the replacement, and see if we can find
@@ -5236,14 +5230,13 @@ void cPopulation::PositionMerit(cPopulationCell & parent_cell,
   if (parent_ok == false) max_ratio = -1;
   
   // Now look at all of the neighbors.
-  tListIterator<cPopulationCell> conn_it( parent_cell.ConnectionList() );
-  
-  cPopulationCell * test_cell;
-  while ( (test_cell = conn_it.Next()) != NULL) {
+  const int num_neighbors = parent_cell.GetNumNeighbors();
+  for (int i = 0; i < num_neighbors; i++) {
+    cPopulationCell* test_cell = &parent_cell.GetNeighbor(i);
     const double cur_ratio = test_cell->GetOrganism()->CalcMeritRatio();
     if (cur_ratio > max_ratio) {
       max_ratio = cur_ratio;
-      found_list.Clear();
+      found_list.Resize(0);
       found_list.Push(test_cell);
     }
     else if (cur_ratio == max_ratio) {
@@ -5252,8 +5245,8 @@ void cPopulation::PositionMerit(cPopulationCell & parent_cell,
   }
 }
 
-void cPopulation::PositionEnergyUsed(cPopulationCell & parent_cell,
-                                     tList<cPopulationCell> & found_list,
+void cPopulation::PositionEnergyUsed(cPopulationCell& parent_cell,
+                                     Apto::Array<cPopulationCell*, Apto::Smart>& found_list,
                                      bool parent_ok)
 {
   // Start with the parent organism as the replacement, and see if we can find
@@ -5264,14 +5257,13 @@ void cPopulation::PositionEnergyUsed(cPopulationCell & parent_cell,
   if (parent_ok == false) max_energy_used = -1;
   
   // Now look at all of the neighbors.
-  tListIterator<cPopulationCell> conn_it( parent_cell.ConnectionList() );
-  
-  cPopulationCell * test_cell;
-  while ( (test_cell = conn_it.Next()) != NULL) {
+  const int num_neighbors = parent_cell.GetNumNeighbors();
+  for (int i = 0; i < num_neighbors; i++) {
+    cPopulationCell* test_cell = &parent_cell.GetNeighbor(i);
     const int cur_energy_used = test_cell->GetOrganism()->GetPhenotype().GetTimeUsed();
     if (cur_energy_used > max_energy_used) {
       max_energy_used = cur_energy_used;
-      found_list.Clear();
+      found_list.Resize(0);
       found_list.Push(test_cell);
     }
     else if (cur_energy_used == max_energy_used) {
@@ -5412,10 +5404,10 @@ cPopulationCell& cPopulation::PositionDemeRandom(int deme_id, cPopulationCell& p
   // Look randomly within empty cells first, if requested
   if (m_world->GetConfig().PREFER_EMPTY.Get()) {
     
-    int num_empty_cells = UpdateEmptyCellIDArray(deme_id);
+    const int num_empty_cells = m_empty_cells.GetSize(deme_id);
     if (num_empty_cells > 0) {
       int out_pos = m_world->GetRandom().GetUInt(num_empty_cells);
-      return GetCell(empty_cell_id_array[out_pos]);
+      return GetCell(m_empty_cells.Get(deme_id, out_pos));
     }
   }
   
@@ -5450,33 +5442,6 @@ int cPopulation::FindRandEmptyCell(cAvidaContext& ctx)
   return cell_id;
 }
 
-// This function updates the list of empty cell ids in the population
-// and returns the number of empty cells found. Used by global PREFER_EMPTY
-// PositionOffspring() methods with demes (only). 
-int cPopulation::UpdateEmptyCellIDArray(int deme_id)
-{
-  int num_empty_cells = 0;
-  // Note: empty_cell_id_array was resized to be large enough to hold
-  // all cells in the cPopulation when it was created. Using functions
-  // that resize it (like Push) will slow this code down considerably.
-  // Instead, we keep track of how much of this memory we are using.
-  
-  // Look at all cells
-  if (deme_id == -1) {
-    for (int i=0; i<cell_array.GetSize(); i++) {
-      if (GetCell(i).IsOccupied() == false) empty_cell_id_array[num_empty_cells++] = i;
-    }
-  }
-  // Look at a specific deme
-  else {
-    cDeme& deme = deme_array[deme_id];
-    for (int i=0; i<deme.GetSize(); i++) {
-      if (GetCell(deme.GetCellID(i)).IsOccupied() == false) empty_cell_id_array[num_empty_cells++] = deme.GetCellID(i);
-    }
-  }
-  return num_empty_cells;
-}
-
 
 int cPopulation::ScheduleOrganism()
 {
@@ -5803,6 +5768,7 @@ void cPopulation::UpdateOrganismStats(cAvidaContext& ctx)
     // Increment the age of this organism.
     organism->GetPhenotype().IncAge();
   }
+  m_age_clock++;
   
   stats.SetBreedTrueCreatures(num_breed_true);
   stats.SetNumNoBirthCreatures(num_no_birth);
@@ -6036,6 +6002,58 @@ void cPopulation::ProcessUpdateCellActions(cAvidaContext& ctx)
   }
 }
 
+void cPopulation::ProcessPointMutations(cAvidaContext& ctx)
+{
+  // Organisms that mutate at the configured substitution rate are pooled.  The number of substituted sites across the
+  // whole pool is drawn once, the sites themselves are picked without replacement from the pool's concatenated genomes
+  // (so each organism still receives a binomial number of substitutions), and the cumulative genome lengths map every
+  // pooled site back to its organism.  Organisms with their own substitution rate go through PointMutate as before.
+  const double pool_rate = m_world->GetConfig().POINT_MUT_PROB.Get();
+  
+  Apto::Array<cOrganism*, Apto::Smart> pool;
+  Apto::Array<int, Apto::Smart> pool_offsets;   // pool_offsets[i] is the first pooled site of pool[i]
+  Apto::Array<int, Apto::Smart> pool_muts;
+  int total_sites = 0;
+  
+  for (int i = 0; i < live_org_list.GetSize(); i++) {
+    cOrganism* org = live_org_list[i];
+    if (org->GetPointMutProb() != pool_rate) {
+      org->IncPointMutations(org->GetHardware().PointMutate(ctx));
+      continue;
+    }
+    pool.Push(org);
+    pool_offsets.Push(total_sites);
+    pool_muts.Push(0);
+    total_sites += org->GetHardware().GetMemory().GetSize();
+  }
+  if (pool.GetSize() == 0) return;
+  
+  const int num_mut = (pool_rate > 0.0) ? ctx.GetRandom().GetRandBinomial(total_sites, pool_rate) : 0;
+  if (num_mut > 0) {
+    // Draw distinct sites, redrawing only as many as were lost to duplicates
+    Apto::Array<int, Apto::Smart> sites;
+    while (sites.GetSize() < num_mut) {
+      for (int i = num_mut - sites.GetSize(); i > 0; i--) sites.Push(ctx.GetRandom().GetUInt(total_sites));
+      Apto::QSort(sites);
+      int unique = 1;
+      for (int i = 1; i < sites.GetSize(); i++) if (sites[i] != sites[unique - 1]) sites[unique++] = sites[i];
+      sites.Resize(unique);
+    }
+    
+    // Sites are sorted, so a single forward walk over the offsets finds the owner of each one
+    int cur = 0;
+    for (int i = 0; i < sites.GetSize(); i++) {
+      while (cur + 1 < pool.GetSize() && pool_offsets[cur + 1] <= sites[i]) cur++;
+      pool[cur]->GetHardware().PointSubstitute(ctx, sites[i] - pool_offsets[cur]);
+      pool_muts[cur]++;
+    }
+  }
+  
+  for (int i = 0; i < pool.GetSize(); i++) {
+    pool[i]->IncPointMutations(pool_muts[i] + pool[i]->GetHardware().PointMutateIndels(ctx));
+  }
+}
+
 
 struct sOrgInfo {
   int cell_id;
@@ -6271,6 +6289,113 @@ bool cPopulation::SavePopulation(const cString& filename, bool save_historic, bo
 }
 
 
+static Apto::SmartPtr<Apto::Map<Apto::String, Apto::String> > legacyGroupProperties(Systematics::GroupPtr grp)
+{
+  Apto::SmartPtr<Apto::Map<Apto::String, Apto::String> > props(new Apto::Map<Apto::String, Apto::String>);
+  grp->LegacySaveProperties(*props);
+  return props;
+}
+
+bool cPopulation::SavePopulationBinary(const cString& filename, bool save_historic, bool save_groupings, bool save_avatars, bool save_rebirth, bool background)
+{
+  // Only one binary save may be outstanding at a time
+  FinishPopulationSave();
+  
+  Apto::String file_path = Output::Manager::Of(m_world->GetNewWorld())->OutputIDFromPath((const char*)filename);
+  if (file_path.GetSize() == 0) {
+    m_world->GetDriver().Feedback().Error("unable to translate path '%s' to output id", (const char*)filename);
+    return false;
+  }
+  
+  int flags = 0;
+  if (save_groupings) flags |= cPopulationCheckpoint::SAVE_GROUPINGS;
+  if (save_avatars) flags |= cPopulationCheckpoint::SAVE_AVATARS;
+  if (save_rebirth) flags |= cPopulationCheckpoint::SAVE_REBIRTH;
+  if (save_historic) flags |= cPopulationCheckpoint::SAVE_HISTORIC;
+  
+  // Snapshot everything that will be written while the population is stable, so that the
+  // encoding and file output can proceed while the run continues
+  cPopulationCheckpoint* checkpoint = new cPopulationCheckpoint(flags, cell_array.GetSize());
+  Apto::Map<int, int> group_index;
+  
+  for (int cell = 0; cell < cell_array.GetSize(); cell++) {
+    if (!cell_array[cell].IsOccupied()) continue;
+    cOrganism* org = cell_array[cell].GetOrganism();
+    
+    // Handle any parasites
+    const Apto::Array<Systematics::UnitPtr>& parasites = org->GetParasites();
+    for (int p = 0; p < parasites.GetSize(); p++) {
+      Systematics::GroupPtr pg = parasites[p]->SystematicsGroup("genotype");
+      if (pg == NULL) continue;
+      
+      int idx = -1;
+      if (!group_index.Get(pg->ID(), idx)) {
+        idx = checkpoint->AddGroup(legacyGroupProperties(pg), true);
+        group_index.Set(pg->ID(), idx);
+      }
+      checkpoint->AddOrganism(cPopulationCheckpoint::sOrgRecord(cell, idx, 0, -1, -1, -1, 0, -1, -1, -1, 0, 1));
+    }
+    
+    // Handle the organism itself
+    Systematics::GroupPtr genotype = org->SystematicsGroup("genotype");
+    if (genotype == NULL) continue;
+    
+    int idx = -1;
+    if (!group_index.Get(genotype->ID(), idx)) {
+      idx = checkpoint->AddGroup(legacyGroupProperties(genotype));
+      group_index.Set(genotype->ID(), idx);
+    }
+    
+    int curr_group = -1;
+    if (org->HasOpinion()) curr_group = org->GetOpinion().first;
+    int avatar_cell = -1;
+    int av_bcell = -1;
+    if (m_world->GetConfig().USE_AVATARS.Get()) {
+      avatar_cell = org->GetOrgInterface().GetAVCellID();
+      av_bcell = org->GetPhenotype().GetAVBirthCell();
+    }
+    checkpoint->AddOrganism(cPopulationCheckpoint::sOrgRecord(cell, idx, org->GetPhenotype().GetCPUCyclesUsed(), org->GetLineageLabel(),
+                                                              curr_group, org->GetForageTarget(), org->GetPhenotype().GetBirthCell(),
+                                                              avatar_cell, av_bcell, org->GetParentFT(), (bool)org->HadParentTeacher(),
+                                                              org->GetParentMerit()));
+  }
+  
+  // Historic genotypes
+  if (save_historic) {
+    Apto::Array<Apto::SmartPtr<Apto::Map<Apto::String, Apto::String> > > historic;
+    Systematics::Manager::Of(m_world->GetNewWorld())->ArbiterForRole("genotype")->LegacySaveProperties(historic);
+    for (int i = 0; i < historic.GetSize(); i++) checkpoint->AddGroup(historic[i], false, true);
+  }
+  
+  checkpoint->SetPath(file_path);
+  if (background) {
+    m_checkpoint_writer = checkpoint;
+    m_checkpoint_writer->Start();
+    return true;
+  }
+  
+  const bool success = checkpoint->Write(file_path);
+  if (!success) m_world->GetDriver().Feedback().Error("unable to write population checkpoint '%s'", (const char*)file_path);
+  delete checkpoint;
+  return success;
+}
+
+bool cPopulation::FinishPopulationSave()
+{
+  if (!m_checkpoint_writer) return true;
+  
+  m_checkpoint_writer->Join();
+  const bool success = m_checkpoint_writer->WasSuccessful();
+  if (!success) {
+    m_world->GetDriver().Feedback().Error("unable to write population checkpoint '%s'", (const char*)m_checkpoint_writer->GetPath());
+  }
+  delete m_checkpoint_writer;
+  m_checkpoint_writer = NULL;
+  
+  return success;
+}
+
+
 bool cPopulation::SaveStructuredSystematicsGroup(const Systematics::RoleID& role, const cString& filename)
 {
   Apto::String file_path((const char*)filename);
@@ -6496,28 +6621,114 @@ bool cPopulation::LoadHostGenotypeList(const cString& filename, cAvidaContext& c
 }
 
 
+// Fills the genotype table from a binary checkpoint, loading the same per-organism columns that would be taken from the
+// equivalent text save
+static void loadCheckpointGenotypes(const cPopulationCheckpoint& checkpoint, Apto::Array<sTmpGenotype, Apto::ManagedPointer>& genotypes,
+                                    bool load_groups, bool load_birth_cells, bool load_avatars, bool load_rebirth, bool load_parent_dat,
+                                    bool use_avatars)
+{
+  const int flags = checkpoint.GetFlags();
+  const bool has_groupings = (flags & (cPopulationCheckpoint::SAVE_GROUPINGS | cPopulationCheckpoint::SAVE_REBIRTH));
+  const bool has_avatars = (flags & (cPopulationCheckpoint::SAVE_AVATARS | cPopulationCheckpoint::SAVE_REBIRTH));
+  const bool has_parent_dat = (flags & cPopulationCheckpoint::SAVE_REBIRTH);
+  
+  bool get_groups = false;
+  bool get_birth_cells = false;
+  bool get_av_bcells = false;
+  bool get_avatar_cells = false;
+  bool get_parent_dat = false;
+  if (load_rebirth) {
+    get_birth_cells = has_groupings;
+    get_av_bcells = has_avatars && use_avatars;
+    get_parent_dat = has_parent_dat;
+  } else {
+    get_groups = load_groups && has_groupings;
+    if (load_birth_cells) {
+      get_birth_cells = has_groupings;
+      get_av_bcells = has_avatars && use_avatars;
+    } else if (load_avatars) {
+      get_avatar_cells = has_avatars;
+    }
+    get_parent_dat = load_parent_dat && has_parent_dat;
+  }
+  if (use_avatars && !get_av_bcells) get_avatar_cells = has_avatars;
+  
+  genotypes.ResizeClear(checkpoint.GetNumGroups());
+  for (int g = 0; g < checkpoint.GetNumGroups(); g++) {
+    sTmpGenotype& tmp = genotypes[g];
+    tmp.props = checkpoint.GetGroup(g).props;
+    tmp.id_num = Apto::StrAs(tmp.props->Get("id"));
+    tmp.num_cpus = Apto::StrAs(tmp.props->Get("num_units"));
+  }
+  
+  for (int i = 0; i < checkpoint.GetNumOrganisms(); i++) {
+    const cPopulationCheckpoint::sOrgRecord& rec = checkpoint.GetOrganism(i);
+    sTmpGenotype& tmp = genotypes[rec.group];
+    
+    tmp.cells.Push(rec.cell_id);
+    if (!load_rebirth && !checkpoint.GetGroup(rec.group).parasite) tmp.offsets.Push(rec.offset);
+    tmp.lineage_labels.Push(rec.lineage_label);
+    
+    if (get_groups) {
+      tmp.group_ids.Push(rec.curr_group);
+      tmp.forager_types.Push(rec.curr_forage);
+    }
+    if (get_birth_cells) tmp.birth_cells.Push(rec.birth_cell);
+    if (get_av_bcells) tmp.avatar_cells.Push(rec.av_bcell);
+    else if (get_avatar_cells) tmp.avatar_cells.Push(rec.avatar_cell);
+    if (get_parent_dat) {
+      tmp.parent_teacher.Push((bool)rec.parent_is_teacher);
+      tmp.parent_ft.Push(rec.parent_ft);
+      tmp.parent_merit.Push(rec.parent_merit);
+    }
+  }
+}
+
 bool cPopulation::LoadPopulation(const cString& filename, cAvidaContext& ctx, int cellid_offset, int lineage_offset, bool load_groups, bool load_birth_cells, bool load_avatars, bool load_rebirth, bool load_parent_dat, int traceq)
 {
   // @TODO - build in support for verifying population dimensions
   
-  cInitFile input_file(filename, m_world->GetWorkingDir(), ctx.Driver().Feedback());
-  if (!input_file.WasOpened()) return false;
+  // First, we read in all the genotypes and store them in an array
+  Apto::Array<sTmpGenotype, Apto::ManagedPointer> genotypes;
+  
+  // Binary checkpoints written by SavePopulationBinary are recognized by their header, anything else is parsed as text.
+  // Population files can be very large, map them rather than copying every line into memory, unless they rely on
+  // directives that only cInitFile supports
+  Apto::String file_path = Apto::FileSystem::GetAbsolutePath(Apto::String((const char*)filename), Apto::String((const char*)m_world->GetWorkingDir()));
+  FinishPopulationSave();
+  
+  const bool binary = cPopulationCheckpoint::IsCheckpointFile(file_path);
+  Apto::SmartPtr<cMappedInitFile> input_file;
+  Apto::SmartPtr<cInitFile> full_input_file;
+  int num_lines = 0;
+  if (binary) {
+    cPopulationCheckpoint checkpoint;
+    if (!checkpoint.Read(file_path, ctx.Driver().Feedback())) return false;
+    loadCheckpointGenotypes(checkpoint, genotypes, load_groups, load_birth_cells, load_avatars, load_rebirth, load_parent_dat,
+                            m_world->GetConfig().USE_AVATARS.Get());
+  } else {
+    input_file = Apto::SmartPtr<cMappedInitFile>(new cMappedInitFile(filename, m_world->GetWorkingDir(), ctx.Driver().Feedback()));
+    if (input_file->NeedsInitFile()) {
+      full_input_file = Apto::SmartPtr<cInitFile>(new cInitFile(filename, m_world->GetWorkingDir(), ctx.Driver().Feedback()));
+      if (!full_input_file->WasOpened()) return false;
+      num_lines = full_input_file->GetNumLines();
+    } else {
+      if (!input_file->WasOpened()) return false;
+      num_lines = input_file->GetNumLines();
+    }
+    genotypes.ResizeClear(num_lines);
+  }
   
   // Clear out the population, unless an offset is being used
   if (cellid_offset == 0) {
     for (int i = 0; i < cell_array.GetSize(); i++) KillOrganism(cell_array[i], ctx); 
   }
   
-  // First, we read in all the genotypes and store them in an array
-  Apto::Array<sTmpGenotype, Apto::ManagedPointer> genotypes(input_file.GetNumLines());
-  
-  bool structured = false;
-  for (int line_id = 0; line_id < input_file.GetNumLines(); line_id++) {
-    cString cur_line = input_file.GetLine(line_id);
-    
+  bool structured = binary;
+  for (int line_id = 0; line_id < num_lines; line_id++) {
     // Setup the genotype for this line...
     sTmpGenotype& tmp = genotypes[line_id];
-    tmp.props = input_file.GetLineAsDict(line_id);
+    tmp.props = (input_file->NeedsInitFile()) ? full_input_file->GetLineAsDict(line_id) : input_file->GetLineAsDict(line_id);
     tmp.id_num = Apto::StrAs(tmp.props->Get("id"));
 
     // Loads "num_units" preferrentially, but will fall back to "num_cpus" if present
@@ -6604,24 +6815,24 @@ bool cPopulation::LoadPopulation(const cString& filename, cAvidaContext& ctx, in
         while (avatarstr.GetSize()) tmp.avatar_cells.Push(avatarstr.Pop(',').AsInt());
         assert(tmp.avatar_cells.GetSize() == 0 || tmp.avatar_cells.GetSize() == tmp.num_cpus);
       }
-    if (load_parent_dat) {
-      if (tmp.props->Has("parent_is_teach")) {
-        cString teachstr(tmp.props->Get("parent_is_teach"));
-        while (teachstr.GetSize()) tmp.parent_teacher.Push((bool)(teachstr.Pop(',').AsInt()));
-        assert(tmp.parent_teacher.GetSize() == 0 || tmp.parent_teacher.GetSize() == tmp.num_cpus);
-      }
-      if (tmp.props->Has("parent_ft")) {
-        cString parentftstr(tmp.props->Get("parent_ft"));
-        while (parentftstr.GetSize()) tmp.parent_ft.Push(parentftstr.Pop(',').AsInt());
-        assert(tmp.parent_ft.GetSize() == 0 || tmp.parent_ft.GetSize() == tmp.num_cpus);
-      }
-      if (tmp.props->Has("parent_merit")) {
-        cString meritstr(tmp.props->Get("parent_merit"));
-        while (meritstr.GetSize()) tmp.parent_merit.Push(meritstr.Pop(',').AsDouble());
-        assert(tmp.parent_merit.GetSize() == 0 || tmp.parent_merit.GetSize() == tmp.num_cpus);      
+      if (load_parent_dat) {
+        if (tmp.props->Has("parent_is_teach")) {
+          cString teachstr(tmp.props->Get("parent_is_teach"));
+          while (teachstr.GetSize()) tmp.parent_teacher.Push((bool)(teachstr.Pop(',').AsInt()));
+          assert(tmp.parent_teacher.GetSize() == 0 || tmp.parent_teacher.GetSize() == tmp.num_cpus);
+        }
+        if (tmp.props->Has("parent_ft")) {
+          cString parentftstr(tmp.props->Get("parent_ft"));
+          while (parentftstr.GetSize()) tmp.parent_ft.Push(parentftstr.Pop(',').AsInt());
+          assert(tmp.parent_ft.GetSize() == 0 || tmp.parent_ft.GetSize() == tmp.num_cpus);
+        }
+        if (tmp.props->Has("parent_merit")) {
+          cString meritstr(tmp.props->Get("parent_merit"));
+          while (meritstr.GetSize()) tmp.parent_merit.Push(meritstr.Pop(',').AsDouble());
+          assert(tmp.parent_merit.GetSize() == 0 || tmp.parent_merit.GetSize() == tmp.num_cpus);      
+        }
       }
     }
-    }
     if (m_world->GetConfig().USE_AVATARS.Get() && !tmp.avatar_cells.GetSize()) {
       cString avatarstr(tmp.props->Get("avatar_cell"));
       while (avatarstr.GetSize()) tmp.avatar_cells.Push(avatarstr.Pop(',').AsInt());
@@ -6709,7 +6920,7 @@ bool cPopulation::LoadPopulation(const cString& filename, cAvidaContext& ctx, in
         // Set the phenotype merit from the save file
         assert(tmp.props->Has("merit"));
         double merit = Apto::StrAs(tmp.props->Get("merit"));
-        if ((load_rebirth || load_parent_dat) && m_world->GetConfig().INHERIT_MERIT.Get() && tmp.props->Has("parent_merit")) {
+        if ((load_rebirth || load_parent_dat) && m_world->GetConfig().INHERIT_MERIT.Get() && tmp.parent_merit.GetSize()) {
           merit = tmp.parent_merit[cell_i]; 
         }
         
@@ -6738,7 +6949,7 @@ bool cPopulation::LoadPopulation(const cString& filename, cAvidaContext& ctx, in
       if (m_world->GetConfig().BIRTH_METHOD.Get() == POSITION_OFFSPRING_FULL_SOUP_ELDEST &&
           cell_array[cell_id].IsOccupied() == true) {
         // Have to manually take this cell out of the reaper Queue.
-        reaper_queue.Remove( &(cell_array[cell_id]) );
+        reaper_queue.Remove(cell_id);
       }
       
       // Setup the child's mutation rates.  Since this organism is being injected
@@ -6770,7 +6981,7 @@ bool cPopulation::LoadPopulation(const cString& filename, cAvidaContext& ctx, in
         if (load_parent_dat) {
           new_organism->SetParentFT(tmp.parent_ft[cell_i]);
           new_organism->SetParentTeacher(tmp.parent_teacher[cell_i]);
-          if (tmp.props->Has("parent_merit")) new_organism->SetParentMerit(tmp.parent_merit[cell_i]);        
+          if (tmp.parent_merit.GetSize()) new_organism->SetParentMerit(tmp.parent_merit[cell_i]);        
         }
       }
       else if (load_rebirth) {
@@ -6820,7 +7031,7 @@ void cPopulation::Inject(const Genome& genome, Systematics::Source src, cAvidaCo
   if (cell_id < 0) {
     switch (m_world->GetConfig().BIRTH_METHOD.Get()) {
       case POSITION_OFFSPRING_FULL_SOUP_ELDEST:
-        cell_id = reaper_queue.PopRear()->GetID();
+        cell_id = reaper_queue.PopRear();
       default:
         cell_id = 0;
     }
@@ -7129,19 +7340,96 @@ void cPopulation::BuildTimeSlicer()
 }
 
 
-void cPopulation::FindEmptyCell(tList<cPopulationCell> & cell_list,
-                                tList<cPopulationCell> & found_list)
+void cPopulation::FindEmptyCell(const cPopulationCell& cell,
+                                Apto::Array<cPopulationCell*, Apto::Smart>& found_list)
 {
-  tListIterator<cPopulationCell> cell_it(cell_list);
-  cPopulationCell * test_cell;
-  
-  while ( (test_cell = cell_it.Next()) != NULL) {
+  const int num_neighbors = cell.GetNumNeighbors();
+  for (int i = 0; i < num_neighbors; i++) {
     // If this cell is empty, add it to the list...
+    cPopulationCell* test_cell = &cell.GetNeighbor(i);
     if (test_cell->IsOccupied() == false) found_list.Push(test_cell);
   }
 }
 
 
+// The eldest index (used by POP_CAP_ELDEST) mirrors the slots of live_org_list and is only maintained once it has been
+// queried.  FindEldestCell walks the same organisms, in the same order, that a scan of live_org_list would, but skips
+// every run of organisms younger than the eldest found so far.
+//
+// RNG consumption: identical to the original full list scan.  In live_org_list order, each eligible organism (any but
+// the parent) whose age equals the greatest age seen so far (starting at zero) draws one GetDouble(), and takes the
+// pick if the draw exceeds every earlier draw of this search.  An organism strictly older than all before it takes
+// the pick without a draw.
+class cEldestScan
+{
+private:
+  cAvidaContext& m_ctx;
+  const Apto::Array<cOrganism*, Apto::Smart>& m_live_orgs;
+  const Apto::Array<cPopulationCell>& m_cells;
+  const int m_age_clock;
+  const int m_exclude_cell_id;
+  double m_max_msr;
+  int m_cell_id;
+
+public:
+  cEldestScan(cAvidaContext& ctx, const Apto::Array<cOrganism*, Apto::Smart>& live_orgs,
+              const Apto::Array<cPopulationCell>& cells, int age_clock, int exclude_cell_id)
+    : m_ctx(ctx), m_live_orgs(live_orgs), m_cells(cells), m_age_clock(age_clock), m_exclude_cell_id(exclude_cell_id)
+    , m_max_msr(0.0), m_cell_id(0) { ; }
+  
+  int GetCellID() const { return m_cell_id; }
+  
+  int GetOrigin(int slot) const { return m_age_clock - m_live_orgs[slot]->GetPhenotype().GetAge(); }
+  bool IsEligible(int slot) const
+  {
+    const int cell_id = m_live_orgs[slot]->GetCellID();
+    return m_cells[cell_id].IsOccupied() && cell_id != m_exclude_cell_id;
+  }
+  void Record(int slot, bool is_tie)
+  {
+    if (is_tie) {
+      const double msr = m_ctx.GetRandom().GetDouble();
+      if (msr <= m_max_msr) return;
+      m_max_msr = msr;
+    }
+    m_cell_id = m_live_orgs[slot]->GetCellID();
+  }
+};
+
+void cPopulation::RebuildEldestIndex()
+{
+  m_eldest_index.Clear();
+  for (int i = 0; i < live_org_list.GetSize(); i++) {
+    m_eldest_index.SetOrigin(i, m_age_clock - live_org_list[i]->GetPhenotype().GetAge());
+  }
+  m_eldest_index_active = true;
+}
+
+int cPopulation::FindEldestCell(cAvidaContext& ctx, int exclude_cell_id)
+{
+  if (!m_eldest_index_active) RebuildEldestIndex();
+  
+  cEldestScan scan(ctx, live_org_list, cell_array, m_age_clock, exclude_cell_id);
+  m_eldest_index.VisitRecords(scan, m_age_clock);
+  return scan.GetCellID();
+}
+
+
+int cPopulation::OrganismArena(int cell_id) const
+{
+  // Arena 0 is the shared free list; deme d allocates from arena d + 1
+  if (!m_world->GetConfig().DEMES_ORGANISM_ARENAS.Get() || deme_array.GetSize() < 2 || cell_id < 0) return 0;
+  return cell_array[cell_id].GetDemeID() + 1;
+}
+
+// Hands the deme's idle arena slabs back to the system allocator once its organisms have been replaced
+void cPopulation::ReleaseDemeArena(const cDeme& deme)
+{
+  const int arena = (deme.GetSize() > 0) ? OrganismArena(deme.GetCellID(0)) : 0;
+  if (arena > 0) cFreeListPool::ReleaseArena(arena);
+}
+
+
 // This function injects a new organism into the population at cell_id that
 // is an exact clone of the organism passed in.
 
@@ -7151,6 +7439,7 @@ void cPopulation::InjectClone(int cell_id, cOrganism& orig_org, Systematics::Sou
   
   cAvidaContext& ctx = m_world->GetDefaultContext();
   
+  cFreeListPool::cArenaScope arena(OrganismArena(cell_id));
   cOrganism* new_organism = new cOrganism(m_world, ctx, orig_org.GetGenome(), orig_org.GetPhenotype().GetGeneration(), src);
   Systematics::UnitPtr unit(new_organism);
   new_organism->AddReference(); // creating new smart pointer to new_organism, explicitly add reference
@@ -7165,7 +7454,7 @@ void cPopulation::InjectClone(int cell_id, cOrganism& orig_org, Systematics::Sou
   if (m_world->GetConfig().BIRTH_METHOD.Get() == POSITION_OFFSPRING_FULL_SOUP_ELDEST &&
       cell_array[cell_id].IsOccupied() == true) {
     // Have to manually take this cell out of the reaper Queue.
-    reaper_queue.Remove( &(cell_array[cell_id]) );
+    reaper_queue.Remove(cell_id);
   }
   
   // Setup the mutation rate based on the population cell...
@@ -7215,6 +7504,7 @@ void cPopulation::CompeteOrganisms_ConstructOffspring(int cell_id, cOrganism& pa
   Genome child_genome = parent.OffspringGenome();
   parent.GetHardware().Divide_TestFitnessMeasures(ctx);
   parent.OffspringGenome() = save_child;
+  cFreeListPool::cArenaScope arena(OrganismArena(cell_id));
   cOrganism* new_organism = new cOrganism(m_world, ctx, child_genome, parent.GetPhenotype().GetGeneration(), Systematics::Source(Systematics::DUPLICATION, ""));
   
   // Classify the offspring
@@ -7231,7 +7521,7 @@ void cPopulation::CompeteOrganisms_ConstructOffspring(int cell_id, cOrganism& pa
   if (m_world->GetConfig().BIRTH_METHOD.Get() == POSITION_OFFSPRING_FULL_SOUP_ELDEST &&
       cell_array[cell_id].IsOccupied() == true) {
     // Have to manually take this cell out of the reaper Queue.
-    reaper_queue.Remove( &(cell_array[cell_id]) );
+    reaper_queue.Remove(cell_id);
   }
   
   // Setup the mutation rate based on the population cell...
@@ -7258,6 +7548,7 @@ void cPopulation::InjectGenome(int cell_id, Systematics::Source src, const Genom
   }
   
   
+  cFreeListPool::cArenaScope arena(OrganismArena(cell_id));
   cOrganism* new_organism = new cOrganism(m_world, ctx, genome, -1, src);
   
   // Setup the phenotype...
@@ -7292,7 +7583,7 @@ void cPopulation::InjectGenome(int cell_id, Systematics::Source src, const Genom
   if (m_world->GetConfig().BIRTH_METHOD.Get() == POSITION_OFFSPRING_FULL_SOUP_ELDEST &&
       cell_array[cell_id].IsOccupied() == true) {
     // Have to manually take this cell out of the reaper Queue.
-    reaper_queue.Remove( &(cell_array[cell_id]) );
+    reaper_queue.Remove(cell_id);
   }
   
   // Setup the child's mutation rates.  Since this organism is being injected
@@ -8345,6 +8636,7 @@ void  cPopulation::AddLiveOrg(cOrganism* org)
 {
   live_org_list.Push(org);
   org->SetOrgIndex(live_org_list.GetSize()-1);
+  if (m_eldest_index_active) m_eldest_index.SetOrigin(live_org_list.GetSize() - 1, cEldestIndex::UNKNOWN_ORIGIN);
 }
 
 // Remove an organism from live org list  
@@ -8352,6 +8644,10 @@ void  cPopulation::RemoveLiveOrg(cOrganism* org)
 {
   unsigned int last = live_org_list.GetSize() - 1;
   cOrganism* exist_org = live_org_list[last];
+  if (m_eldest_index_active) {
+    m_eldest_index.SetOrigin(org->GetOrgIndex(), m_eldest_index.GetOrigin(last));
+    m_eldest_index.ClearSlot(last);
+  }
   exist_org->SetOrgIndex(org->GetOrgIndex());
   live_org_list.Swap(org->GetOrgIndex(), last);
   live_org_list.Pop();
@@ -26,7 +26,11 @@
 #include "avida/data/Provider.h"
 
 #include "cBirthChamber.h"
+#include "cCellQueue.h"
+#include "cCellTopology.h"
 #include "cDeme.h"
+#include "cEldestIndex.h"
+#include "cEmptyCellSet.h"
 #include "cOrgInterface.h"
 #include "cPopulationInterface.h"
 #include "cResourceCount.h"
@@ -44,6 +48,7 @@ class cEnvironment;
 class cLineage;
 class cOrganism;
 class cPopulationCell;
+class cPopulationCheckpoint;
 
 using namespace Avida;
 
@@ -67,7 +72,9 @@ private:
   cWorld* m_world;
   Apto::PriorityScheduler* m_scheduler;                // Handles allocation of CPU cycles
   Apto::Array<cPopulationCell> cell_array;  // Local cells composing the population
+  cCellTopology m_cell_topology;            // Neighbor connections of the cells in cell_array
   Apto::Array<int> empty_cell_id_array;     // Used for PREFER_EMPTY birth methods
+  cEmptyCellSet m_empty_cells;              // Empty cells of each deme, for PREFER_EMPTY with demes
   cResourceCount resource_count;       // Global resources available
   cBirthChamber birth_chamber;         // Global birth chamber.
   //Keeps track of which organisms are in which group.
@@ -89,7 +96,10 @@ private:
   Apto::Array<GeneticRepresentationPtr> host_genotype_list;
   
   // Data Tracking...
-  tList<cPopulationCell> reaper_queue; // Death order in some mass-action runs
+  cCellQueue reaper_queue; // Death order in some mass-action runs
+  cEldestIndex m_eldest_index; // Age origins by live_org_list slot, for POP_CAP_ELDEST
+  bool m_eldest_index_active;
+  int m_age_clock;             // Number of times the ages of all organisms have been incremented
   Apto::Array<int, Apto::Smart> minitrace_queue;
   bool print_mini_trace_genomes;
   bool print_mini_trace_reacs;
@@ -123,6 +133,8 @@ private:
 
   int m_hgt_resid; //!< HGT resource ID.
 
+  cPopulationCheckpoint* m_checkpoint_writer; //!< Binary population save still being written in the background.
+
   cPopulation(); // @not_implemented
   cPopulation(const cPopulation&); // @not_implemented
   cPopulation& operator=(const cPopulation&); // @not_implemented
@@ -264,6 +276,7 @@ public:
   void ProcessPreUpdate();
   void UpdateResStats(cAvidaContext& ctx);
   void ProcessUpdateCellActions(cAvidaContext& ctx);
+  void ProcessPointMutations(cAvidaContext& ctx);
 
   // Clear all but a subset of cells...
   void SerialTransfer(int transfer_size, bool ignore_deads, cAvidaContext& ctx); 
@@ -274,6 +287,9 @@ public:
 
   bool SavePopulation(const cString& filename, bool save_historic, bool save_group_info = false, bool save_avatars = false,
                       bool save_rebirth = false);
+  bool SavePopulationBinary(const cString& filename, bool save_historic, bool save_group_info = false, bool save_avatars = false,
+                            bool save_rebirth = false, bool background = true);
+  bool FinishPopulationSave();
   bool SaveStructuredSystematicsGroup(const Systematics::RoleID& role, const cString& filename);
   bool LoadStructuredSystematicsGroup(cAvidaContext& ctx, const Systematics::RoleID& role, const cString& filename);
   bool LoadPopulation(const cString& filename, cAvidaContext& ctx, int cellid_offset=0, int lineage_offset=0,
@@ -301,6 +317,10 @@ public:
   cDeme& GetDeme(int i) { return deme_array[i]; }
 
   cPopulationCell& GetCell(int in_num) { return cell_array[in_num]; }
+
+  // Called by cPopulationCell whenever an organism is placed in or removed from a cell
+  void CellFilled(int cell_id) { m_empty_cells.Remove(cell_id); }
+  void CellEmptied(int cell_id) { m_empty_cells.Insert(cell_id); }
   const Apto::Array<double>& GetResources(cAvidaContext& ctx) const { return resource_count.GetResources(ctx); }
   const Apto::Array<double>& GetCellResources(int cell_id, cAvidaContext& ctx) const { return resource_count.GetCellResources(cell_id, ctx); } 
   const Apto::Array<double>& GetFrozenResources(cAvidaContext& ctx, int cell_id) const { return resource_count.GetFrozenResources(ctx, cell_id); }
@@ -451,14 +471,17 @@ private:
   
   // Methods to place offspring in the population.
   cPopulationCell& PositionOffspring(cPopulationCell& parent_cell, cAvidaContext& ctx, bool parent_ok = true); 
-  void PositionAge(cPopulationCell& parent_cell, tList<cPopulationCell>& found_list, bool parent_ok);
-  void PositionMerit(cPopulationCell & parent_cell, tList<cPopulationCell>& found_list, bool parent_ok);
-  void PositionEnergyUsed(cPopulationCell & parent_cell, tList<cPopulationCell>& found_list, bool parent_ok);
+  void PositionAge(cPopulationCell& parent_cell, Apto::Array<cPopulationCell*, Apto::Smart>& found_list, bool parent_ok);
+  void PositionMerit(cPopulationCell& parent_cell, Apto::Array<cPopulationCell*, Apto::Smart>& found_list, bool parent_ok);
+  void PositionEnergyUsed(cPopulationCell& parent_cell, Apto::Array<cPopulationCell*, Apto::Smart>& found_list, bool parent_ok);
   cPopulationCell& PositionDemeMigration(cPopulationCell& parent_cell, bool parent_ok = true);
   cPopulationCell& PositionDemeRandom(int deme_id, cPopulationCell& parent_cell, bool parent_ok = true);
-  int UpdateEmptyCellIDArray(int deme_id = -1);
+  void FindEmptyCell(const cPopulationCell& cell, Apto::Array<cPopulationCell*, Apto::Smart>& found_list);
+  
+  // Eldest organism index (POP_CAP_ELDEST)
+  void RebuildEldestIndex();
+  int FindEldestCell(cAvidaContext& ctx, int exclude_cell_id);
   Apto::Array<int>& GetEmptyCellIDArray() { return empty_cell_id_array; }
-  void FindEmptyCell(tList<cPopulationCell>& cell_list, tList<cPopulationCell>& found_list);
   int FindRandEmptyCell(cAvidaContext& ctx);
   
   // Update statistics collecting...
@@ -469,6 +492,8 @@ private:
   
   void InjectClone(int cell_id, cOrganism& orig_org, Systematics::Source src);
   void CompeteOrganisms_ConstructOffspring(int cell_id, cOrganism& parent);
+  int OrganismArena(int cell_id) const; // allocation arena for organisms created for the cell (DEMES_ORGANISM_ARENAS)
+  void ReleaseDemeArena(const cDeme& deme);
   
   //! Helper method that adds a founder organism to a deme, and sets up its phenotype
   void SeedDeme_InjectDemeFounder(int _cell_id, Systematics::GroupPtr bg, cAvidaContext& ctx, cPhenotype* _phenotype = NULL, int lineage_label=0, bool reset=false); 
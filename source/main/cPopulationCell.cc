@@ -41,6 +41,8 @@ cPopulationCell::cPopulationCell(const cPopulationCell& in_cell)
 : m_world(in_cell.m_world)
 , m_organism(in_cell.m_organism)
 , m_hardware(in_cell.m_hardware)
+, m_topology(in_cell.m_topology)
+, m_rotation(in_cell.m_rotation)
 , m_inputs(in_cell.m_inputs)
 , m_cell_id(in_cell.m_cell_id)
 , m_deme_id(in_cell.m_deme_id)
@@ -53,11 +55,6 @@ cPopulationCell::cPopulationCell(const cPopulationCell& in_cell)
   // Copy the mutation rates into a new structure
   m_mut_rates = new cMutationRates(*in_cell.m_mut_rates);
 	
-  // Copy the connection list
-  tConstListIterator<cPopulationCell> conn_it(in_cell.m_connections);
-  cPopulationCell* test_cell;
-  while ((test_cell = const_cast<cPopulationCell*>(conn_it.Next()))) m_connections.PushRear(test_cell);
-	
 	// copy the hgt information, if needed.
 	if(in_cell.m_hgt) {
 		InitHGTSupport();
@@ -71,6 +68,8 @@ void cPopulationCell::operator=(const cPopulationCell& in_cell)
 		m_world = in_cell.m_world;
 		m_organism = in_cell.m_organism;
 		m_hardware = in_cell.m_hardware;
+		m_topology = in_cell.m_topology;
+		m_rotation = in_cell.m_rotation;
 		m_inputs = in_cell.m_inputs;
 		m_cell_id = in_cell.m_cell_id;
 		m_deme_id = in_cell.m_deme_id;
@@ -85,11 +84,6 @@ void cPopulationCell::operator=(const cPopulationCell& in_cell)
 		else
 			m_mut_rates->Copy(*in_cell.m_mut_rates);
 		
-		// Copy the connection list
-		tConstListIterator<cPopulationCell> conn_it(in_cell.m_connections);
-		cPopulationCell* test_cell;
-		while ((test_cell = const_cast<cPopulationCell*>(conn_it.Next()))) m_connections.PushRear(test_cell);
-		
 		// copy hgt information, if needed.
 		delete m_hgt;
 		m_hgt = 0;
@@ -129,15 +123,26 @@ void cPopulationCell::Rotate(cPopulationCell& new_facing)
     return;
   }
 	
-#ifdef DEBUG
-  int scan_count = 0;
-#endif
-  while (m_connections.GetFirst() != &new_facing) {
-    m_connections.CircNext();
-#ifdef DEBUG
-    assert(++scan_count < m_connections.GetSize());
-#endif
-  }
+  const int pos = m_topology->FindNeighbor(m_cell_id, new_facing.GetID(), m_rotation);
+  assert(pos >= 0);
+  if (pos >= 0) m_rotation = pos;
+}
+
+void cPopulationCell::AddConnection(cPopulationCell& cell, bool faced)
+{
+  // Inserting just ahead of the faced cell places the new neighbor last in facing order, unless it is to be faced
+  m_topology->InsertConnection(m_cell_id, m_rotation, cell.GetID());
+  if (!faced && GetNumNeighbors() > 1) m_rotation++;
+}
+
+void cPopulationCell::RemoveConnection(cPopulationCell& cell)
+{
+  const int pos = m_topology->FindNeighbor(m_cell_id, cell.GetID(), m_rotation);
+  if (pos < 0) return;
+
+  m_topology->RemoveConnection(m_cell_id, pos);
+  if (pos < m_rotation) m_rotation--;
+  if (m_rotation >= GetNumNeighbors()) m_rotation = 0;
 }
 
 /*! This method recursively builds a set of cells that neighbor this cell, out to 
@@ -147,12 +152,11 @@ void cPopulationCell::Rotate(cPopulationCell& new_facing)
 void cPopulationCell::GetNeighboringCells(std::set<cPopulationCell*>& cell_set, int depth) const {
 	typedef std::set<cPopulationCell*> cell_set_t;
   
-  // For each cell in our connection list...
-  tConstListIterator<cPopulationCell> i(m_connections);
-  while(!i.AtEnd()) {
+  // For each of our neighbors...
+  const int num_neighbors = GetNumNeighbors();
+  for (int i = 0; i < num_neighbors; i++) {
 		// store the cell pointer, and check to see if we've already visited that cell...
-    cPopulationCell* cell = i.Next();
-		assert(cell != 0); // cells should never be null.
+    cPopulationCell* cell = &GetNeighbor(i);
 		std::pair<cell_set_t::iterator, bool> ins = cell_set.insert(cell);
 		// and if so, recurse to it...
 		if(ins.second && (depth > 1)) {
@@ -176,13 +180,12 @@ void cPopulationCell::GetOccupiedNeighboringCells(std::set<cPopulationCell*>& oc
 
 void cPopulationCell::GetOccupiedNeighboringCells(Apto::Array<cPopulationCell*>& occupied_cells) const
 {
-  occupied_cells.Resize(m_connections.GetSize());
+  const int num_neighbors = GetNumNeighbors();
+  occupied_cells.Resize(num_neighbors);
   int occupied_count = 0;
 
-  tLWConstListIterator<cPopulationCell> i(m_connections);
-  while(!i.AtEnd()) {
-    cPopulationCell* cell = i.Next();
-		assert(cell); // cells should never be null.
+  for (int i = 0; i < num_neighbors; i++) {
+    cPopulationCell* cell = &GetNeighbor(i);
     if (cell->IsOccupied()) occupied_cells[occupied_count++] = cell;
   }
   
@@ -207,7 +210,7 @@ void cPopulationCell::GetOccupiedNeighboringCells(Apto::Array<cPopulationCell*>&
 int cPopulationCell::GetFacing()
 {
   // This whole function is a hack.
-	cPopulationCell* faced = ConnectionList().GetFirst();
+	cPopulationCell* faced = &GetCellFaced();
 	
 	int x=0,y=0,lr=0,du=0;
 	faced->GetPosition(x,y);
@@ -267,6 +270,7 @@ void cPopulationCell::InsertOrganism(cOrganism* new_org, cAvidaContext& ctx)
   // Adjust this cell's attributes to account for the new organism.
   m_organism = new_org;
   m_hardware = &new_org->GetHardware();
+  m_world->GetPopulation().CellFilled(m_cell_id);
   m_world->GetStats().AddSpeculativeWaste(m_spec_state);
   m_spec_state = 0;
 	
@@ -303,6 +307,7 @@ cOrganism * cPopulationCell::RemoveOrganism(cAvidaContext& ctx)
   }
   m_organism = NULL;
   m_hardware = NULL;
+  m_world->GetPopulation().CellEmptied(m_cell_id);
   return out_organism;
 }
 
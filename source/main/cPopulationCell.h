@@ -29,6 +29,7 @@
 #include <set>
 #include <deque>
 
+#include "cCellTopology.h"
 #include "cMutationRates.h"
 #include "tList.h"
 #include "cGenomeUtil.h"
@@ -45,6 +46,7 @@ using namespace Avida;
 class cPopulationCell
 {
   friend class cPopulation;
+  friend class cCellTopology;
 
 private:
   cWorld* m_world;
@@ -52,7 +54,8 @@ private:
   cOrganism* m_organism;                    // The occupent of this cell.
   cHardwareBase* m_hardware;
 
-  tList<cPopulationCell> m_connections;  // A list of neighboring cells.
+  cCellTopology* m_topology;             // Shared neighbor connections of all cells.
+  int m_rotation;                        // Position of the faced cell among this cell's neighbors.
   cMutationRates* m_mut_rates;           // Mutation rates at this cell.
   Apto::Array<int> m_inputs;                 // Environmental Inputs...
 
@@ -86,7 +89,7 @@ private:
 public:
   typedef std::set<cPopulationCell*> neighborhood_type; //!< Type for cell neighborhoods.
 
-  cPopulationCell() : m_world(NULL), m_organism(NULL), m_hardware(NULL), m_mut_rates(NULL), m_migrant(false), m_can_input(false), m_can_output(false), m_hgt(0) { ; }
+  cPopulationCell() : m_world(NULL), m_organism(NULL), m_hardware(NULL), m_topology(NULL), m_rotation(0), m_mut_rates(NULL), m_migrant(false), m_can_input(false), m_can_output(false), m_hgt(0) { ; }
   cPopulationCell(const cPopulationCell& in_cell);
   ~cPopulationCell() { delete m_mut_rates; delete m_hgt; }
 
@@ -95,6 +98,13 @@ public:
   void Setup(cWorld* world, int in_id, const cMutationRates& in_rates, int x, int y);
   void SetDemeID(int in_id) { m_deme_id = in_id; }
   void Rotate(cPopulationCell& new_facing);
+  inline void RotateFacing(int steps = 1);  // Turn to face the neighbor steps positions further along (or back, if negative).
+
+  // Connections are normally established by the topology builders, these are for actions that alter the topology.
+  // New neighbors are added last in facing order, or are faced immediately if faced is true.
+  void AddConnection(cPopulationCell& cell, bool faced = false);
+  void RemoveConnection(cPopulationCell& cell);
+  bool HasConnection(const cPopulationCell& cell) const { return m_topology->FindNeighbor(m_cell_id, cell.GetID()) >= 0; }
 
   //@AWC -- This is, admittedly, a hack to get migration between demes working under local copy...
   void SetMigrant() {m_migrant = true;} //@AWC -- this cell will contain a migrant genome
@@ -103,13 +113,16 @@ public:
 
   inline cOrganism* GetOrganism() const { return m_organism; }
   inline cHardwareBase* GetHardware() const { return m_hardware; }
-  inline tList<cPopulationCell>& ConnectionList() { return m_connections; }
+  //! Neighbors are numbered in facing order, starting with the currently faced cell.
+  inline int GetNumNeighbors() const { return m_topology->GetNumNeighbors(m_cell_id); }
+  inline int GetNeighborID(int idx) const;
+  inline cPopulationCell& GetNeighbor(int idx) const;
   //! Recursively build a set of cells that neighbor this one, out to the given depth.
   void GetNeighboringCells(std::set<cPopulationCell*>& cell_set, int depth) const;
   //! Recursively build a set of occupied cells that neighbor this one, out to the given depth.
   void GetOccupiedNeighboringCells(std::set<cPopulationCell*>& occupied_cell_set, int depth) const;
   void GetOccupiedNeighboringCells(Apto::Array<cPopulationCell*>& occupied_cells) const;
-  inline cPopulationCell& GetCellFaced() { return *(m_connections.GetFirst()); }
+  inline cPopulationCell& GetCellFaced() const { return GetNeighbor(0); }
   int GetFacing();  // Returns the facing of this cell.
   int GetFacedDir(); // Returns the human interpretable facing of this org.
   inline void GetPosition(int& x, int& y) const { x = m_x; y = m_y; } // Retrieves the position (x,y) coordinates of this cell.
@@ -211,6 +224,28 @@ private:
   inline bool IsHGTInitialized() const { return m_hgt != 0; }
 };
 
+inline int cPopulationCell::GetNeighborID(int idx) const
+{
+  const int num_neighbors = GetNumNeighbors();
+  assert(idx >= 0 && idx < num_neighbors);
+  int pos = m_rotation + idx;
+  if (pos >= num_neighbors) pos -= num_neighbors;
+  return m_topology->GetNeighborID(m_cell_id, pos);
+}
+
+inline cPopulationCell& cPopulationCell::GetNeighbor(int idx) const
+{
+  return m_topology->GetCells()[GetNeighborID(idx)];
+}
+
+inline void cPopulationCell::RotateFacing(int steps)
+{
+  const int num_neighbors = GetNumNeighbors();
+  if (num_neighbors == 0) return;
+  m_rotation = (m_rotation + steps) % num_neighbors;
+  if (m_rotation < 0) m_rotation += num_neighbors;
+}
+
 inline int cPopulationCell::GetInputAt(int& input_pointer)
 {
   input_pointer %= m_inputs.GetSize();
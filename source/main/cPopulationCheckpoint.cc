@@ -0,0 +1,426 @@
+/*
+ *  cPopulationCheckpoint.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cPopulationCheckpoint.h"
+
+#include "avida/core/Feedback.h"
+
+#include <cassert>
+#include <cstring>
+#include <fstream>
+
+
+static const char s_checkpoint_magic[8] = { 'A', 'V', 'D', 'S', 'P', 'O', 'P', 'B' };
+
+static const unsigned char GROUP_PARASITE = 0x1;
+static const unsigned char GROUP_HISTORIC = 0x2;
+
+
+// Byte level encoding helpers
+// --------------------------------------------------------------------------------------------------------------
+
+static inline void putVarUInt(Apto::Array<unsigned char, Apto::Smart>& buf, unsigned int value)
+{
+  while (value >= 0x80) {
+    buf.Push((unsigned char)(value | 0x80));
+    value >>= 7;
+  }
+  buf.Push((unsigned char)value);
+}
+
+static inline void putVarInt(Apto::Array<unsigned char, Apto::Smart>& buf, int value)
+{
+  // zig-zag encode so that small negative values (-1 is the common 'unset' marker) stay short
+  putVarUInt(buf, ((unsigned int)value << 1) ^ (unsigned int)(value >> 31));
+}
+
+static inline void putUInt32(Apto::Array<unsigned char, Apto::Smart>& buf, unsigned int value)
+{
+  for (int i = 0; i < 4; i++) buf.Push((unsigned char)((value >> (8 * i)) & 0xFF));
+}
+
+static inline void putDouble(Apto::Array<unsigned char, Apto::Smart>& buf, double value)
+{
+  unsigned char bytes[sizeof(double)];
+  memcpy(bytes, &value, sizeof(double));
+  for (unsigned int i = 0; i < sizeof(double); i++) buf.Push(bytes[i]);
+}
+
+static inline void putString(Apto::Array<unsigned char, Apto::Smart>& buf, const Apto::String& str)
+{
+  putVarUInt(buf, str.GetSize());
+  for (int i = 0; i < str.GetSize(); i++) buf.Push((unsigned char)str[i]);
+}
+
+
+class cCheckpointReader
+{
+private:
+  const unsigned char* m_data;
+  int m_size;
+  int m_pos;
+  bool m_ok;
+
+public:
+  cCheckpointReader(const unsigned char* data, int size) : m_data(data), m_size(size), m_pos(0), m_ok(true) { ; }
+
+  bool IsOK() const { return m_ok; }
+  bool AtEnd() const { return m_pos >= m_size; }
+
+  unsigned int GetVarUInt()
+  {
+    unsigned int value = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+      if (m_pos >= m_size) { m_ok = false; return 0; }
+      unsigned char b = m_data[m_pos++];
+      value |= (unsigned int)(b & 0x7F) << shift;
+      if (!(b & 0x80)) return value;
+    }
+    m_ok = false;
+    return 0;
+  }
+
+  int GetVarInt()
+  {
+    unsigned int value = GetVarUInt();
+    return (int)(value >> 1) ^ -(int)(value & 0x1);
+  }
+
+  unsigned char GetByte()
+  {
+    if (m_pos >= m_size) { m_ok = false; return 0; }
+    return m_data[m_pos++];
+  }
+
+  double GetDouble()
+  {
+    double value = 0.0;
+    if (m_pos + (int)sizeof(double) > m_size) { m_ok = false; return value; }
+    memcpy(&value, m_data + m_pos, sizeof(double));
+    m_pos += sizeof(double);
+    return value;
+  }
+};
+
+
+static bool readUInt32(std::istream& fp, unsigned int& value)
+{
+  unsigned char bytes[4];
+  if (!fp.read((char*)bytes, 4)) return false;
+  value = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((unsigned int)bytes[3] << 24);
+  return true;
+}
+
+static bool readVarUInt(std::istream& fp, unsigned int& value)
+{
+  value = 0;
+  for (int shift = 0; shift < 35; shift += 7) {
+    int b = fp.get();
+    if (b == EOF) return false;
+    value |= (unsigned int)(b & 0x7F) << shift;
+    if (!(b & 0x80)) return true;
+  }
+  return false;
+}
+
+static bool readString(std::istream& fp, Apto::String& str)
+{
+  unsigned int size = 0;
+  if (!readVarUInt(fp, size)) return false;
+  Apto::Array<char> buf(size + 1);
+  if (size && !fp.read(&buf[0], size)) return false;
+  buf[size] = '\0';
+  str = &buf[0];
+  return true;
+}
+
+
+
+// cPopulationCheckpoint
+// --------------------------------------------------------------------------------------------------------------
+
+bool cPopulationCheckpoint::IsCheckpointFile(const Apto::String& path)
+{
+  std::ifstream fp((const char*)path, std::ios::in | std::ios::binary);
+  if (!fp.good()) return false;
+
+  char magic[sizeof(s_checkpoint_magic)];
+  if (!fp.read(magic, sizeof(magic))) return false;
+  return (memcmp(magic, s_checkpoint_magic, sizeof(magic)) == 0);
+}
+
+
+int cPopulationCheckpoint::AddGroup(Apto::SmartPtr<Apto::Map<Apto::String, Apto::String> > props, bool parasite, bool historic)
+{
+  sGroupRecord rec;
+  rec.props = props;
+  rec.parasite = parasite;
+  rec.historic = historic;
+  m_groups.Push(rec);
+  return m_groups.GetSize() - 1;
+}
+
+
+bool cPopulationCheckpoint::Write(const Apto::String& path)
+{
+  m_path = path;
+  std::ofstream fp((const char*)m_path, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!fp.good()) {
+    m_success = false;
+    return false;
+  }
+
+  m_success = writeTo(fp);
+  fp.close();
+  return m_success;
+}
+
+
+void cPopulationCheckpoint::Run()
+{
+  Write(m_path);
+}
+
+
+bool cPopulationCheckpoint::writeTo(std::ostream& fp) const
+{
+  // Determine chunk boundaries, each covering a fixed range of cell ids
+  Apto::Array<int, Apto::Smart> chunk_starts;
+  for (int i = 0; i < m_orgs.GetSize(); i++) {
+    assert(i == 0 || m_orgs[i - 1].cell_id <= m_orgs[i].cell_id);
+    if (i == 0 || (m_orgs[i].cell_id / m_chunk_cells) != (m_orgs[i - 1].cell_id / m_chunk_cells)) chunk_starts.Push(i);
+  }
+
+  Apto::Array<unsigned char, Apto::Smart> buf;
+
+  // Header
+  for (unsigned int i = 0; i < sizeof(s_checkpoint_magic); i++) buf.Push((unsigned char)s_checkpoint_magic[i]);
+  putUInt32(buf, VERSION);
+  putUInt32(buf, m_flags);
+  putUInt32(buf, m_world_size);
+  putUInt32(buf, m_chunk_cells);
+  putUInt32(buf, m_groups.GetSize());
+  putUInt32(buf, chunk_starts.GetSize());
+
+  // Group table
+  for (int g = 0; g < m_groups.GetSize(); g++) {
+    const sGroupRecord& rec = m_groups[g];
+    unsigned char kind = 0;
+    if (rec.parasite) kind |= GROUP_PARASITE;
+    if (rec.historic) kind |= GROUP_HISTORIC;
+    buf.Push(kind);
+
+    putVarUInt(buf, rec.props->GetSize());
+    for (Apto::Map<Apto::String, Apto::String>::Iterator it = rec.props->Begin(); it.Next() != NULL;) {
+      putString(buf, it.Get()->Value1());
+      putString(buf, *it.Get()->Value2());
+    }
+
+    // Flush periodically, so that large historic tables do not accumulate in memory
+    if (buf.GetSize() > (1 << 20)) {
+      if (!fp.write((const char*)&buf[0], buf.GetSize())) return false;
+      buf.Resize(0);
+    }
+  }
+  if (buf.GetSize() && !fp.write((const char*)&buf[0], buf.GetSize())) return false;
+
+  // Organism chunks
+  Apto::Array<unsigned char, Apto::Smart> payload;
+  for (int c = 0; c < chunk_starts.GetSize(); c++) {
+    const int begin = chunk_starts[c];
+    const int end = (c + 1 < chunk_starts.GetSize()) ? chunk_starts[c + 1] : m_orgs.GetSize();
+    const int first_cell = (m_orgs[begin].cell_id / m_chunk_cells) * m_chunk_cells;
+
+    payload.Resize(0);
+    encodeChunk(begin, end, first_cell, payload);
+
+    buf.Resize(0);
+    putVarUInt(buf, first_cell);
+    putVarUInt(buf, end - begin);
+    putVarUInt(buf, payload.GetSize());
+    if (!fp.write((const char*)&buf[0], buf.GetSize())) return false;
+    if (payload.GetSize() && !fp.write((const char*)&payload[0], payload.GetSize())) return false;
+  }
+
+  return fp.good();
+}
+
+
+void cPopulationCheckpoint::encodeChunk(int begin, int end, int first_cell, Apto::Array<unsigned char, Apto::Smart>& buf) const
+{
+  const bool save_groupings = (m_flags & (SAVE_GROUPINGS | SAVE_REBIRTH));
+  const bool save_avatars = (m_flags & (SAVE_AVATARS | SAVE_REBIRTH));
+  const bool save_rebirth = (m_flags & SAVE_REBIRTH);
+
+  // Columns are stored contiguously, which keeps the delta encoded cell ids and the mostly constant fields short
+  int prev_cell = first_cell;
+  for (int i = begin; i < end; i++) {
+    putVarUInt(buf, m_orgs[i].cell_id - prev_cell);
+    prev_cell = m_orgs[i].cell_id;
+  }
+  for (int i = begin; i < end; i++) putVarUInt(buf, m_orgs[i].group);
+  for (int i = begin; i < end; i++) putVarInt(buf, m_orgs[i].offset);
+  for (int i = begin; i < end; i++) putVarInt(buf, m_orgs[i].lineage_label);
+
+  if (save_groupings) {
+    for (int i = begin; i < end; i++) putVarInt(buf, m_orgs[i].curr_group);
+    for (int i = begin; i < end; i++) putVarInt(buf, m_orgs[i].curr_forage);
+    for (int i = begin; i < end; i++) putVarInt(buf, m_orgs[i].birth_cell);
+  }
+  if (save_avatars) {
+    for (int i = begin; i < end; i++) putVarInt(buf, m_orgs[i].avatar_cell);
+    for (int i = begin; i < end; i++) putVarInt(buf, m_orgs[i].av_bcell);
+  }
+  if (save_rebirth) {
+    for (int i = begin; i < end; i++) putVarInt(buf, m_orgs[i].parent_ft);
+    for (int i = begin; i < end; i++) buf.Push((unsigned char)m_orgs[i].parent_is_teacher);
+    for (int i = begin; i < end; i++) putDouble(buf, m_orgs[i].parent_merit);
+  }
+}
+
+
+bool cPopulationCheckpoint::decodeChunk(const Apto::Array<unsigned char, Apto::Smart>& buf, int num_records, int first_cell)
+{
+  const bool save_groupings = (m_flags & (SAVE_GROUPINGS | SAVE_REBIRTH));
+  const bool save_avatars = (m_flags & (SAVE_AVATARS | SAVE_REBIRTH));
+  const bool save_rebirth = (m_flags & SAVE_REBIRTH);
+
+  const int begin = m_orgs.GetSize();
+  const int end = begin + num_records;
+  m_orgs.Resize(end);
+
+  cCheckpointReader rd((buf.GetSize()) ? &buf[0] : NULL, buf.GetSize());
+
+  int prev_cell = first_cell;
+  for (int i = begin; i < end; i++) {
+    sOrgRecord& rec = m_orgs[i];
+    rec.cell_id = prev_cell + rd.GetVarUInt();
+    prev_cell = rec.cell_id;
+
+    // Defaults match the values used by the text format for columns that were not saved
+    rec.curr_group = -1;
+    rec.curr_forage = -1;
+    rec.birth_cell = 0;
+    rec.avatar_cell = -1;
+    rec.av_bcell = -1;
+    rec.parent_ft = -1;
+    rec.parent_is_teacher = 0;
+    rec.parent_merit = 1;
+  }
+  for (int i = begin; i < end; i++) m_orgs[i].group = rd.GetVarUInt();
+  for (int i = begin; i < end; i++) m_orgs[i].offset = rd.GetVarInt();
+  for (int i = begin; i < end; i++) m_orgs[i].lineage_label = rd.GetVarInt();
+
+  if (save_groupings) {
+    for (int i = begin; i < end; i++) m_orgs[i].curr_group = rd.GetVarInt();
+    for (int i = begin; i < end; i++) m_orgs[i].curr_forage = rd.GetVarInt();
+    for (int i = begin; i < end; i++) m_orgs[i].birth_cell = rd.GetVarInt();
+  }
+  if (save_avatars) {
+    for (int i = begin; i < end; i++) m_orgs[i].avatar_cell = rd.GetVarInt();
+    for (int i = begin; i < end; i++) m_orgs[i].av_bcell = rd.GetVarInt();
+  }
+  if (save_rebirth) {
+    for (int i = begin; i < end; i++) m_orgs[i].parent_ft = rd.GetVarInt();
+    for (int i = begin; i < end; i++) m_orgs[i].parent_is_teacher = rd.GetByte();
+    for (int i = begin; i < end; i++) m_orgs[i].parent_merit = rd.GetDouble();
+  }
+
+  if (!rd.IsOK() || !rd.AtEnd()) return false;
+  for (int i = begin; i < end; i++) if (m_orgs[i].group < 0 || m_orgs[i].group >= m_groups.GetSize()) return false;
+  return true;
+}
+
+
+bool cPopulationCheckpoint::Read(const Apto::String& path, Avida::Feedback& feedback)
+{
+  m_path = path;
+  m_groups.Resize(0);
+  m_orgs.Resize(0);
+
+  std::ifstream fp((const char*)path, std::ios::in | std::ios::binary);
+  if (!fp.good()) {
+    feedback.Error("unable to open file '%s'.", (const char*)path);
+    return false;
+  }
+
+  char magic[sizeof(s_checkpoint_magic)];
+  if (!fp.read(magic, sizeof(magic)) || memcmp(magic, s_checkpoint_magic, sizeof(magic)) != 0) {
+    feedback.Error("'%s' is not a binary population checkpoint", (const char*)path);
+    return false;
+  }
+
+  unsigned int version, flags, world_size, chunk_cells, num_groups, num_chunks;
+  if (!readUInt32(fp, version) || !readUInt32(fp, flags) || !readUInt32(fp, world_size) || !readUInt32(fp, chunk_cells) ||
+      !readUInt32(fp, num_groups) || !readUInt32(fp, num_chunks)) {
+    feedback.Error("truncated header in population checkpoint '%s'", (const char*)path);
+    return false;
+  }
+  if (version > (unsigned int)VERSION) {
+    feedback.Error("population checkpoint '%s' has unsupported version %u", (const char*)path, version);
+    return false;
+  }
+
+  m_flags = flags;
+  m_world_size = world_size;
+  m_chunk_cells = chunk_cells;
+
+  m_groups.Resize(num_groups);
+  for (unsigned int g = 0; g < num_groups; g++) {
+    sGroupRecord& rec = m_groups[g];
+    int kind = fp.get();
+    unsigned int num_props = 0;
+    if (kind == EOF || !readVarUInt(fp, num_props)) {
+      feedback.Error("truncated group table in population checkpoint '%s'", (const char*)path);
+      return false;
+    }
+    rec.parasite = (kind & GROUP_PARASITE);
+    rec.historic = (kind & GROUP_HISTORIC);
+    rec.props = Apto::SmartPtr<Apto::Map<Apto::String, Apto::String> >(new Apto::Map<Apto::String, Apto::String>);
+    for (unsigned int p = 0; p < num_props; p++) {
+      Apto::String key, value;
+      if (!readString(fp, key) || !readString(fp, value)) {
+        feedback.Error("truncated group table in population checkpoint '%s'", (const char*)path);
+        return false;
+      }
+      rec.props->Set(key, value);
+    }
+  }
+
+  Apto::Array<unsigned char, Apto::Smart> payload;
+  for (unsigned int c = 0; c < num_chunks; c++) {
+    unsigned int first_cell, num_records, payload_size;
+    if (!readVarUInt(fp, first_cell) || !readVarUInt(fp, num_records) || !readVarUInt(fp, payload_size)) {
+      feedback.Error("truncated cell chunk in population checkpoint '%s'", (const char*)path);
+      return false;
+    }
+    payload.Resize(payload_size);
+    if (payload_size && !fp.read((char*)&payload[0], payload_size)) {
+      feedback.Error("truncated cell chunk in population checkpoint '%s'", (const char*)path);
+      return false;
+    }
+    if (!decodeChunk(payload, num_records, first_cell)) {
+      feedback.Error("corrupt cell chunk in population checkpoint '%s'", (const char*)path);
+      return false;
+    }
+  }
+
+  return true;
+}
@@ -0,0 +1,145 @@
+/*
+ *  cPopulationCheckpoint.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cPopulationCheckpoint_h
+#define cPopulationCheckpoint_h
+
+#include "apto/core.h"
+#include "apto/core/Thread.h"
+
+#include <iostream>
+
+namespace Avida {
+  class Feedback;
+};
+
+
+// cPopulationCheckpoint - binary, versioned equivalent of the structured population (spop) save
+//
+// File layout (all fixed width fields little endian, variable width fields LEB128 varints, signed values zig-zag encoded):
+//   header    - magic "AVDSPOPB", version, flags, world size, chunk size (in cells), group count, chunk count
+//   groups    - per group: kind byte (parasite/historic), property count, then key/value string pairs as saved by
+//               Systematics::Group::LegacySaveProperties
+//   chunks    - organism records for a contiguous range of cell ids, each prefixed with first cell, record count and
+//               payload size; payload is stored column-wise with cell ids delta encoded against the previous record
+//
+// A checkpoint object is either filled from a live population (on the main thread) and then written, optionally on its
+// own thread so that the run can continue, or filled by Read() when loading.
+class cPopulationCheckpoint : public Apto::Thread
+{
+public:
+  enum {
+    SAVE_GROUPINGS = 0x1,
+    SAVE_AVATARS = 0x2,
+    SAVE_REBIRTH = 0x4,
+    SAVE_HISTORIC = 0x8
+  };
+
+  struct sGroupRecord
+  {
+    Apto::SmartPtr<Apto::Map<Apto::String, Apto::String> > props;
+    bool parasite;
+    bool historic;
+
+    sGroupRecord() : parasite(false), historic(false) { ; }
+  };
+
+  struct sOrgRecord
+  {
+    int cell_id;
+    int group;
+    int offset;
+    int lineage_label;
+    int curr_group;
+    int curr_forage;
+    int birth_cell;
+    int avatar_cell;
+    int av_bcell;
+    // rebirth data
+    int parent_ft;
+    int parent_is_teacher;
+    double parent_merit;
+
+    sOrgRecord() { ; }
+    sOrgRecord(int c, int g, int o, int l, int in_group, int in_forage, int in_bcell, int in_avcell, int in_av_bcell,
+               int in_parent_ft, int in_parent_is_teacher, double in_parent_merit)
+      : cell_id(c), group(g), offset(o), lineage_label(l), curr_group(in_group), curr_forage(in_forage), birth_cell(in_bcell)
+      , avatar_cell(in_avcell), av_bcell(in_av_bcell), parent_ft(in_parent_ft), parent_is_teacher(in_parent_is_teacher)
+      , parent_merit(in_parent_merit) { ; }
+  };
+
+  static const int VERSION = 1;
+  static const int DEFAULT_CHUNK_CELLS = 65536;
+
+private:
+  Apto::String m_path;
+  int m_flags;
+  int m_world_size;
+  int m_chunk_cells;
+
+  Apto::Array<sGroupRecord> m_groups;
+  Apto::Array<sOrgRecord> m_orgs;     // Must be in ascending cell id order when written
+
+  bool m_success;
+
+
+  cPopulationCheckpoint(const cPopulationCheckpoint&); // @not_implemented
+  cPopulationCheckpoint& operator=(const cPopulationCheckpoint&); // @not_implemented
+
+
+public:
+  cPopulationCheckpoint(int flags = 0, int world_size = 0, int chunk_cells = DEFAULT_CHUNK_CELLS)
+    : m_flags(flags), m_world_size(world_size), m_chunk_cells(chunk_cells), m_success(false) { ; }
+  ~cPopulationCheckpoint() { ; }
+
+  static bool IsCheckpointFile(const Apto::String& path);
+
+  int GetFlags() const { return m_flags; }
+  int GetWorldSize() const { return m_world_size; }
+
+  int AddGroup(Apto::SmartPtr<Apto::Map<Apto::String, Apto::String> > props, bool parasite = false, bool historic = false);
+  void AddOrganism(const sOrgRecord& rec) { m_orgs.Push(rec); }
+
+  int GetNumGroups() const { return m_groups.GetSize(); }
+  const sGroupRecord& GetGroup(int idx) const { return m_groups[idx]; }
+  int GetNumOrganisms() const { return m_orgs.GetSize(); }
+  const sOrgRecord& GetOrganism(int idx) const { return m_orgs[idx]; }
+
+
+  // Writing either happens synchronously via Write(), or on a separate thread via Start(), in which case the result
+  // is available from WasSuccessful() after Join()
+  bool Write(const Apto::String& path);
+  void SetPath(const Apto::String& path) { m_path = path; }
+  const Apto::String& GetPath() const { return m_path; }
+  bool WasSuccessful() const { return m_success; }
+
+  bool Read(const Apto::String& path, Avida::Feedback& feedback);
+
+
+protected:
+  void Run();
+
+private:
+  bool writeTo(std::ostream& fp) const;
+  void encodeChunk(int begin, int end, int first_cell, Apto::Array<unsigned char, Apto::Smart>& buf) const;
+  bool decodeChunk(const Apto::Array<unsigned char, Apto::Smart>& buf, int num_records, int first_cell);
+};
+
+#endif
@@ -248,12 +248,12 @@ cOrganism* cPopulationInterface::GetNeighbor()
   cPopulationCell& cell = m_world->GetPopulation().GetCell(m_cell_id);
   assert(cell.IsOccupied());
   
-  return cell.ConnectionList().GetFirst()->GetOrganism();
+  return cell.GetCellFaced().GetOrganism();
 }
 
 bool cPopulationInterface::IsNeighborCellOccupied() {
   cPopulationCell & cell = m_world->GetPopulation().GetCell(m_cell_id);
-  return cell.ConnectionList().GetFirst()->IsOccupied();
+  return cell.GetCellFaced().IsOccupied();
 }
 
 int cPopulationInterface::GetNumNeighbors()
@@ -261,7 +261,7 @@ int cPopulationInterface::GetNumNeighbors()
   cPopulationCell & cell = m_world->GetPopulation().GetCell(m_cell_id);
   assert(cell.IsOccupied());
   
-  return cell.ConnectionList().GetSize();
+  return cell.GetNumNeighbors();
 }
 
 void cPopulationInterface::GetNeighborhoodCellIDs(Apto::Array<int>& list)
@@ -269,10 +269,9 @@ void cPopulationInterface::GetNeighborhoodCellIDs(Apto::Array<int>& list)
   cPopulationCell& cell = m_world->GetPopulation().GetCell(m_cell_id);
   assert(cell.IsOccupied());
   
-  list.Resize(cell.ConnectionList().GetSize());
-  tConstListIterator<cPopulationCell> it(cell.ConnectionList());
-  int i = 0;
-  while (it.Next() != NULL) list[i++] = it.Get()->GetID();
+  const int num_neighbors = cell.GetNumNeighbors();
+  list.Resize(num_neighbors);
+  for (int i = 0; i < num_neighbors; i++) list[i] = cell.GetNeighborID(i);
 }
 
 void cPopulationInterface::GetAVNeighborhoodCellIDs(Apto::Array<int>& list, int av_num)
@@ -280,10 +279,9 @@ void cPopulationInterface::GetAVNeighborhoodCellIDs(Apto::Array<int>& list, int
   cPopulationCell& cell = m_world->GetPopulation().GetCell(m_avatars[av_num].av_cell_id);
   assert(cell.HasAV());
   
-  list.Resize(cell.ConnectionList().GetSize());
-  tConstListIterator<cPopulationCell> it(cell.ConnectionList());
-  int i = 0;
-  while (it.Next() != NULL) list[i++] = it.Get()->GetID();
+  const int num_neighbors = cell.GetNumNeighbors();
+  list.Resize(num_neighbors);
+  for (int i = 0; i < num_neighbors; i++) list[i] = cell.GetNeighborID(i);
 }
 
 int cPopulationInterface::GetFacing()
@@ -308,7 +306,7 @@ int cPopulationInterface::GetFacedDir()
 
 int cPopulationInterface::GetNeighborCellContents() {
   cPopulationCell & cell = m_world->GetPopulation().GetCell(m_cell_id);
-  return cell.ConnectionList().GetFirst()->GetCellData();
+  return cell.GetCellFaced().GetCellData();
 }
 
 void cPopulationInterface::Rotate(cAvidaContext& ctx, int direction)
@@ -321,8 +319,8 @@ void cPopulationInterface::Rotate(cAvidaContext& ctx, int direction)
     else RotateAV(ctx, -1);
   }
   else {
-    if (direction >= 0) cell.ConnectionList().CircNext();
-    else cell.ConnectionList().CircPrev();
+    if (direction >= 0) cell.RotateFacing();
+    else cell.RotateFacing(-1);
   }
 }
 
@@ -466,11 +464,11 @@ int cPopulationInterface::ReceiveValue()
   cPopulationCell & cell = m_world->GetPopulation().GetCell(m_cell_id);
   assert(cell.IsOccupied());
   
-  const int num_neighbors = cell.ConnectionList().GetSize();
+  const int num_neighbors = cell.GetNumNeighbors();
   for (int i = 0; i < num_neighbors; i++) {
-    cell.ConnectionList().CircNext();
+    cell.RotateFacing();
     
-    cOrganism* cur_neighbor = cell.ConnectionList().GetFirst()->GetOrganism();
+    cOrganism* cur_neighbor = cell.GetCellFaced().GetOrganism();
     if (cur_neighbor == NULL || cur_neighbor->GetSentActive() == false) {
       continue;
     }
@@ -587,9 +585,7 @@ bool cPopulationInterface::SendMessage(cOrgMessage& msg) {
     }
     return message_sent;
   } else {
-    cPopulationCell* rcell = cell.ConnectionList().GetFirst();
-    assert(rcell != 0); // Cells should never be null.	
-    return SendMessage(msg, *rcell);
+    return SendMessage(msg, cell.GetCellFaced());
   }
 }
 
@@ -644,9 +640,8 @@ bool cPopulationInterface::BcastAlarm(int jump_label, int bcast_range) {
       }
     }
   } else { // single hop messaging
-    for(int i = 0; i < scell.ConnectionList().GetSize(); i++) {
-      cPopulationCell* rcell = scell.ConnectionList().GetPos(i);
-      assert(rcell != NULL); // Cells should never be null.
+    for(int i = 0; i < scell.GetNumNeighbors(); i++) {
+      cPopulationCell* rcell = &scell.GetNeighbor(i);
 			
       // Fail if the cell we're facing is not occupied.
       if(!rcell->IsOccupied())
@@ -680,12 +675,11 @@ void cPopulationInterface::SendFlash() {
   cPopulationCell& cell = m_world->GetPopulation().GetCell(m_cell_id);
   assert(cell.IsOccupied());
 	
-  for(int i=0; i<cell.ConnectionList().GetSize(); ++i) {
-    cPopulationCell* neighbor = cell.ConnectionList().GetFirst();
-    if(neighbor->IsOccupied()) {
-      neighbor->GetOrganism()->ReceiveFlash();
+  for(int i=0; i<cell.GetNumNeighbors(); ++i) {
+    cPopulationCell& neighbor = cell.GetNeighbor(i);
+    if(neighbor.IsOccupied()) {
+      neighbor.GetOrganism()->ReceiveFlash();
     }
-    cell.ConnectionList().CircNext();
   }
 }
 
@@ -704,8 +698,8 @@ void cPopulationInterface::RotateToGreatestReputation()
 	
 	
 	// loop to find the max reputation
-	for(int i=0; i<cell.ConnectionList().GetSize(); ++i) {
-		const cPopulationCell* faced_cell = cell.ConnectionList().GetFirst();
+	for(int i=0; i<cell.GetNumNeighbors(); ++i) {
+		const cPopulationCell* faced_cell = &cell.GetCellFaced();
 		// cell->organism, if occupied, check reputation, etc.
 		if (IsNeighborCellOccupied()) {
 			cOrganism* cur_neighbor = faced_cell->GetOrganism();
@@ -721,7 +715,7 @@ void cPopulationInterface::RotateToGreatestReputation()
 		}
 		
 		// check the next neighbor
-		cell.ConnectionList().CircNext();
+		cell.RotateFacing();
 	}
 	
 	// Pick an organism to donate to
@@ -730,8 +724,8 @@ void cPopulationInterface::RotateToGreatestReputation()
 		unsigned int rand_num = m_world->GetRandom().GetUInt(0, high_rep_orgs.size()); 
 		int high_org_id = high_rep_orgs[rand_num];
 		
-		for(int i=0; i<cell.ConnectionList().GetSize(); ++i) {
-			const cPopulationCell* faced_cell = cell.ConnectionList().GetFirst();
+		for(int i=0; i<cell.GetNumNeighbors(); ++i) {
+			const cPopulationCell* faced_cell = &cell.GetCellFaced();
 			
 			if (IsNeighborCellOccupied()) {
 				
@@ -743,7 +737,7 @@ void cPopulationInterface::RotateToGreatestReputation()
 				}
 			}
 			
-			cell.ConnectionList().CircNext();
+			cell.RotateFacing();
 			
 		}
 	}
@@ -760,8 +754,8 @@ void cPopulationInterface::RotateToGreatestReputationWithDifferentTag(int tag)
 	vector <int> high_rep_orgs;
 	
 	// loop to find the max reputation
-	for(int i=0; i<cell.ConnectionList().GetSize(); ++i) {
-		const cPopulationCell* faced_cell = cell.ConnectionList().GetFirst();
+	for(int i=0; i<cell.GetNumNeighbors(); ++i) {
+		const cPopulationCell* faced_cell = &cell.GetCellFaced();
 		// cell->organism, if occupied, check reputation, etc.
 		if (IsNeighborCellOccupied()) {
 			cOrganism* cur_neighbor = faced_cell->GetOrganism();
@@ -777,7 +771,7 @@ void cPopulationInterface::RotateToGreatestReputationWithDifferentTag(int tag)
 		}
 		
 		// check the next neighbor
-		cell.ConnectionList().CircNext();
+		cell.RotateFacing();
 	}
 	
 	// Pick an organism to donate to
@@ -786,8 +780,8 @@ void cPopulationInterface::RotateToGreatestReputationWithDifferentTag(int tag)
 		unsigned int rand_num = m_world->GetRandom().GetUInt(0, high_rep_orgs.size()); 
 		int high_org_id = high_rep_orgs[rand_num];
 		
-		for(int i=0; i<cell.ConnectionList().GetSize(); ++i) {
-			const cPopulationCell* faced_cell = cell.ConnectionList().GetFirst();
+		for(int i=0; i<cell.GetNumNeighbors(); ++i) {
+			const cPopulationCell* faced_cell = &cell.GetCellFaced();
 			
 			if (IsNeighborCellOccupied()) {
 				
@@ -799,7 +793,7 @@ void cPopulationInterface::RotateToGreatestReputationWithDifferentTag(int tag)
 				}
 			}
 			
-			cell.ConnectionList().CircNext();
+			cell.RotateFacing();
 			
 		}
 		
@@ -819,8 +813,8 @@ void cPopulationInterface::RotateToGreatestReputationWithDifferentLineage(int li
 	vector <int> high_rep_orgs;
 	
 	// loop to find the max reputation
-	for(int i=0; i<cell.ConnectionList().GetSize(); ++i) {
-		const cPopulationCell* faced_cell = cell.ConnectionList().GetFirst();
+	for(int i=0; i<cell.GetNumNeighbors(); ++i) {
+		const cPopulationCell* faced_cell = &cell.GetCellFaced();
 		// cell->organism, if occupied, check reputation, etc.
 		if (IsNeighborCellOccupied()) {
 			cOrganism* cur_neighbor = faced_cell->GetOrganism();
@@ -836,7 +830,7 @@ void cPopulationInterface::RotateToGreatestReputationWithDifferentLineage(int li
 		}
 		
 		// check the next neighbor
-		cell.ConnectionList().CircNext();
+		cell.RotateFacing();
 	}
 	
 	// Pick an organism to donate to
@@ -845,8 +839,8 @@ void cPopulationInterface::RotateToGreatestReputationWithDifferentLineage(int li
 		unsigned int rand_num = m_world->GetRandom().GetUInt(0, high_rep_orgs.size()); 
 		int high_org_id = high_rep_orgs[rand_num];
 		
-		for(int i=0; i<cell.ConnectionList().GetSize(); ++i) {
-			const cPopulationCell* faced_cell = cell.ConnectionList().GetFirst();
+		for(int i=0; i<cell.GetNumNeighbors(); ++i) {
+			const cPopulationCell* faced_cell = &cell.GetCellFaced();
 			
 			if (IsNeighborCellOccupied()) {
 				
@@ -858,7 +852,7 @@ void cPopulationInterface::RotateToGreatestReputationWithDifferentLineage(int li
 				}
 			}
 			
-			cell.ConnectionList().CircNext();
+			cell.RotateFacing();
 			
 		}
 	}	
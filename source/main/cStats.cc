@@ -30,6 +30,7 @@
 #include "avida/output/File.h"
 
 #include "cEnvironment.h"
+#include "cFreeListPool.h"
 #include "cHardwareBase.h"
 #include "cHardwareManager.h"
 #include "cInstSet.h"
@@ -79,6 +80,7 @@ cStats::cStats(cWorld* world)
 , num_breed_true_creatures(0)
 , num_creatures(0)
 , num_executed(0)
+, num_test_cpu_cycles_saved(0)
 , num_parasites(0)
 , num_no_birth_creatures(0)
 , num_single_thread_creatures(0)
@@ -346,6 +348,19 @@ template <class T, class U> Data::PackagePtr cStats::packageArgData(T (cStats::*
 }
 
 
+void cStats::AddTestCPUCyclesSaved(int cycles)
+{
+  Apto::MutexAutoLock lock(m_test_cpu_mutex);
+  num_test_cpu_cycles_saved += cycles;
+}
+
+long cStats::GetTestCPUCyclesSaved() const
+{
+  Apto::MutexAutoLock lock(m_test_cpu_mutex);
+  return num_test_cpu_cycles_saved;
+}
+
+
 void cStats::setupProvidedData()
 {
   // Load in all the keywords, descriptions, and associated functions for
@@ -1664,6 +1679,27 @@ void cStats::PrintTimeData(const cString& filename)
 }
 
 
+void cStats::PrintAllocatorData(const cString& filename)
+{
+  Avida::Output::FilePtr df = Avida::Output::File::StaticWithPath(m_world->GetNewWorld(), (const char*)filename);
+  
+  df->WriteComment("Avida object pool allocator data");
+  df->WriteComment("Pools are process wide, counts include test CPU organisms");
+  df->WriteTimeStamp();
+  
+  df->Write(m_update, "update");
+  for (cFreeListPool* pool = cFreeListPool::GetFirstPool(); pool; pool = pool->GetNextPool()) {
+    const char* name = pool->GetName();
+    df->Write(pool->GetNumLive(), cStringUtil::Stringf("%s objects live", name));
+    df->Write(pool->GetNumFree(), cStringUtil::Stringf("%s blocks free", name));
+    df->Write(pool->GetNumAllocs(), cStringUtil::Stringf("%s total allocations", name));
+    df->Write(pool->GetNumReused(), cStringUtil::Stringf("%s allocations reused from free list", name));
+    df->Write(pool->GetNumUnpooled(), cStringUtil::Stringf("%s allocations passed to system allocator", name));
+  }
+  df->Endl();
+}
+
+
 //@MRR Add additional time information
 void cStats::PrintExtendedTimeData(const cString& filename)
 {
@@ -1676,6 +1712,17 @@ void cStats::PrintExtendedTimeData(const cString& filename)
 	df->Endl();
 }
 
+void cStats::PrintTestCPUData(const cString& filename)
+{
+  Avida::Output::FilePtr df = Avida::Output::File::StaticWithPath(m_world->GetNewWorld(), (const char*)filename);
+  
+  df->WriteComment("Avida test CPU data");
+  df->WriteTimeStamp();
+  df->Write(m_update, "update");
+  df->Write(GetTestCPUCyclesSaved(), "test CPU cycles skipped by early stopping (TEST_CPU_EARLY_STOP)");
+  df->Endl();
+}
+
 void cStats::PrintMutationRateData(const cString& filename)
 {
   Avida::Output::FilePtr df = Avida::Output::File::StaticWithPath(m_world->GetNewWorld(), (const char*)filename);
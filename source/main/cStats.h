@@ -30,6 +30,7 @@
 #include "avida/core/InstructionSequence.h"
 #include "avida/data/Provider.h"
 
+#include "apto/core/Mutex.h"
 #include "apto/stat/Accumulator.h"
 
 #include "cBirthEntry.h"
@@ -191,6 +192,8 @@ private:
   int num_breed_true_creatures;
   int num_creatures;
   int num_executed;
+  long num_test_cpu_cycles_saved;    // Test CPUs run on several threads, so guarded by m_test_cpu_mutex
+  mutable Apto::Mutex m_test_cpu_mutex;
   int num_parasites;
   int num_no_birth_creatures;
   int num_single_thread_creatures;
@@ -620,6 +623,8 @@ public:
   void RecordDeath() { num_deaths++; }
 
   void IncExecuted() { num_executed++; }
+  void AddTestCPUCyclesSaved(int cycles);
+  long GetTestCPUCyclesSaved() const;
 
   void AddNumOrgsKilled(long num) { sum_orgs_killed.Add(num); }
 	void AddNumUnoccupiedCellAttemptedToKill(long num) { sum_unoccupied_cell_kill_attempts.Add(num); }
@@ -860,6 +865,7 @@ public:
   void PrintResWallLocData(const cString& filename, cAvidaContext& ctx);
   void PrintSpatialResData(const cString& filename, int i);
   void PrintTimeData(const cString& filename);
+  void PrintAllocatorData(const cString& filename);
   void PrintDivideMutData(const cString& filename);
   void PrintMutationRateData(const cString& filename);
   void PrintSenseData(const cString& filename);
@@ -870,6 +876,7 @@ public:
   void PrintCompetitionData(const cString& filename);
   void PrintCellVisitsData(const cString& filename);
   void PrintExtendedTimeData(const cString& filename);
+  void PrintTestCPUData(const cString& filename);
   void PrintNumOrgsKilledData(const cString& filename);
   void PrintMigrationData(const cString& filename);
   void PrintGroupsFormedData(const cString& filename);
@@ -49,6 +49,11 @@ bool Avida::Systematics::Arbiter::LegacySave(void*) const
   return false;
 }
 
+bool Avida::Systematics::Arbiter::LegacySaveProperties(Apto::Array<Apto::SmartPtr<Apto::Map<Apto::String, Apto::String> > >&) const
+{
+  return false;
+}
+
 Avida::Systematics::GroupPtr Avida::Systematics::Arbiter::LegacyLoad(void*)
 {
   return GroupPtr();
@@ -379,6 +379,46 @@ bool Avida::Systematics::Genotype::LegacySave(void* dfp) const
   return false;
 }
 
+bool Avida::Systematics::Genotype::LegacySaveProperties(Apto::Map<Apto::String, Apto::String>& props) const
+{
+  // Mirrors the columns written by LegacySave, keyed by their format identifiers
+  props.Set("id", Apto::AsStr(m_id));
+  props.Set("src", m_src.AsString());
+  props.Set("src_args", m_src.arguments.GetSize() ? m_src.arguments : Apto::String("(none)"));
+  
+  Apto::String str("");
+  if (m_parents.GetSize()) {
+    str += Apto::AsStr(m_parents[0]->ID());
+    for (int i = 1; i < m_parents.GetSize(); i++) {
+      str += ",";
+      str += Apto::AsStr(m_parents[i]->ID());
+    }
+  }
+  props.Set("parents", (str.GetSize()) ? str : Apto::String("(none)"));
+  
+  props.Set("num_units", Apto::AsStr(m_num_organisms));
+  props.Set("total_units", Apto::AsStr(m_total_organisms));
+  
+  ConstInstructionSequencePtr seq;
+  seq.DynamicCastFrom(m_genome.Representation());
+  props.Set("length", Apto::AsStr(seq->GetSize()));
+  
+  props.Set("merit", Apto::AsStr(m_merit.Average()));
+  props.Set("gest_time", Apto::AsStr(m_gestation_time.Average()));
+  props.Set("fitness", Apto::AsStr(m_fitness.Average()));
+  
+  props.Set("gen_born", Apto::AsStr(m_generation_born));
+  props.Set("update_born", Apto::AsStr(m_update_born));
+  props.Set("update_deactivated", Apto::AsStr(m_update_deactivated));
+  props.Set("depth", Apto::AsStr(m_depth));
+  
+  props.Set("hw_type", Apto::AsStr(m_genome.HardwareType()));
+  props.Set("inst_set", m_genome.Properties().Get("instset").StringValue());
+  props.Set("sequence", seq->AsString());
+  
+  return true;
+}
+
 
 void Avida::Systematics::Genotype::RemoveActiveReference() const
 {
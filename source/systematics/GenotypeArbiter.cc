@@ -128,6 +128,17 @@ bool Avida::Systematics::GenotypeArbiter::LegacySave(void* dfp) const
   return true;
 }
 
+bool Avida::Systematics::GenotypeArbiter::LegacySaveProperties(Apto::Array<Apto::SmartPtr<Apto::Map<Apto::String, Apto::String> > >& records) const
+{
+  Apto::List<GenotypePtr, Apto::SparseVector>::ConstIterator list_it(m_historic.Begin());
+  while (list_it.Next() != NULL) {
+    Apto::SmartPtr<Apto::Map<Apto::String, Apto::String> > props(new Apto::Map<Apto::String, Apto::String>);
+    (*list_it.Get())->LegacySaveProperties(*props);
+    records.Push(props);
+  }
+  return true;
+}
+
 Avida::Systematics::GroupPtr Avida::Systematics::GenotypeArbiter::LegacyLoad(void* props)
 {
   GenotypePtr g(new Genotype(thisPtr(), m_next_id++, props));
@@ -468,13 +479,7 @@ void Avida::Systematics::GenotypeArbiter::setupProvidedData(World* world)
 
 unsigned int Avida::Systematics::GenotypeArbiter::hashGenome(const InstructionSequence& genome) const
 {
-  unsigned int total = 0;
-  
-  for (int i = 0; i < genome.GetSize(); i++) {
-    total += (genome[i].GetOp() + 3) * i;
-  }
-  
-  return total % HASH_SIZE;
+  return genome.Hash() % HASH_SIZE;
 }
 
 Apto::String Avida::Systematics::GenotypeArbiter::nameGenotype(int size)
@@ -42,6 +42,11 @@ bool Avida::Systematics::Group::LegacySave(void*) const
   return false;
 }
 
+bool Avida::Systematics::Group::LegacySaveProperties(Apto::Map<Apto::String, Apto::String>&) const
+{
+  return false;
+}
+
 
 void Avida::Systematics::Group::AddActiveReference() const { m_a_refs++; assert(m_a_refs >= 0); }
 void Avida::Systematics::Group::RemoveActiveReference() const { m_a_refs--; assert(m_a_refs >= 0); }
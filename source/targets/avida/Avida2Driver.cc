@@ -144,14 +144,7 @@ void Avida2Driver::Run()
     
     
     // Do Point Mutations
-    if (point_mut_prob > 0 ) {
-      for (int i = 0; i < population.GetSize(); i++) {
-        if (population.GetCell(i).IsOccupied()) {
-          int num_mut = population.GetCell(i).GetOrganism()->GetHardware().PointMutate(ctx);
-          population.GetCell(i).GetOrganism()->IncPointMutations(num_mut);
-        }
-      }
-    }
+    if (point_mut_prob > 0 ) population.ProcessPointMutations(ctx);
     
     m_new_world->PerformUpdate(new_ctx, stats.GetUpdate());
     
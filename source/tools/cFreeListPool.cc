@@ -0,0 +1,209 @@
+/*
+ *  cFreeListPool.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cFreeListPool.h"
+
+#include <cassert>
+#include <new>
+
+
+// Constant initialized, so it is valid before any pool's constructor has run
+cFreeListPool* cFreeListPool::s_first_pool = NULL;
+FREELISTPOOL_THREAD_LOCAL int cFreeListPool::s_active_arena = 0;
+
+
+cFreeListPool::cFreeListPool(const char* name, std::size_t block_size)
+  : m_name(name), m_block_size((block_size < sizeof(sFreeBlock)) ? sizeof(sFreeBlock) : block_size)
+  , m_free(NULL), m_num_free(0), m_num_allocs(0), m_num_reused(0), m_num_released(0), m_num_unpooled(0)
+  , m_next_pool(s_first_pool)
+{
+  s_first_pool = this;
+}
+
+cFreeListPool::~cFreeListPool()
+{
+  Trim();
+}
+
+
+void* cFreeListPool::Allocate(std::size_t size)
+{
+  Apto::MutexAutoLock lock(m_mutex);
+  m_num_allocs++;
+
+  if (size != m_block_size) {
+    m_num_unpooled++;
+    return ::operator new(size);
+  }
+
+  if (s_active_arena > 0) return allocateFromArena(s_active_arena);
+
+  if (m_free) {
+    sFreeBlock* block = m_free;
+    m_free = block->next;
+    m_num_free--;
+    m_num_reused++;
+    return block;
+  }
+
+  return ::operator new(m_block_size);
+}
+
+
+void cFreeListPool::Release(void* ptr, std::size_t size)
+{
+  if (ptr == NULL) return;
+
+  Apto::MutexAutoLock lock(m_mutex);
+  m_num_released++;
+
+  if (size != m_block_size) {
+    ::operator delete(ptr);
+    return;
+  }
+
+  sFreeBlock* block = static_cast<sFreeBlock*>(ptr);
+  m_num_free++;
+
+  const int slab = findSlab(ptr);
+  if (slab >= 0) {
+    m_slabs[slab].live--;
+    sFreeBlock*& arena_free = m_arena_free[m_slabs[slab].arena - 1];
+    block->next = arena_free;
+    arena_free = block;
+    return;
+  }
+
+  block->next = m_free;
+  m_free = block;
+}
+
+
+void cFreeListPool::Trim()
+{
+  Apto::MutexAutoLock lock(m_mutex);
+  while (m_free) {
+    sFreeBlock* block = m_free;
+    m_free = block->next;
+    ::operator delete(block);
+  }
+  m_num_free = 0;
+  for (int a = 0; a < m_arena_free.GetSize(); a++) {
+    for (sFreeBlock* block = m_arena_free[a]; block; block = block->next) m_num_free++;
+  }
+
+  releaseIdleSlabs(0);
+}
+
+
+void cFreeListPool::TrimArena(int arena)
+{
+  Apto::MutexAutoLock lock(m_mutex);
+  if (arena > 0 && arena <= m_arena_free.GetSize()) releaseIdleSlabs(arena);
+}
+
+
+void cFreeListPool::ReleaseArena(int arena)
+{
+  for (cFreeListPool* pool = s_first_pool; pool; pool = pool->m_next_pool) pool->TrimArena(arena);
+}
+
+
+// Releases the idle slabs of the given arena, or of every arena when arena is 0.  Must be called with m_mutex held.
+void cFreeListPool::releaseIdleSlabs(int arena)
+{
+  // Drop the free blocks of idle slabs from their arena's free list, then release those slabs
+  const int first = (arena > 0) ? arena - 1 : 0;
+  const int last = (arena > 0) ? arena : m_arena_free.GetSize();
+  for (int a = first; a < last; a++) {
+    sFreeBlock** link = &m_arena_free[a];
+    while (*link) {
+      if (m_slabs[findSlab(*link)].live == 0) {
+        *link = (*link)->next;
+        m_num_free--;
+      } else {
+        link = &(*link)->next;
+      }
+    }
+  }
+
+  int kept = 0;
+  for (int i = 0; i < m_slabs.GetSize(); i++) {
+    if (m_slabs[i].live == 0 && (arena == 0 || m_slabs[i].arena == arena)) ::operator delete(m_slabs[i].begin);
+    else m_slabs[kept++] = m_slabs[i];
+  }
+  m_slabs.Resize(kept);
+}
+
+
+void* cFreeListPool::allocateFromArena(int arena)
+{
+  if (m_arena_free.GetSize() < arena) {
+    const int old_size = m_arena_free.GetSize();
+    m_arena_free.Resize(arena);
+    for (int a = old_size; a < arena; a++) m_arena_free[a] = NULL;
+  }
+
+  sFreeBlock*& arena_free = m_arena_free[arena - 1];
+  if (arena_free == NULL) {
+    // Reserve a new slab for the arena, keeping the slab list ordered by address
+    sSlab slab;
+    slab.begin = static_cast<char*>(::operator new(SLAB_BLOCKS * m_block_size));
+    slab.end = slab.begin + SLAB_BLOCKS * m_block_size;
+    slab.arena = arena;
+    slab.live = 0;
+
+    int pos = m_slabs.GetSize();
+    m_slabs.Resize(pos + 1);
+    for (; pos > 0 && m_slabs[pos - 1].begin > slab.begin; pos--) m_slabs[pos] = m_slabs[pos - 1];
+    m_slabs[pos] = slab;
+
+    // Thread the blocks so they are handed out in address order
+    for (int i = SLAB_BLOCKS - 1; i >= 0; i--) {
+      sFreeBlock* block = reinterpret_cast<sFreeBlock*>(slab.begin + i * m_block_size);
+      block->next = arena_free;
+      arena_free = block;
+    }
+    m_num_free += SLAB_BLOCKS;
+  } else {
+    m_num_reused++;
+  }
+
+  sFreeBlock* block = arena_free;
+  arena_free = block->next;
+  m_num_free--;
+  m_slabs[findSlab(block)].live++;
+  return block;
+}
+
+
+int cFreeListPool::findSlab(const void* ptr) const
+{
+  const char* addr = static_cast<const char*>(ptr);
+  int lo = 0;
+  int hi = m_slabs.GetSize();
+  while (lo < hi) {
+    const int mid = (lo + hi) / 2;
+    if (addr < m_slabs[mid].begin) hi = mid;
+    else if (addr >= m_slabs[mid].end) lo = mid + 1;
+    else return mid;
+  }
+  return -1;
+}
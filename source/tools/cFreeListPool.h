@@ -0,0 +1,143 @@
+/*
+ *  cFreeListPool.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cFreeListPool_h
+#define cFreeListPool_h
+
+#include "apto/core.h"
+#include "apto/core/Mutex.h"
+#include "apto/platform.h"
+
+#include <cstddef>
+
+#if APTO_PLATFORM(WINDOWS)
+# define FREELISTPOOL_THREAD_LOCAL __declspec(thread)
+#else
+# define FREELISTPOOL_THREAD_LOCAL __thread
+#endif
+
+
+// cFreeListPool - recycles the storage of objects of a single class
+//
+// Classes that are created and destroyed at a high rate (organisms, hardware) route their class specific operator
+// new/delete through a pool.  Released blocks are kept on a free list and handed back out by the next allocation, so
+// the system allocator is only visited when the population grows beyond its previous peak.  Requests for any other
+// size (e.g. a derived class that does not declare its own pool) are passed straight through to the system allocator.
+//
+// Pools are intended to be created once, during static initialization, and are never destroyed; objects may still be
+// released while the program is shutting down.  All pools are linked together so that their statistics can be
+// reported (see cStats::PrintAllocatorData).
+//
+// Allocations made while an arena scope is open are carved from slabs reserved for that arena instead (cPopulation
+// uses one arena per deme, see DEMES_ORGANISM_ARENAS), so the objects belonging to one arena share a small set of
+// contiguous slabs.  A block carved from an arena slab always goes back to that arena's free list when released,
+// whatever scope is open at the time.  Idle arena slabs are handed back to the system allocator by ReleaseArena, which
+// cPopulation calls whenever it resets or replaces a deme.
+class cFreeListPool
+{
+private:
+  static const int SLAB_BLOCKS = 16;
+
+  struct sFreeBlock
+  {
+    sFreeBlock* next;
+  };
+
+  struct sSlab
+  {
+    char* begin;
+    char* end;
+    int arena;
+    int live;     // blocks of this slab currently handed out
+  };
+
+  const char* m_name;
+  const std::size_t m_block_size;
+
+  Apto::Mutex m_mutex;
+  sFreeBlock* m_free;
+  int m_num_free;
+  Apto::Array<sSlab, Apto::Smart> m_slabs;             // ordered by address
+  Apto::Array<sFreeBlock*, Apto::Smart> m_arena_free;  // free list of arena a is at index a - 1
+
+  // Statistics
+  long m_num_allocs;     // total allocations requested of the pool
+  long m_num_reused;     // allocations satisfied from the free list
+  long m_num_released;
+  long m_num_unpooled;   // allocations of the wrong size, passed through to the system allocator
+
+  cFreeListPool* m_next_pool;
+  static cFreeListPool* s_first_pool;
+  static FREELISTPOOL_THREAD_LOCAL int s_active_arena;
+
+  cFreeListPool(); // @not_implemented
+  cFreeListPool(const cFreeListPool&); // @not_implemented
+  cFreeListPool& operator=(const cFreeListPool&); // @not_implemented
+
+public:
+  // Directs allocations from every pool into the given arena (0 being the shared free list) for the scope's lifetime.
+  // The active arena is per thread, so a scope only affects allocations made by the thread that opened it.
+  class cArenaScope
+  {
+  private:
+    int m_prev_arena;
+
+    cArenaScope(const cArenaScope&); // @not_implemented
+    cArenaScope& operator=(const cArenaScope&); // @not_implemented
+
+  public:
+    explicit cArenaScope(int arena) : m_prev_arena(s_active_arena) { s_active_arena = arena; }
+    ~cArenaScope() { s_active_arena = m_prev_arena; }
+  };
+
+  cFreeListPool(const char* name, std::size_t block_size);
+  ~cFreeListPool();
+
+  void* Allocate(std::size_t size);
+  void Release(void* ptr, std::size_t size);
+
+  // Returns all currently free blocks, and every arena slab with no blocks in use, to the system allocator
+  void Trim();
+
+  // Returns the arena slabs with no blocks in use to the system allocator
+  void TrimArena(int arena);
+
+  // Trims the given arena in every pool
+  static void ReleaseArena(int arena);
+
+  const char* GetName() const { return m_name; }
+  std::size_t GetBlockSize() const { return m_block_size; }
+  int GetNumFree() const { return m_num_free; }
+  long GetNumAllocs() const { return m_num_allocs; }
+  long GetNumReused() const { return m_num_reused; }
+  long GetNumReleased() const { return m_num_released; }
+  long GetNumUnpooled() const { return m_num_unpooled; }
+  long GetNumLive() const { return m_num_allocs - m_num_released; }
+
+  static cFreeListPool* GetFirstPool() { return s_first_pool; }
+  cFreeListPool* GetNextPool() const { return m_next_pool; }
+
+private:
+  void* allocateFromArena(int arena);
+  void releaseIdleSlabs(int arena);
+  int findSlab(const void* ptr) const;
+};
+
+#endif
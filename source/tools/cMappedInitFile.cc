@@ -0,0 +1,308 @@
+/*
+ *  cMappedInitFile.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cMappedInitFile.h"
+
+#include "apto/core/FileSystem.h"
+
+#include <cstring>
+
+#if APTO_PLATFORM(WINDOWS)
+# include <fstream>
+#else
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+
+static inline bool isWhitespace(char c)
+{
+  return (c == ' ' || c == '\t' || c == '\r' || c == '\n');
+}
+
+
+bool cMappedInitFile::cLineView::NextWord(const char*& word, int& length)
+{
+  while (m_begin != m_end && isWhitespace(*m_begin)) m_begin++;
+  if (m_begin == m_end) return false;
+
+  word = m_begin;
+  while (m_begin != m_end && !isWhitespace(*m_begin)) m_begin++;
+  length = static_cast<int>(m_begin - word);
+
+  return true;
+}
+
+cString cMappedInitFile::cLineView::PopWord()
+{
+  const char* word = NULL;
+  int length = 0;
+  if (!NextWord(word, length)) return "";
+  return cString(word, length);
+}
+
+int cMappedInitFile::cLineView::CountNumWords() const
+{
+  cLineView tmp(*this);
+  const char* word = NULL;
+  int length = 0;
+  int count = 0;
+  while (tmp.NextWord(word, length)) count++;
+  return count;
+}
+
+cString cMappedInitFile::cLineView::AsString() const
+{
+  cString line(m_begin, GetSize());
+  line.CompressWhitespace();
+  return line;
+}
+
+
+
+cMappedInitFile::cMappedInitFile(const cString& filename, const cString& working_dir, Feedback& feedback)
+  : m_filename(filename), m_found(false), m_opened(false), m_needs_init_file(false), m_feedback_target(&feedback)
+  , m_data(NULL), m_size(0), m_mapped(false), m_scan_pos(0), m_scan_line_num(0), m_ftype("unknown")
+{
+  init(working_dir);
+}
+
+cMappedInitFile::cMappedInitFile(const cString& filename, const cString& working_dir)
+  : m_filename(filename), m_found(false), m_opened(false), m_needs_init_file(false), m_feedback_target(&m_feedback)
+  , m_data(NULL), m_size(0), m_mapped(false), m_scan_pos(0), m_scan_line_num(0), m_ftype("unknown")
+{
+  init(working_dir);
+}
+
+cMappedInitFile::~cMappedInitFile()
+{
+  unmapFile();
+}
+
+
+void cMappedInitFile::init(const cString& working_dir)
+{
+#if APTO_PLATFORM(WINDOWS)
+  m_buffer = NULL;
+#endif
+
+  cString path = cString(Apto::FileSystem::GetAbsolutePath(Apto::String(m_filename), Apto::String(working_dir)));
+  if (!mapFile(path)) {
+    m_feedback_target->Error("unable to open file '%s'.", (const char*)m_filename);
+    return;
+  }
+
+  m_found = true;
+  m_opened = true;
+
+  // Index every line up front, so that all directives have been processed (and any failure reported) before the
+  // caller checks WasOpened()
+  sLineRef ref;
+  while (scanLine(ref)) m_lines.Push(ref);
+  if (!m_opened) m_lines.Resize(0);
+}
+
+
+bool cMappedInitFile::mapFile(const cString& path)
+{
+#if APTO_PLATFORM(WINDOWS)
+  // No mmap available, fall back to a single contiguous buffer (still avoids the per-line copies of cInitFile)
+  std::ifstream fp((const char*)path, std::ios::in | std::ios::binary);
+  if (!fp.good()) return false;
+  fp.seekg(0, std::ios::end);
+  m_size = static_cast<size_t>(fp.tellg());
+  fp.seekg(0, std::ios::beg);
+  m_buffer = new char[m_size + 1];
+  fp.read(m_buffer, m_size);
+  m_buffer[m_size] = '\0';
+  m_data = m_buffer;
+  return true;
+#else
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) return false;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    close(fd);
+    return false;
+  }
+
+  m_size = static_cast<size_t>(st.st_size);
+  if (m_size == 0) {
+    // mmap rejects zero length mappings, an empty file simply has no lines
+    close(fd);
+    m_data = "";
+    return true;
+  }
+
+  void* data = mmap(NULL, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) return false;
+
+  madvise(data, m_size, MADV_SEQUENTIAL);
+  m_data = static_cast<const char*>(data);
+  m_mapped = true;
+  return true;
+#endif
+}
+
+
+void cMappedInitFile::unmapFile()
+{
+#if APTO_PLATFORM(WINDOWS)
+  delete [] m_buffer;
+  m_buffer = NULL;
+#else
+  if (m_mapped) munmap(const_cast<char*>(m_data), m_size);
+#endif
+  m_mapped = false;
+  m_data = NULL;
+  m_size = 0;
+}
+
+
+cMappedInitFile::cLineView cMappedInitFile::GetLineView(int line_num) const
+{
+  if (line_num < 0 || line_num >= m_lines.GetSize()) return cLineView();
+
+  const sLineRef& ref = m_lines[line_num];
+  if (ref.joined >= 0) {
+    const char* line = m_joined[ref.joined];
+    return cLineView(line, line + ref.length);
+  }
+  return cLineView(m_data + ref.offset, m_data + ref.offset + ref.length);
+}
+
+
+Apto::SmartPtr<Apto::Map<Apto::String, Apto::String> > cMappedInitFile::GetLineAsDict(int line_num) const
+{
+  Apto::SmartPtr<Apto::Map<Apto::String, Apto::String> > dict(new Apto::Map<Apto::String, Apto::String>);
+
+  cStringList fmt = m_format;
+  cLineView line = GetLineView(line_num);
+  const char* word = NULL;
+  int length = 0;
+  while (fmt.GetSize() && line.NextWord(word, length)) {
+    dict->Set((const char*)fmt.Pop(), (const char*)cString(word, length));
+  }
+
+  return dict;
+}
+
+
+// Scans forward from the current position to the next non-empty logical line, processing any directives encountered
+// along the way.  Returns false once the end of the file has been reached (or a directive could not be handled).
+bool cMappedInitFile::scanLine(sLineRef& ref)
+{
+  cString joined;
+  bool continued = false;
+
+  while (m_opened && m_scan_pos < m_size) {
+    const char* begin = m_data + m_scan_pos;
+    const char* eol = static_cast<const char*>(memchr(begin, '\n', m_size - m_scan_pos));
+    if (eol == NULL) eol = m_data + m_size;
+    m_scan_pos = (eol - m_data) + ((eol == m_data + m_size) ? 0 : 1);
+    m_scan_line_num++;
+
+    // Drop the carriage return of CRLF line endings, so that it does not end up in directive arguments
+    if (eol != begin && *(eol - 1) == '\r') eol--;
+
+    // Directives only appear at the very start of a line
+    if (begin != eol && *begin == '#') {
+      if (!processCommand(begin, eol, m_scan_line_num)) m_opened = false;
+      continue;
+    }
+
+    // Remove all characters past a comment mark
+    const char* end = static_cast<const char*>(memchr(begin, '#', eol - begin));
+    if (end == NULL) end = eol;
+
+    if (continued) {
+      cString cur_line(begin, static_cast<int>(end - begin));
+      cur_line.CompressWhitespace();
+      joined += cur_line;
+    } else {
+      const char* last = end;
+      while (last != begin && isWhitespace(*(last - 1))) last--;
+      if (last == begin) continue;  // empty line
+
+      if (*(last - 1) != '\\') {
+        ref.offset = begin - m_data;
+        ref.length = static_cast<int>(end - begin);
+        ref.joined = -1;
+        ref.line_num = m_scan_line_num;
+        return true;
+      }
+
+      // Line continuation, assemble the logical line in the same manner as cInitFile
+      joined = cString(begin, static_cast<int>(end - begin));
+      joined.CompressWhitespace();
+      ref.line_num = m_scan_line_num;
+      continued = true;
+    }
+
+    if (joined.GetSize() > 0 && joined[joined.GetSize() - 1] == '\\') {
+      joined.ClipEnd(1);
+    } else {
+      break;
+    }
+  }
+
+  if (!continued) return false;
+
+  // A continuation that collapsed to nothing is an empty line, move on to the next one
+  if (joined.GetSize() == 0) return scanLine(ref);
+
+  ref.offset = 0;
+  ref.length = joined.GetSize();
+  ref.joined = m_joined.GetSize();
+  m_joined.Push(joined);
+  return true;
+}
+
+
+bool cMappedInitFile::processCommand(const char* begin, const char* end, int linenum)
+{
+  cString cmdstr(begin, static_cast<int>(end - begin));
+  cString cmd = cmdstr.PopWord();
+
+  if (cmd == "#filetype") {
+    cString ft = cmdstr.PopWord();
+    if (m_ftype != "unknown" && m_ftype != ft) {
+      m_feedback_target->Error("%s:%d: duplicate filetype directive", (const char*)m_filename, linenum);
+      return false;
+    }
+    m_ftype = ft;
+  } else if (cmd == "#format") {
+    if (m_format.GetSize() != 0) {
+      m_feedback_target->Error("%s:%d: duplicate format directive", (const char*)m_filename, linenum);
+      return false;
+    }
+    m_format.Load(cmdstr);
+  } else if (cmd == "#include" || cmd == "#import" || cmd == "#define") {
+    // Not an error, the caller falls back to cInitFile
+    m_needs_init_file = true;
+    return false;
+  }
+
+  return true;
+}
@@ -0,0 +1,133 @@
+/*
+ *  cMappedInitFile.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cMappedInitFile_h
+#define cMappedInitFile_h
+
+#include "apto/core.h"
+#include "apto/platform.h"
+
+#include "cString.h"
+#include "cStringList.h"
+#include "cUserFeedback.h"
+
+
+// cMappedInitFile - read-only, zero-copy variant of cInitFile for large data files (detail dumps, spop files)
+//
+// The file is memory mapped and the line offsets are indexed when it is opened.  Lines are handed out as cLineView
+// objects that point directly into the mapping, so memory use is proportional to the line index rather than to the
+// file contents.  Comments, whitespace and '\' line continuations are handled as in cInitFile.  Only the #filetype and
+// #format directives are supported.  Any #include, #import or #define directive (wherever it appears) causes
+// WasOpened() to return false and NeedsInitFile() to return true, without reporting an error; callers should then
+// load the file through cInitFile instead.
+//
+// All line accessors are read-only, so a single instance may be shared between threads.
+class cMappedInitFile
+{
+public:
+  class cLineView
+  {
+  private:
+    const char* m_begin;
+    const char* m_end;
+
+  public:
+    cLineView() : m_begin(NULL), m_end(NULL) { ; }
+    cLineView(const char* begin, const char* end) : m_begin(begin), m_end(end) { ; }
+
+    bool IsEmpty() const { return m_begin == m_end; }
+    int GetSize() const { return static_cast<int>(m_end - m_begin); }
+
+    // Word access, with words separated by any amount of whitespace
+    bool NextWord(const char*& word, int& length);
+    cString PopWord();
+    int CountNumWords() const;
+
+    // Returns a copy of the line with whitespace compressed, matching cInitFile::GetLine
+    cString AsString() const;
+  };
+
+
+private:
+  cString m_filename;
+  bool m_found;
+  bool m_opened;
+  bool m_needs_init_file;
+  mutable cUserFeedback m_feedback;
+  Feedback* m_feedback_target;
+
+  const char* m_data;
+  size_t m_size;
+  bool m_mapped;
+#if APTO_PLATFORM(WINDOWS)
+  char* m_buffer;
+#endif
+
+  struct sLineRef {
+    size_t offset;
+    int length;
+    int joined;       // index into m_joined for lines assembled from '\' continuations, otherwise -1
+    int line_num;
+  };
+
+  Apto::Array<sLineRef, Apto::Smart> m_lines;
+  Apto::Array<cString, Apto::ManagedPointer> m_joined;
+  size_t m_scan_pos;
+  int m_scan_line_num;
+
+  cString m_ftype;
+  cStringList m_format;
+
+
+  cMappedInitFile(); // @not_implemented
+  cMappedInitFile(const cMappedInitFile&); // @not_implemented
+  cMappedInitFile& operator=(const cMappedInitFile&); // @not_implemented
+
+
+public:
+  cMappedInitFile(const cString& filename, const cString& working_dir, Feedback& feedback);
+  cMappedInitFile(const cString& filename, const cString& working_dir);
+  ~cMappedInitFile();
+
+  bool WasFound() const { return m_found; }
+  bool WasOpened() const { return m_opened; }
+  bool NeedsInitFile() const { return m_needs_init_file; }
+  const cUserFeedback& GetFeedback() const { return m_feedback; }
+
+  const cString& GetFiletype() const { return m_ftype; }
+  const cStringList& GetFormat() const { return m_format; }
+
+  int GetNumLines() const { return m_lines.GetSize(); }
+
+  cLineView GetLineView(int line_num) const;
+  cString GetLine(int line_num = 0) const { return GetLineView(line_num).AsString(); }
+  Apto::SmartPtr<Apto::Map<Apto::String, Apto::String> > GetLineAsDict(int line_num = 0) const;
+
+
+private:
+  void init(const cString& working_dir);
+  bool mapFile(const cString& path);
+  void unmapFile();
+
+  bool scanLine(sLineRef& ref);
+  bool processCommand(const char* begin, const char* end, int linenum);
+};
+
+#endif
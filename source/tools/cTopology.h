@@ -25,10 +25,13 @@
  
  This file contains templated algorithms that create a particular cell
  topology out of a given range of cells.  In every case, the range of cells is
- specified by a begin/end iterator pair.
+ specified by a begin/end iterator pair.  Connections are recorded in a
+ cCellTopology::cBuilder, which is compacted into the shared cell topology once
+ all of the ranges have been built.
  */
 
 #include "AvidaTools.h"
+#include "cCellTopology.h"
 
 using namespace AvidaTools;
 
@@ -37,21 +40,21 @@ using namespace AvidaTools;
  and connections DO wrap around the logical edges of the torus.
  */
 template< typename ArraySlice >
-void build_torus(ArraySlice slice, unsigned int x_size, unsigned int y_size) {
+void build_torus(ArraySlice slice, cCellTopology::cBuilder& links, unsigned int x_size, unsigned int y_size) {
   // Get the offset from the start of this range.  This is used to modify the
   // parameters and return for GridNeighbor.
   int offset = slice[0].GetID();
   
   for (int i = 0; i < slice.GetSize(); ++i) {
     // The majority of all connections.
-    slice[i].ConnectionList().Push(&slice[GridNeighbor(slice[i].GetID() - offset, x_size, y_size, -1, -1)]);
-    slice[i].ConnectionList().Push(&slice[GridNeighbor(slice[i].GetID() - offset, x_size, y_size, 0, -1)]);
-    slice[i].ConnectionList().Push(&slice[GridNeighbor(slice[i].GetID() - offset, x_size, y_size, 1, -1)]);
-    slice[i].ConnectionList().Push(&slice[GridNeighbor(slice[i].GetID() - offset, x_size, y_size, 1, 0)]);
-    slice[i].ConnectionList().Push(&slice[GridNeighbor(slice[i].GetID() - offset, x_size, y_size, 1, 1)]);
-    slice[i].ConnectionList().Push(&slice[GridNeighbor(slice[i].GetID() - offset, x_size, y_size, 0, 1)]);
-    slice[i].ConnectionList().Push(&slice[GridNeighbor(slice[i].GetID() - offset, x_size, y_size, -1, 1)]);
-    slice[i].ConnectionList().Push(&slice[GridNeighbor(slice[i].GetID() - offset, x_size, y_size, -1, 0)]);
+    links.Push(slice[i], slice[GridNeighbor(slice[i].GetID() - offset, x_size, y_size, -1, -1)]);
+    links.Push(slice[i], slice[GridNeighbor(slice[i].GetID() - offset, x_size, y_size, 0, -1)]);
+    links.Push(slice[i], slice[GridNeighbor(slice[i].GetID() - offset, x_size, y_size, 1, -1)]);
+    links.Push(slice[i], slice[GridNeighbor(slice[i].GetID() - offset, x_size, y_size, 1, 0)]);
+    links.Push(slice[i], slice[GridNeighbor(slice[i].GetID() - offset, x_size, y_size, 1, 1)]);
+    links.Push(slice[i], slice[GridNeighbor(slice[i].GetID() - offset, x_size, y_size, 0, 1)]);
+    links.Push(slice[i], slice[GridNeighbor(slice[i].GetID() - offset, x_size, y_size, -1, 1)]);
+    links.Push(slice[i], slice[GridNeighbor(slice[i].GetID() - offset, x_size, y_size, -1, 0)]);
   }
 }
 
@@ -61,9 +64,9 @@ void build_torus(ArraySlice slice, unsigned int x_size, unsigned int y_size) {
  and connections do NOT wrap around the logical edges of the grid.
  */
 template< typename ArraySlice >
-void build_grid(ArraySlice slice, unsigned int x_size, unsigned int y_size) {
+void build_grid(ArraySlice slice, cCellTopology::cBuilder& links, unsigned int x_size, unsigned int y_size) {
   // Start with a torus.
-  build_torus(slice, x_size, y_size);
+  build_torus(slice, links, x_size, y_size);
   int offset = slice[0].GetID();
   
   // And now remove the connections that wrap around.
@@ -73,24 +76,24 @@ void build_grid(ArraySlice slice, unsigned int x_size, unsigned int y_size) {
     unsigned int y = (id-offset) / x_size;
     
     if (x == 0) {
-      slice[i].ConnectionList().Remove(&slice[GridNeighbor(slice[i].GetID() - offset, x_size, y_size, -1, -1)]);
-      slice[i].ConnectionList().Remove(&slice[GridNeighbor(slice[i].GetID() - offset, x_size, y_size, -1, 0)]);
-      slice[i].ConnectionList().Remove(&slice[GridNeighbor(slice[i].GetID() - offset, x_size, y_size, -1, 1)]);
+      links.Remove(slice[i], slice[GridNeighbor(slice[i].GetID() - offset, x_size, y_size, -1, -1)]);
+      links.Remove(slice[i], slice[GridNeighbor(slice[i].GetID() - offset, x_size, y_size, -1, 0)]);
+      links.Remove(slice[i], slice[GridNeighbor(slice[i].GetID() - offset, x_size, y_size, -1, 1)]);
     }
     if (x == (x_size - 1)) {
-      slice[i].ConnectionList().Remove(&slice[GridNeighbor(slice[i].GetID() - offset, x_size, y_size, 1, -1)]);
-      slice[i].ConnectionList().Remove(&slice[GridNeighbor(slice[i].GetID() - offset, x_size, y_size, 1, 0)]);
-      slice[i].ConnectionList().Remove(&slice[GridNeighbor(slice[i].GetID() - offset, x_size, y_size, 1, 1)]);
+      links.Remove(slice[i], slice[GridNeighbor(slice[i].GetID() - offset, x_size, y_size, 1, -1)]);
+      links.Remove(slice[i], slice[GridNeighbor(slice[i].GetID() - offset, x_size, y_size, 1, 0)]);
+      links.Remove(slice[i], slice[GridNeighbor(slice[i].GetID() - offset, x_size, y_size, 1, 1)]);
     }
     if (y == 0) {
-      slice[i].ConnectionList().Remove(&slice[GridNeighbor(slice[i].GetID() - offset, x_size, y_size, -1, -1)]);
-      slice[i].ConnectionList().Remove(&slice[GridNeighbor(slice[i].GetID() - offset, x_size, y_size, 0, -1)]);
-      slice[i].ConnectionList().Remove(&slice[GridNeighbor(slice[i].GetID() - offset, x_size, y_size, 1, -1)]);
+      links.Remove(slice[i], slice[GridNeighbor(slice[i].GetID() - offset, x_size, y_size, -1, -1)]);
+      links.Remove(slice[i], slice[GridNeighbor(slice[i].GetID() - offset, x_size, y_size, 0, -1)]);
+      links.Remove(slice[i], slice[GridNeighbor(slice[i].GetID() - offset, x_size, y_size, 1, -1)]);
     }
     if (y == (y_size - 1)) {
-      slice[i].ConnectionList().Remove(&slice[GridNeighbor(slice[i].GetID() - offset, x_size, y_size, -1, 1)]);
-      slice[i].ConnectionList().Remove(&slice[GridNeighbor(slice[i].GetID() - offset, x_size, y_size, 0, 1)]);
-      slice[i].ConnectionList().Remove(&slice[GridNeighbor(slice[i].GetID() - offset, x_size, y_size, 1, 1)]);
+      links.Remove(slice[i], slice[GridNeighbor(slice[i].GetID() - offset, x_size, y_size, -1, 1)]);
+      links.Remove(slice[i], slice[GridNeighbor(slice[i].GetID() - offset, x_size, y_size, 0, 1)]);
+      links.Remove(slice[i], slice[GridNeighbor(slice[i].GetID() - offset, x_size, y_size, 1, 1)]);
     }
   }
 }
@@ -100,11 +103,11 @@ void build_grid(ArraySlice slice, unsigned int x_size, unsigned int y_size) {
  In a clique, each cell is connected to all other cells in the given range.
  */
 template< typename ArraySlice >
-void build_clique(ArraySlice slice, unsigned int, unsigned int) {
+void build_clique(ArraySlice slice, cCellTopology::cBuilder& links, unsigned int, unsigned int) {
   for (int i = 0; i < slice.GetSize(); ++i) {
     for (int j = 0; j < slice.GetSize(); ++j) {
       if (j != i) {
-        slice[i].ConnectionList().Push(&slice[j]);
+        links.Push(slice[i], slice[j]);
       }
     }
   }
@@ -116,14 +119,14 @@ void build_clique(ArraySlice slice, unsigned int, unsigned int) {
  edges.
  */
 template< typename ArraySlice >
-void build_hex(ArraySlice slice, unsigned int x_size, unsigned int y_size) {
+void build_hex(ArraySlice slice, cCellTopology::cBuilder& links, unsigned int x_size, unsigned int y_size) {
   // Start with a grid:
-  build_grid(slice, x_size, y_size);
+  build_grid(slice, links, x_size, y_size);
   int offset = slice[0].GetID();
   // ... and remove connections to the NE,SW:
   for (int i = 0; i < slice.GetSize(); ++i) {
-    slice[i].ConnectionList().Remove(&slice[GridNeighbor(slice[i].GetID()-offset, x_size, y_size, 1, -1)]);
-    slice[i].ConnectionList().Remove(&slice[GridNeighbor(slice[i].GetID()-offset, x_size, y_size, -1, 1)]);
+    links.Remove(slice[i], slice[GridNeighbor(slice[i].GetID()-offset, x_size, y_size, 1, -1)]);
+    links.Remove(slice[i], slice[GridNeighbor(slice[i].GetID()-offset, x_size, y_size, -1, 1)]);
   }
 }
 
@@ -134,12 +137,12 @@ void build_hex(ArraySlice slice, unsigned int x_size, unsigned int y_size) {
  same plane).  Edges do not wrap around in any direction.
  */
 template< typename ArraySlice >
-void build_lattice(ArraySlice slice, unsigned int x_size, unsigned int y_size, unsigned int z_size) {
+void build_lattice(ArraySlice slice, cCellTopology::cBuilder& links, unsigned int x_size, unsigned int y_size, unsigned int z_size) {
   // First we're going to create z grids each sized x by y:
   unsigned int gridsize = x_size * y_size;
   
   for (unsigned int i = 0; i < z_size; ++i) {
-    build_grid(slice.Range(gridsize * i, gridsize * (i + 1)), x_size, y_size);
+    build_grid(slice.Range(gridsize * i, gridsize * (i + 1)), links, x_size, y_size);
   }
   
   // This is the offset from the beginning of the cell_array; req'd to support demes.
@@ -159,66 +162,66 @@ void build_lattice(ArraySlice slice, unsigned int x_size, unsigned int y_size, u
       // We're not at the bottom; link to the layer below us.
       if (x != 0) {
         if (y != 0) {
-          slice[i].ConnectionList().Push(&slice[GridNeighbor(slice[i].GetID()-offset-gridsize, x_size, y_size, -1, -1)]);
+          links.Push(slice[i], slice[GridNeighbor(slice[i].GetID()-offset-gridsize, x_size, y_size, -1, -1)]);
         }
         if (y != (y_size-1)) {
-          slice[i].ConnectionList().Push(&slice[GridNeighbor(slice[i].GetID()-offset-gridsize, x_size, y_size, -1, 1)]);
+          links.Push(slice[i], slice[GridNeighbor(slice[i].GetID()-offset-gridsize, x_size, y_size, -1, 1)]);
         }
-        slice[i].ConnectionList().Push(&slice[GridNeighbor(slice[i].GetID()-offset-gridsize, x_size, y_size, -1, 0)]);
+        links.Push(slice[i], slice[GridNeighbor(slice[i].GetID()-offset-gridsize, x_size, y_size, -1, 0)]);
       }
       
       if (x != (x_size-1)) {
         if (y != 0) {
-          slice[i].ConnectionList().Push(&slice[GridNeighbor(slice[i].GetID()-offset-gridsize, x_size, y_size, 1, -1)]);
+          links.Push(slice[i], slice[GridNeighbor(slice[i].GetID()-offset-gridsize, x_size, y_size, 1, -1)]);
         }
         if (y != (y_size-1)) {
-          slice[i].ConnectionList().Push(&slice[GridNeighbor(slice[i].GetID()-offset-gridsize, x_size, y_size, 1, 1)]);
+          links.Push(slice[i], slice[GridNeighbor(slice[i].GetID()-offset-gridsize, x_size, y_size, 1, 1)]);
         }
-        slice[i].ConnectionList().Push(&slice[GridNeighbor(slice[i].GetID()-offset-gridsize, x_size, y_size, 1, 0)]);
+        links.Push(slice[i], slice[GridNeighbor(slice[i].GetID()-offset-gridsize, x_size, y_size, 1, 0)]);
       }
 			
       if (y != 0) {
-        slice[i].ConnectionList().Push(&slice[GridNeighbor(slice[i].GetID()-offset-gridsize, x_size, y_size, 0, -1)]);
+        links.Push(slice[i], slice[GridNeighbor(slice[i].GetID()-offset-gridsize, x_size, y_size, 0, -1)]);
       }
       if(y != (y_size-1)) {
-        slice[i].ConnectionList().Push(&slice[GridNeighbor(slice[i].GetID()-offset-gridsize, x_size, y_size, 0, 1)]);
+        links.Push(slice[i], slice[GridNeighbor(slice[i].GetID()-offset-gridsize, x_size, y_size, 0, 1)]);
       }
 			
       // And now the cell right below this one:
-      slice[i].ConnectionList().Push(&slice[slice[i].GetID()-offset-gridsize]);
+      links.Push(slice[i], slice[slice[i].GetID()-offset-gridsize]);
     }
     
     if (layer != (z_size-1)) {
       // We're not at the top; link to the layer above us:
       if(x != 0) {
         if (y != 0) {
-          slice[i].ConnectionList().Push(&slice[GridNeighbor(slice[i].GetID()-offset+gridsize, x_size, y_size, -1, -1)]);
+          links.Push(slice[i], slice[GridNeighbor(slice[i].GetID()-offset+gridsize, x_size, y_size, -1, -1)]);
         }
         if(y != (y_size-1)) {
-          slice[i].ConnectionList().Push(&slice[GridNeighbor(slice[i].GetID()-offset+gridsize, x_size, y_size, -1, 1)]);
+          links.Push(slice[i], slice[GridNeighbor(slice[i].GetID()-offset+gridsize, x_size, y_size, -1, 1)]);
         }
-        slice[i].ConnectionList().Push(&slice[GridNeighbor(slice[i].GetID()-offset+gridsize, x_size, y_size, -1, 0)]);
+        links.Push(slice[i], slice[GridNeighbor(slice[i].GetID()-offset+gridsize, x_size, y_size, -1, 0)]);
       }
 			
       if (x != (x_size-1)) {
         if (y != 0) {
-          slice[i].ConnectionList().Push(&slice[GridNeighbor(slice[i].GetID()-offset+gridsize, x_size, y_size, 1, -1)]);
+          links.Push(slice[i], slice[GridNeighbor(slice[i].GetID()-offset+gridsize, x_size, y_size, 1, -1)]);
         }
         if (y != (y_size-1)) {
-          slice[i].ConnectionList().Push(&slice[GridNeighbor(slice[i].GetID()-offset+gridsize, x_size, y_size, 1, 1)]);
+          links.Push(slice[i], slice[GridNeighbor(slice[i].GetID()-offset+gridsize, x_size, y_size, 1, 1)]);
         }
-        slice[i].ConnectionList().Push(&slice[GridNeighbor(slice[i].GetID()-offset+gridsize, x_size, y_size, 1, 0)]);
+        links.Push(slice[i], slice[GridNeighbor(slice[i].GetID()-offset+gridsize, x_size, y_size, 1, 0)]);
       }
       
       if (y != 0) {
-        slice[i].ConnectionList().Push(&slice[GridNeighbor(slice[i].GetID()-offset+gridsize, x_size, y_size, 0, -1)]);
+        links.Push(slice[i], slice[GridNeighbor(slice[i].GetID()-offset+gridsize, x_size, y_size, 0, -1)]);
       }
       if(y != (y_size-1)) {
-        slice[i].ConnectionList().Push(&slice[GridNeighbor(slice[i].GetID()-offset+gridsize, x_size, y_size, 0, 1)]);
+        links.Push(slice[i], slice[GridNeighbor(slice[i].GetID()-offset+gridsize, x_size, y_size, 0, 1)]);
       }
       
       // And now the cell right above this one:
-      slice[i].ConnectionList().Push(&slice[slice[i].GetID()-offset+gridsize]);
+      links.Push(slice[i], slice[slice[i].GetID()-offset+gridsize]);
     }
   }
 }
@@ -229,7 +232,7 @@ void build_lattice(ArraySlice slice, unsigned int x_size, unsigned int y_size, u
  
  */
 template< typename ArraySlice >
-void build_random_connected_network(ArraySlice slice, unsigned int x_size, unsigned int y_size, Apto::Random& rng) {
+void build_random_connected_network(ArraySlice slice, cCellTopology::cBuilder& links, unsigned int x_size, unsigned int y_size, Apto::Random& rng) {
 	
 	// keep track of boundaries for this deme:
 	int offset = slice[0].GetID();
@@ -249,10 +252,10 @@ void build_random_connected_network(ArraySlice slice, unsigned int x_size, unsig
 		int j = targetCellID;
 		
 		// verify no connection exists between i and j:
-		if (slice[i].ConnectionList().FindPtr(&slice[j]) == NULL) {
+		if (!links.Contains(slice[i], slice[j])) {
 			// create bidirectional connections:
-			slice[i].ConnectionList().Push(&slice[j]);
-			slice[j].ConnectionList().Push(&slice[i]);
+			links.Push(slice[i], slice[j]);
+			links.Push(slice[j], slice[i]);
 			
 			// check if either i or j is connected to the
 			// main graph:
@@ -286,12 +289,12 @@ void build_random_connected_network(ArraySlice slice, unsigned int x_size, unsig
 					
 					if(zeroOrOne) {
 						// connect i to main network:
-						slice[i].ConnectionList().Push(&slice[random_Connected_Cell]);
-						slice[random_Connected_Cell].ConnectionList().Push(&slice[i]);
+						links.Push(slice[i], slice[random_Connected_Cell]);
+						links.Push(slice[random_Connected_Cell], slice[i]);
 					} else {
 						// connect j to main network:
-						slice[j].ConnectionList().Push(&slice[random_Connected_Cell]);
-						slice[random_Connected_Cell].ConnectionList().Push(&slice[j]);
+						links.Push(slice[j], slice[random_Connected_Cell]);
+						links.Push(slice[random_Connected_Cell], slice[j]);
 					}
 					
 					// add both cells to the main network:
@@ -327,9 +330,9 @@ void build_random_connected_network(ArraySlice slice, unsigned int x_size, unsig
 		int j = b;
 		
 		// check for existing connection between the two:
-		if (slice[i].ConnectionList().FindPtr(&slice[j]) == NULL) {
-			slice[i].ConnectionList().Push(&slice[j]);
-			slice[j].ConnectionList().Push(&slice[i]);
+		if (!links.Contains(slice[i], slice[j])) {
+			links.Push(slice[i], slice[j]);
+			links.Push(slice[j], slice[i]);
 		}
 	}
 }
@@ -337,17 +340,17 @@ void build_random_connected_network(ArraySlice slice, unsigned int x_size, unsig
 
 //! Helper function to connect two cells.
 template <typename InputIterator>
-void connect(InputIterator u, InputIterator v) {
+void connect(cCellTopology::cBuilder& links, InputIterator u, InputIterator v) {
 	assert(u != v);
-	u->ConnectionList().Push(v);
-	v->ConnectionList().Push(u);
+	links.Push(*u, *v);
+	links.Push(*v, *u);
 }
 
 //! Helper function to test if two cells are already connected.
 template <typename InputIterator>
-bool edge(InputIterator u, InputIterator v) {
+bool edge(const cCellTopology::cBuilder& links, InputIterator u, InputIterator v) {
 	assert(u != v);
-	return u->ConnectionList().FindPtr(v) || v->ConnectionList().FindPtr(u);
+	return links.Contains(*u, *v) || links.Contains(*v, *u);
 }
 
 
@@ -373,10 +376,10 @@ bool edge(InputIterator u, InputIterator v) {
  connect u-v with probability: (d(v)/|E(G)|)^alpha + zero_appeal
  */
 template <typename ArraySlice>
-void build_scale_free(ArraySlice slice, int m, double alpha, double zero_appeal, Apto::Random& rng) {
+void build_scale_free(ArraySlice slice, cCellTopology::cBuilder& links, int m, double alpha, double zero_appeal, Apto::Random& rng) {
 	assert(slice.GetSize() > 1); // at least two vertices.
 	// Connect the first and second cells:
-	connect(&slice[0], &slice[1]);
+	connect(links, &slice[0], &slice[1]);
 	// And initialize the edge and vertex counts:
 	int edge_count=1;
 	int vertex_count=2;
@@ -390,16 +393,16 @@ void build_scale_free(ArraySlice slice, int m, double alpha, double zero_appeal,
 		int v = 0;
 		while(added < to_add) {
 			// If we haven't already connected u and v:
-			if(!edge(&slice[u], &slice[v])) {
+			if(!edge(links, &slice[u], &slice[v])) {
 				// Connect them with P = (d(v)/|E(G)|)^alpha + zero_appeal:
-				double p_edge = (double)slice[v].ConnectionList().GetSize() / edge_count;
+				double p_edge = (double)links.GetSize(slice[v]) / edge_count;
 				p_edge = pow(p_edge, alpha) + zero_appeal;
 				// Protect against negative and over-large probabilities:
 				assert(p_edge >= 0.0);
 				p_edge = std::min(p_edge, 1.0);
 				// Probabilistically connect u and v:
 				if(rng.P(p_edge)) {
-					connect(&slice[u], &slice[v]);
+					connect(links, &slice[u], &slice[v]);
 					++edge_count;
 					++added;
 				}
@@ -424,13 +424,7 @@ void Avida::Viewer::Driver::Run()
       
       
       // Do Point Mutations
-      if (point_mut_prob > 0 ) {
-        for (int i = 0; i < population.GetSize(); i++) {
-          if (population.GetCell(i).IsOccupied()) {
-            population.GetCell(i).GetOrganism()->GetHardware().PointMutate(ctx, point_mut_prob);
-          }
-        }
-      }
+      if (point_mut_prob > 0 ) population.ProcessPointMutations(ctx);
       
       m_new_world->PerformUpdate(new_ctx, stats.GetUpdate());
       
@@ -0,0 +1,224 @@
+/*
+ *  unittests/core/InstructionSequence.cc
+ *  avida-core
+ *
+ *  Copyright 2011 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "avida/core/InstructionSequence.h"
+
+#include "gtest/gtest.h"
+
+#include <cstdlib>
+
+using namespace Avida;
+
+
+// Reference O(n*m) dynamic programming edit distance
+static int referenceEditDistance(const InstructionSequence& seq1, const InstructionSequence& seq2)
+{
+  const int size1 = seq1.GetSize();
+  const int size2 = seq2.GetSize();
+  Apto::Array<int> prev_row(size2 + 1);
+  Apto::Array<int> cur_row(size2 + 1);
+  for (int j = 0; j <= size2; j++) prev_row[j] = j;
+  for (int i = 1; i <= size1; i++) {
+    cur_row[0] = i;
+    for (int j = 1; j <= size2; j++) {
+      int dist = prev_row[j - 1] + ((seq1[i - 1] == seq2[j - 1]) ? 0 : 1);
+      if (prev_row[j] + 1 < dist) dist = prev_row[j] + 1;
+      if (cur_row[j - 1] + 1 < dist) dist = cur_row[j - 1] + 1;
+      cur_row[j] = dist;
+    }
+    Apto::Array<int> tmp = prev_row;
+    prev_row = cur_row;
+    cur_row = tmp;
+  }
+  return prev_row[size2];
+}
+
+static InstructionSequence randomSequence(int size, int num_insts)
+{
+  InstructionSequence seq(size);
+  for (int i = 0; i < size; i++) seq[i] = Instruction(std::rand() % num_insts);
+  return seq;
+}
+
+
+TEST(InstructionSequence, FindEditDistance_Simple)
+{
+  EXPECT_EQ(0, InstructionSequence::FindEditDistance(InstructionSequence("abcdef"), InstructionSequence("abcdef")));
+  EXPECT_EQ(1, InstructionSequence::FindEditDistance(InstructionSequence("abcdef"), InstructionSequence("abcxef")));
+  EXPECT_EQ(1, InstructionSequence::FindEditDistance(InstructionSequence("abcdef"), InstructionSequence("abcdxef")));
+  EXPECT_EQ(1, InstructionSequence::FindEditDistance(InstructionSequence("abcdef"), InstructionSequence("abdef")));
+  EXPECT_EQ(3, InstructionSequence::FindEditDistance(InstructionSequence("kitten"), InstructionSequence("sitting")));
+  EXPECT_EQ(6, InstructionSequence::FindEditDistance(InstructionSequence(""), InstructionSequence("abcdef")));
+}
+
+TEST(InstructionSequence, FindEditDistance_MatchesReference)
+{
+  std::srand(1);
+  for (int trial = 0; trial < 500; trial++) {
+    // Cover single and multiple 64-site blocks, as well as wide instruction alphabets
+    const int num_insts = (trial % 5 == 0) ? 256 : 26;
+    InstructionSequence seq1 = randomSequence(std::rand() % 300, num_insts);
+    InstructionSequence seq2(seq1);
+    const int num_muts = std::rand() % 20;
+    for (int i = 0; i < num_muts && seq2.GetSize() > 1; i++) {
+      switch (std::rand() % 3) {
+        case 0: seq2[std::rand() % seq2.GetSize()] = Instruction(std::rand() % num_insts); break;
+        case 1: seq2.Insert(std::rand() % seq2.GetSize(), Instruction(std::rand() % num_insts)); break;
+        case 2: seq2.Remove(std::rand() % seq2.GetSize()); break;
+      }
+    }
+    
+    const int expected = referenceEditDistance(seq1, seq2);
+    EXPECT_EQ(expected, InstructionSequence::FindEditDistance(seq1, seq2));
+    EXPECT_EQ(expected, InstructionSequence::FindEditDistance(seq2, seq1));
+    
+    const int max_dist = std::rand() % 25;
+    EXPECT_EQ((expected <= max_dist) ? expected : max_dist + 1, InstructionSequence::FindEditDistance(seq1, seq2, max_dist));
+  }
+}
+
+TEST(InstructionSequence, FindEditDistance_NegativeMaxDistIsUnlimited)
+{
+  const InstructionSequence seq1("abcdefghij");
+  const InstructionSequence seq2("xbcdeyghijkl");
+  ASSERT_EQ(4, InstructionSequence::FindEditDistance(seq1, seq2));
+  
+  Instruction raw1[10];
+  Instruction raw2[12];
+  for (int i = 0; i < seq1.GetSize(); i++) raw1[i] = seq1[i];
+  for (int i = 0; i < seq2.GetSize(); i++) raw2[i] = seq2[i];
+  
+  // Both overloads agree: any negative limit yields the exact distance, a zero limit only tells equal sequences apart
+  EXPECT_EQ(4, InstructionSequence::FindEditDistance(seq1, seq2, -1));
+  EXPECT_EQ(4, InstructionSequence::FindEditDistance(seq1, seq2, -5));
+  EXPECT_EQ(4, InstructionSequence::FindEditDistance(raw1, 10, raw2, 12, -5));
+  EXPECT_EQ(1, InstructionSequence::FindEditDistance(seq1, seq2, 0));
+  EXPECT_EQ(1, InstructionSequence::FindEditDistance(raw1, 10, raw2, 12, 0));
+  EXPECT_EQ(0, InstructionSequence::FindEditDistance(seq1, seq1, 0));
+}
+
+
+// Reference FNV-1a over freshly allocated (never shared) storage
+static unsigned int referenceHash(const InstructionSequence& seq, int size)
+{
+  InstructionBuffer fresh(size);
+  for (int i = 0; i < size; i++) fresh[i] = seq[i];
+  return fresh.Hash(size);
+}
+
+TEST(InstructionBuffer, CopyOnWrite_Sharing)
+{
+  InstructionBuffer buf(50);
+  for (int i = 0; i < buf.GetSize(); i++) buf[i] = Instruction(i % 26);
+  
+  InstructionBuffer copy(buf);
+  InstructionBuffer assigned;
+  assigned = buf;
+  EXPECT_TRUE(copy.IsSharedWith(buf));
+  EXPECT_TRUE(assigned.IsSharedWith(buf));
+  
+  // Const access, including hashing, never unshares
+  const InstructionBuffer& const_copy = copy;
+  for (int i = 0; i < const_copy.GetSize(); i++) EXPECT_EQ(Instruction(i % 26), const_copy[i]);
+  EXPECT_EQ(buf.Hash(50), const_copy.Hash(50));
+  EXPECT_TRUE(copy.IsSharedWith(buf));
+  
+  // Nor does copying a sequence or assigning one to another
+  InstructionSequence seq("abcdefghij");
+  InstructionSequence seq_copy(seq);
+  InstructionSequence seq_assigned;
+  seq_assigned = seq;
+  EXPECT_TRUE(seq_copy == seq);
+  EXPECT_TRUE(seq_assigned == seq);
+}
+
+TEST(InstructionBuffer, CopyOnWrite_PrivateCopy)
+{
+  InstructionBuffer buf(20);
+  for (int i = 0; i < buf.GetSize(); i++) buf[i] = Instruction(i);
+  
+  // Element write
+  InstructionBuffer written(buf);
+  written[5] = Instruction(99);
+  EXPECT_FALSE(written.IsSharedWith(buf));
+  EXPECT_EQ(Instruction(5), static_cast<const InstructionBuffer&>(buf)[5]);
+  EXPECT_EQ(Instruction(99), static_cast<const InstructionBuffer&>(written)[5]);
+  
+  // Bulk write access
+  InstructionBuffer bulk(buf);
+  Instruction* sites = bulk.GetWritable();
+  EXPECT_FALSE(bulk.IsSharedWith(buf));
+  sites[0] = Instruction(42);
+  EXPECT_EQ(Instruction(0), static_cast<const InstructionBuffer&>(buf)[0]);
+  
+  // Resizing keeps the surviving sites and leaves the original alone
+  InstructionBuffer grown(buf);
+  grown.Resize(30);
+  EXPECT_FALSE(grown.IsSharedWith(buf));
+  EXPECT_EQ(30, grown.GetSize());
+  EXPECT_EQ(20, buf.GetSize());
+  for (int i = 0; i < 20; i++) EXPECT_EQ(Instruction(i), static_cast<const InstructionBuffer&>(grown)[i]);
+  
+  InstructionBuffer cleared(buf);
+  cleared.ResizeClear(10);
+  EXPECT_FALSE(cleared.IsSharedWith(buf));
+  EXPECT_EQ(20, buf.GetSize());
+  
+  // Sequence level modifications leave the source sequence untouched
+  InstructionSequence seq("abcdefghij");
+  InstructionSequence mod(seq);
+  mod[0] = Instruction(25);
+  mod.Insert(3, Instruction(24));
+  mod.Remove(7);
+  EXPECT_TRUE(seq == InstructionSequence("abcdefghij"));
+  EXPECT_FALSE(mod == seq);
+}
+
+TEST(InstructionBuffer, Hash_Invalidation)
+{
+  InstructionSequence seq("abcdefghijklmnopqrstuvwxyz");
+  InstructionSequence copy(seq);
+  const unsigned int hash = seq.Hash();
+  EXPECT_EQ(hash, copy.Hash());
+  EXPECT_EQ(referenceHash(seq, seq.GetSize()), hash);
+  
+  // A write through either copy is reflected in that copy's hash only
+  copy[10] = Instruction(0);
+  EXPECT_NE(hash, copy.Hash());
+  EXPECT_EQ(referenceHash(copy, copy.GetSize()), copy.Hash());
+  EXPECT_EQ(hash, seq.Hash());
+  copy[10] = seq[10];
+  EXPECT_EQ(hash, copy.Hash());
+  EXPECT_TRUE(copy == seq);
+  
+  // Sequences of different active sizes may share storage; each hashes (and compares) over its own sites
+  InstructionSequence shorter(seq);
+  shorter.Resize(20);
+  EXPECT_EQ(referenceHash(seq, 20), shorter.Hash());
+  EXPECT_EQ(hash, seq.Hash());
+  EXPECT_FALSE(shorter == seq);
+  EXPECT_TRUE(shorter == seq.Crop(0, 20));
+  
+  // Equal contents in separate storage compare equal and hash alike
+  InstructionSequence rebuilt("abcdefghijklmnopqrstuvwxyz");
+  EXPECT_EQ(hash, rebuilt.Hash());
+  EXPECT_TRUE(rebuilt == seq);
+}
@@ -0,0 +1,389 @@
+/*
+ *  unittests/cpu/CPUMemory.cc
+ *  avida-core
+ *
+ *  Copyright 2011 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cCPUMemory.h"
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using namespace Avida;
+
+
+// The site flags are packed into bit-planes and shifted a word at a time (readBits, writeBits, moveFlags and
+// countFlag); these tests check every flag operation against a plain per-site reference.
+
+static const int NUM_TEST_FLAGS = 6;
+
+
+// Per-site reference model: one op and one byte of flags (bit f is flag f) per site
+struct sReference
+{
+  std::vector<int> ops;
+  std::vector<unsigned char> flags;
+};
+
+
+// Small deterministic generator, so that failures are reproducible
+class cTestSequence
+{
+private:
+  unsigned int m_state;
+
+public:
+  explicit cTestSequence(unsigned int seed) : m_state(seed) { ; }
+  int Next(int range) { m_state = m_state * 1103515245u + 12345u; return (m_state >> 8) % range; }
+};
+
+
+static bool getTestFlag(const cCPUMemory& mem, int pos, int flag)
+{
+  switch (flag) {
+    case 0: return mem.FlagCopied(pos);
+    case 1: return mem.FlagMutated(pos);
+    case 2: return mem.FlagExecuted(pos);
+    case 3: return mem.FlagPointMut(pos);
+    case 4: return mem.FlagCopyMut(pos);
+    default: return mem.FlagInjected(pos);
+  }
+}
+
+static void setTestFlag(cCPUMemory& mem, int pos, int flag, bool value)
+{
+  switch (flag) {
+    case 0: if (value) mem.SetFlagCopied(pos); else mem.ClearFlagCopied(pos); break;
+    case 1: if (value) mem.SetFlagMutated(pos); else mem.ClearFlagMutated(pos); break;
+    case 2: if (value) mem.SetFlagExecuted(pos); else mem.ClearFlagExecuted(pos); break;
+    case 3: if (value) mem.SetFlagPointMut(pos); else mem.ClearFlagPointMut(pos); break;
+    case 4: if (value) mem.SetFlagCopyMut(pos); else mem.ClearFlagCopyMut(pos); break;
+    default: if (value) mem.SetFlagInjected(pos); else mem.ClearFlagInjected(pos); break;
+  }
+}
+
+
+// Fills the memory with distinct ops and an irregular flag pattern that crosses every word boundary
+static void fillTestMemory(cCPUMemory& mem, sReference& ref, int size)
+{
+  mem.Resize(size);
+  ref.ops.assign(size, 0);
+  ref.flags.assign(size, 0);
+  for (int i = 0; i < size; i++) {
+    mem[i].SetOp(i % 26);
+    ref.ops[i] = i % 26;
+    for (int f = 0; f < NUM_TEST_FLAGS; f++) {
+      if ((i * (f + 3) + f) % (f + 2) == 0) {
+        setTestFlag(mem, i, f, true);
+        ref.flags[i] |= (1 << f);
+      }
+    }
+  }
+}
+
+
+static void expectMatchesReference(const cCPUMemory& mem, const sReference& ref)
+{
+  ASSERT_EQ((int)ref.ops.size(), mem.GetSize());
+  for (int i = 0; i < mem.GetSize(); i++) {
+    EXPECT_EQ(ref.ops[i], mem[i].GetOp()) << "site " << i;
+    for (int f = 0; f < NUM_TEST_FLAGS; f++) {
+      EXPECT_EQ((ref.flags[i] & (1 << f)) != 0, getTestFlag(mem, i, f)) << "site " << i << " flag " << f;
+    }
+  }
+}
+
+
+static int referenceCount(const sReference& ref, int flag, int begin, int end)
+{
+  int count = 0;
+  for (int i = begin; i < end; i++) if (ref.flags[i] & (1 << flag)) count++;
+  return count;
+}
+
+
+TEST(CPUMemory, Flags_SetAndClear)
+{
+  cCPUMemory mem(100);
+  sReference ref;
+  fillTestMemory(mem, ref, 100);
+  expectMatchesReference(mem, ref);
+
+  // Clearing one flag must leave the neighbouring sites and the other planes alone
+  for (int i = 0; i < 100; i += 7) {
+    setTestFlag(mem, i, 2, false);
+    ref.flags[i] &= ~(1 << 2);
+  }
+  expectMatchesReference(mem, ref);
+
+  mem.ClearFlags();
+  ref.flags.assign(100, 0);
+  expectMatchesReference(mem, ref);
+}
+
+
+TEST(CPUMemory, Flags_Count)
+{
+  cCPUMemory mem(1);
+  sReference ref;
+  fillTestMemory(mem, ref, 131);
+
+  // Every range, so that partial words at both ends and whole 32 site words are all covered
+  for (int begin = 0; begin <= mem.GetSize(); begin++) {
+    for (int end = begin; end <= mem.GetSize(); end++) {
+      ASSERT_EQ(referenceCount(ref, 0, begin, end), mem.CountFlagCopied(begin, end)) << begin << ", " << end;
+      ASSERT_EQ(referenceCount(ref, 2, begin, end), mem.CountFlagExecuted(begin, end)) << begin << ", " << end;
+    }
+  }
+}
+
+
+TEST(CPUMemory, Flags_InsertShifts)
+{
+  // Shifting up by less than, exactly and more than a word, from aligned and unaligned positions
+  const int insert_sizes[] = { 1, 5, 31, 32, 33, 64, 70 };
+  const int insert_positions[] = { 0, 1, 31, 32, 33, 50, 99, 100 };
+
+  for (unsigned int s = 0; s < sizeof(insert_sizes) / sizeof(int); s++) {
+    for (unsigned int p = 0; p < sizeof(insert_positions) / sizeof(int); p++) {
+      cCPUMemory mem(1);
+      sReference ref;
+      fillTestMemory(mem, ref, 100);
+
+      const int pos = insert_positions[p];
+      InstructionSequence seq(insert_sizes[s]);
+      for (int i = 0; i < seq.GetSize(); i++) seq[i].SetOp(i % 5);
+      mem.Insert(pos, seq);
+      for (int i = 0; i < seq.GetSize(); i++) {
+        ref.ops.insert(ref.ops.begin() + pos + i, i % 5);
+        ref.flags.insert(ref.flags.begin() + pos + i, 0);
+      }
+
+      SCOPED_TRACE(testing::Message() << "insert " << insert_sizes[s] << " at " << pos);
+      expectMatchesReference(mem, ref);
+    }
+  }
+}
+
+
+TEST(CPUMemory, Flags_RemoveShifts)
+{
+  // Shifting down by less than, exactly and more than a word, from aligned and unaligned positions
+  const int remove_sizes[] = { 1, 5, 31, 32, 33, 64 };
+  const int remove_positions[] = { 0, 1, 31, 32, 33, 35 };
+
+  for (unsigned int s = 0; s < sizeof(remove_sizes) / sizeof(int); s++) {
+    for (unsigned int p = 0; p < sizeof(remove_positions) / sizeof(int); p++) {
+      cCPUMemory mem(1);
+      sReference ref;
+      fillTestMemory(mem, ref, 100);
+
+      const int pos = remove_positions[p];
+      const int num_sites = remove_sizes[s];
+      mem.Remove(pos, num_sites);
+      ref.ops.erase(ref.ops.begin() + pos, ref.ops.begin() + pos + num_sites);
+      ref.flags.erase(ref.flags.begin() + pos, ref.flags.begin() + pos + num_sites);
+
+      SCOPED_TRACE(testing::Message() << "remove " << num_sites << " at " << pos);
+      expectMatchesReference(mem, ref);
+    }
+  }
+}
+
+
+TEST(CPUMemory, Flags_RandomEdits)
+{
+  cTestSequence gen(1234);
+  cCPUMemory mem(1);
+  sReference ref;
+  fillTestMemory(mem, ref, 40);
+
+  for (int step = 0; step < 5000; step++) {
+    const int size = mem.GetSize();
+    switch (gen.Next(6)) {
+      case 0:
+      case 1:
+      {
+        const int pos = gen.Next(size);
+        const int flag = gen.Next(NUM_TEST_FLAGS);
+        const bool value = gen.Next(3) != 0;
+        setTestFlag(mem, pos, flag, value);
+        if (value) ref.flags[pos] |= (1 << flag);
+        else ref.flags[pos] &= ~(1 << flag);
+        break;
+      }
+      case 2:
+      {
+        const int pos = gen.Next(size + 1);
+        InstructionSequence seq(1 + gen.Next(70));
+        for (int i = 0; i < seq.GetSize(); i++) seq[i].SetOp(gen.Next(26));
+        mem.Insert(pos, seq);
+        for (int i = 0; i < seq.GetSize(); i++) {
+          ref.ops.insert(ref.ops.begin() + pos + i, seq[i].GetOp());
+          ref.flags.insert(ref.flags.begin() + pos + i, 0);
+        }
+        break;
+      }
+      case 3:
+      {
+        if (size < 2) break;
+        const int pos = gen.Next(size - 1);
+        const int max_sites = (size - 1 - pos < 70) ? size - 1 - pos : 70;
+        const int num_sites = 1 + gen.Next(max_sites);
+        mem.Remove(pos, num_sites);
+        ref.ops.erase(ref.ops.begin() + pos, ref.ops.begin() + pos + num_sites);
+        ref.flags.erase(ref.flags.begin() + pos, ref.flags.begin() + pos + num_sites);
+        break;
+      }
+      case 4:
+      {
+        const int to = gen.Next(size);
+        const int from = gen.Next(size);
+        mem.Copy(to, from);
+        ref.ops[to] = ref.ops[from];
+        ref.flags[to] = ref.flags[from];
+        break;
+      }
+      default:
+      {
+        const int new_size = 1 + gen.Next(200);
+        mem.Resize(new_size);
+        ref.ops.resize(new_size, 0);
+        ref.flags.resize(new_size, 0);
+        break;
+      }
+    }
+
+    ASSERT_EQ((int)ref.ops.size(), mem.GetSize());
+    const int begin = gen.Next(mem.GetSize() + 1);
+    const int end = begin + gen.Next(mem.GetSize() - begin + 1);
+    ASSERT_EQ(referenceCount(ref, 0, begin, end), mem.CountFlagCopied(begin, end)) << "step " << step;
+    ASSERT_EQ(referenceCount(ref, 2, begin, end), mem.CountFlagExecuted(begin, end)) << "step " << step;
+  }
+
+  expectMatchesReference(mem, ref);
+}
+
+
+// Address of the first site, read through the const interface so the revision is left alone
+static const Instruction* siteStorage(const cCPUMemory& mem)
+{
+  return &mem[0];
+}
+
+
+TEST(CPUMemory, Reserve_GrowWithinReservation)
+{
+  cCPUMemory mem(1);
+  sReference ref;
+  fillTestMemory(mem, ref, 50);
+  mem.Reserve(300);
+  const Instruction* storage = siteStorage(mem);
+
+  // Growing up to the reservation, by resize and by insertion, keeps the same storage and the existing sites
+  mem.Resize(120);
+  ref.ops.resize(120, 0);
+  ref.flags.resize(120, 0);
+  InstructionSequence seq(100);
+  for (int i = 0; i < seq.GetSize(); i++) seq[i].SetOp(i % 7);
+  mem.Insert(10, seq);
+  for (int i = 0; i < seq.GetSize(); i++) {
+    ref.ops.insert(ref.ops.begin() + 10 + i, i % 7);
+    ref.flags.insert(ref.flags.begin() + 10 + i, 0);
+  }
+
+  EXPECT_EQ(storage, siteStorage(mem));
+  expectMatchesReference(mem, ref);
+
+  // A smaller reservation never reduces the capacity already reserved
+  mem.Reserve(10);
+  mem.Resize(300);
+  EXPECT_EQ(storage, siteStorage(mem));
+}
+
+
+TEST(CPUMemory, Reserve_ShrinkWithinReservation)
+{
+  cCPUMemory mem(1);
+  sReference ref;
+  fillTestMemory(mem, ref, 200);
+  mem.Reserve(200);
+  const Instruction* storage = siteStorage(mem);
+
+  // Shrinking far below the reservation must not release the storage, as the base class would...
+  mem.Remove(20, 170);
+  ref.ops.erase(ref.ops.begin() + 20, ref.ops.begin() + 190);
+  ref.flags.erase(ref.flags.begin() + 20, ref.flags.begin() + 190);
+  EXPECT_EQ(storage, siteStorage(mem));
+  expectMatchesReference(mem, ref);
+
+  mem.Resize(5);
+  ref.ops.resize(5);
+  ref.flags.resize(5);
+  EXPECT_EQ(storage, siteStorage(mem));
+  expectMatchesReference(mem, ref);
+
+  // ...and the sites regrown afterwards must not pick up the ops or flags left behind in that storage
+  mem.Resize(200);
+  ref.ops.resize(200, 0);
+  ref.flags.resize(200, 0);
+  EXPECT_EQ(storage, siteStorage(mem));
+  expectMatchesReference(mem, ref);
+  EXPECT_EQ(referenceCount(ref, 0, 0, 200), mem.CountFlagCopied(0, 200));
+
+  // ResizeOld keeps whatever ops are in storage, but the flags of the regrown sites still start out clear
+  mem.ResizeOld(3);
+  mem.ResizeOld(150);
+  for (int i = 3; i < 150; i++) {
+    for (int f = 0; f < NUM_TEST_FLAGS; f++) EXPECT_FALSE(getTestFlag(mem, i, f)) << "site " << i << " flag " << f;
+  }
+}
+
+
+TEST(CPUMemory, Reserve_ResetAfterReserve)
+{
+  cCPUMemory mem(1);
+  sReference ref;
+  fillTestMemory(mem, ref, 80);
+  mem.Reserve(100);
+  const Instruction* storage = siteStorage(mem);
+
+  mem.Reset(30);
+  EXPECT_EQ(30, mem.GetSize());
+  EXPECT_EQ(storage, siteStorage(mem));
+  ref.ops.assign(30, 0);
+  ref.flags.assign(30, 0);
+  expectMatchesReference(mem, ref);
+
+  // The reservation outlives the reset
+  mem.Resize(100);
+  EXPECT_EQ(storage, siteStorage(mem));
+  ref.ops.assign(100, 0);
+  ref.flags.assign(100, 0);
+  expectMatchesReference(mem, ref);
+
+  // Growing beyond the reservation falls back to the base class, keeping the contents
+  mem[99].SetOp(4);
+  mem.SetFlagExecuted(99);
+  mem.Resize(250);
+  EXPECT_EQ(250, mem.GetSize());
+  EXPECT_EQ(4, mem[99].GetOp());
+  EXPECT_TRUE(mem.FlagExecuted(99));
+  EXPECT_EQ(1, mem.CountFlagExecuted(0, 250));
+}
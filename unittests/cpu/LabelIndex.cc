@@ -0,0 +1,262 @@
+/*
+ *  unittests/cpu/LabelIndex.cc
+ *  avida-core
+ *
+ *  Copyright 2011 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cCPUMemory.h"
+#include "cCodeLabel.h"
+#include "cInstSet.h"
+#include "cLabelIndex.h"
+
+#include "gtest/gtest.h"
+
+#include <cstring>
+
+using namespace Avida;
+
+
+// cLabelIndex must return exactly what cHardwareCPU's linear FindLabel_Forward/Backward scans return.  The scans are
+// reproduced here as the reference, and compared against the index over many random memories.
+
+static const int NUM_TEST_NOPS = 3;  // opcodes 0 to 2 are nop-A to nop-C, every other opcode is not a nop
+
+
+// Small deterministic generator, so that failures are reproducible
+class cTestSequence
+{
+private:
+  unsigned int m_state;
+
+public:
+  explicit cTestSequence(unsigned int seed) : m_state(seed) { ; }
+  int Next(int range) { m_state = m_state * 1103515245u + 12345u; return (m_state >> 8) % range; }
+};
+
+
+// An instruction set holding just the nops, set up without a world or an instruction library
+static void setupTestInstSet(cInstSet& inst_set)
+{
+  inst_set.m_lib_nopmod_map.Resize(NUM_TEST_NOPS);
+  for (int i = 0; i < NUM_TEST_NOPS; i++) {
+    inst_set.m_lib_nopmod_map[i] = i;
+    inst_set.m_nop_mods[i] = i;
+  }
+}
+
+
+static void setupTestMemory(cCPUMemory& memory, const char* sites)
+{
+  memory.Resize((int)strlen(sites));
+  for (int i = 0; i < memory.GetSize(); i++) {
+    memory[i].SetOp((sites[i] >= 'A' && sites[i] < 'A' + NUM_TEST_NOPS) ? sites[i] - 'A' : NUM_TEST_NOPS);
+  }
+}
+
+static cCodeLabel testLabel(const char* nops)
+{
+  cCodeLabel label;
+  for (const char* nop = nops; *nop; nop++) label.AddNop(*nop - 'A');
+  return label;
+}
+
+
+// cHardwareCPU::FindLabel_Forward, without the index
+static int referenceForward(const cInstSet& inst_set, const cCodeLabel& search_label, const cCPUMemory& search_genome,
+                            int pos)
+{
+  int search_start = pos;
+  int label_size = search_label.GetSize();
+  bool found_label = false;
+
+  pos += label_size;
+  while (pos < search_genome.GetSize()) {
+    if (inst_set.IsNop(search_genome[pos])) {
+      int start_pos = pos;
+      int end_pos = pos + 1;
+      while (start_pos > search_start && inst_set.IsNop(search_genome[start_pos - 1])) start_pos--;
+      while (end_pos < search_genome.GetSize() && inst_set.IsNop(search_genome[end_pos])) end_pos++;
+      int test_size = end_pos - start_pos;
+
+      int max_offset = test_size - label_size + 1;
+      int offset = start_pos;
+      for (offset = start_pos; offset < start_pos + max_offset; offset++) {
+        int matches;
+        for (matches = 0; matches < label_size; matches++) {
+          if (search_label[matches] != inst_set.GetNopMod(search_genome[offset + matches])) break;
+        }
+        if (matches == label_size) {
+          found_label = true;
+          break;
+        }
+      }
+
+      if (found_label == true) {
+        pos = label_size + offset;
+        break;
+      }
+      pos = end_pos;
+    }
+    pos += label_size;
+  }
+
+  if (found_label == false) pos = -1;
+  return pos;
+}
+
+
+// cHardwareCPU::FindLabel_Backward, without the index
+static int referenceBackward(const cInstSet& inst_set, const cCodeLabel& search_label, const cCPUMemory& search_genome,
+                             int pos)
+{
+  int search_start = pos;
+  int label_size = search_label.GetSize();
+  bool found_label = false;
+
+  pos -= label_size;
+  while (pos >= 0) {
+    if (inst_set.IsNop(search_genome[pos])) {
+      int start_pos = pos;
+      int end_pos = pos + 1;
+      while (start_pos > 0 && inst_set.IsNop(search_genome[start_pos - 1])) start_pos--;
+      while (end_pos < search_start && inst_set.IsNop(search_genome[end_pos])) end_pos++;
+      int test_size = end_pos - start_pos;
+
+      int max_offset = test_size - label_size + 1;
+      for (int offset = start_pos; offset < start_pos + max_offset; offset++) {
+        int matches;
+        for (matches = 0; matches < label_size; matches++) {
+          if (search_label[matches] != inst_set.GetNopMod(search_genome[offset + matches])) break;
+        }
+        if (matches == label_size) {
+          found_label = true;
+          break;
+        }
+      }
+
+      if (found_label == true) {
+        pos = end_pos;
+        break;
+      }
+      pos = start_pos - 1;
+    }
+    pos -= label_size;
+  }
+
+  if (found_label == false) pos = -1;
+  return pos;
+}
+
+
+TEST(LabelIndex, BuiltOnRepeatedSearch)
+{
+  cInstSet inst_set(NULL, "test", 0, NULL, 10, 1);
+  setupTestInstSet(inst_set);
+  cCPUMemory memory;
+  setupTestMemory(memory, "xxABCxxxABxxCCAxx");
+  const cCodeLabel label = testLabel("AB");
+  cLabelIndex index;
+  int found_pos = -2;
+
+  // The first search of a revision is left to the linear scan, the next one builds the index
+  EXPECT_FALSE(index.FindForward(inst_set, memory, label, 0, found_pos));
+  EXPECT_TRUE(index.FindForward(inst_set, memory, label, 0, found_pos));
+  EXPECT_EQ(referenceForward(inst_set, label, memory, 0), found_pos);
+  EXPECT_TRUE(index.FindBackward(inst_set, memory, label, 16, found_pos));
+  EXPECT_EQ(referenceBackward(inst_set, label, memory, 16), found_pos);
+
+  // Any write through the memory's interface makes the index stale
+  memory[9].SetOp(2);
+  EXPECT_FALSE(index.FindForward(inst_set, memory, label, 0, found_pos));
+  EXPECT_TRUE(index.FindForward(inst_set, memory, label, 0, found_pos));
+  EXPECT_EQ(referenceForward(inst_set, label, memory, 0), found_pos);
+
+  // An empty label is never indexed
+  EXPECT_FALSE(index.FindForward(inst_set, memory, cCodeLabel(), 0, found_pos));
+}
+
+
+TEST(LabelIndex, NestedLabels)
+{
+  cInstSet inst_set(NULL, "test", 0, NULL, 10, 1);
+  setupTestInstSet(inst_set);
+  cCPUMemory memory;
+  setupTestMemory(memory, "ABxCABCAxxBCAxAB");
+  const char* labels[] = { "A", "B", "AB", "BC", "CA", "ABC", "BCA", "CAB" };
+  cLabelIndex index;
+  int found_pos;
+
+  // Build the index up front, it then serves every label and position
+  index.FindForward(inst_set, memory, testLabel("A"), 0, found_pos);
+
+  for (unsigned int l = 0; l < sizeof(labels) / sizeof(labels[0]); l++) {
+    const cCodeLabel label = testLabel(labels[l]);
+    for (int pos = -4; pos < memory.GetSize(); pos++) {
+      if (pos >= 0) {
+        ASSERT_TRUE(index.FindForward(inst_set, memory, label, pos, found_pos));
+        EXPECT_EQ(referenceForward(inst_set, label, memory, pos), found_pos) << labels[l] << " forward from " << pos;
+      }
+      ASSERT_TRUE(index.FindBackward(inst_set, memory, label, pos, found_pos));
+      EXPECT_EQ(referenceBackward(inst_set, label, memory, pos), found_pos) << labels[l] << " backward from " << pos;
+    }
+  }
+}
+
+
+TEST(LabelIndex, MatchesLinearScan)
+{
+  cInstSet inst_set(NULL, "test", 0, NULL, 10, 1);
+  setupTestInstSet(inst_set);
+  cTestSequence gen(7);
+  int num_found = 0;
+
+  for (int trial = 0; trial < 500; trial++) {
+    // Memories from nearly nop free to nearly all nops, so that runs of every length are searched
+    cCPUMemory memory(1 + gen.Next(120));
+    const int nop_percent = gen.Next(101);
+    for (int i = 0; i < memory.GetSize(); i++) {
+      memory[i].SetOp((gen.Next(100) < nop_percent) ? gen.Next(NUM_TEST_NOPS) : NUM_TEST_NOPS + gen.Next(5));
+    }
+
+    cLabelIndex index;
+    for (int q = 0; q < 100; q++) {
+      cCodeLabel label;
+      const int label_size = 1 + gen.Next(5);
+      for (int i = 0; i < label_size; i++) label.AddNop(gen.Next(NUM_TEST_NOPS));
+
+      int found_pos;
+      const int pos = gen.Next(memory.GetSize());
+      if (index.FindForward(inst_set, memory, label, pos, found_pos)) {
+        const int expected = referenceForward(inst_set, label, memory, pos);
+        ASSERT_EQ(expected, found_pos) << "trial " << trial << ", forward from " << pos;
+        if (expected >= 0) num_found++;
+      }
+
+      // Backward searches may start before the memory, as the first scan of a label does
+      const int back_pos = gen.Next(memory.GetSize() + 6) - 6;
+      if (index.FindBackward(inst_set, memory, label, back_pos, found_pos)) {
+        const int expected = referenceBackward(inst_set, label, memory, back_pos);
+        ASSERT_EQ(expected, found_pos) << "trial " << trial << ", backward from " << back_pos;
+        if (expected >= 0) num_found++;
+      }
+    }
+  }
+
+  // Make sure the comparison was not only of failed searches
+  EXPECT_GT(num_found, 1000);
+}
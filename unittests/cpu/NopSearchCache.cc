@@ -0,0 +1,347 @@
+/*
+ *  unittests/cpu/NopSearchCache.cc
+ *  avida-core
+ *
+ *  Copyright 2011 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cCPUMemory.h"
+#include "cCodeLabel.h"
+#include "cInstLib.h"
+#include "cInstSet.h"
+#include "cNopSearchCache.h"
+
+#include "gtest/gtest.h"
+
+#include <cstring>
+
+using namespace Avida;
+
+
+// cNopSearchCache must return what the head based FindLabelStart/Forward and FindNopSequenceStart/Forward loops of
+// cHardwareExperimental, cHardwareBCR and cHardwareGP8 returned, and flag the same sites as executed.  The loops are
+// reproduced here as the reference, driving a head that wraps like cHeadCPU.
+
+// Opcodes 0 to 2 are nop-A to nop-C, 3 is the label instruction and 4 is any other instruction
+static const int NUM_TEST_NOPS = 3;
+static const int TEST_LABEL = 3;
+static const int TEST_OTHER = 4;
+static const int NUM_TEST_INSTS = 5;
+
+static const cInstLibEntry s_test_entries[NUM_TEST_INSTS] = {
+  cInstLibEntry("nop-A", INST_CLASS_NOP, nInstFlag::NOP, "", BEHAV_CLASS_NONE),
+  cInstLibEntry("nop-B", INST_CLASS_NOP, nInstFlag::NOP, "", BEHAV_CLASS_NONE),
+  cInstLibEntry("nop-C", INST_CLASS_NOP, nInstFlag::NOP, "", BEHAV_CLASS_NONE),
+  cInstLibEntry("label", INST_CLASS_FLOW_CONTROL, nInstFlag::LABEL, "", BEHAV_CLASS_NONE),
+  cInstLibEntry("other", INST_CLASS_OTHER, nInstFlag::DEFAULT, "", BEHAV_CLASS_NONE)
+};
+
+
+class cTestInstLib : public cInstLib
+{
+public:
+  cTestInstLib() : cInstLib(NUM_TEST_INSTS, TEST_OTHER, TEST_OTHER) { ; }
+
+  const cInstLibEntry& Get(int i) const { return s_test_entries[i]; }
+  const cString& GetNopName(const unsigned int id) { return s_test_entries[id].GetName(); }
+  int GetNopMod(const unsigned int id) { return id; }
+  int GetNopMod(const Instruction& inst) { return inst.GetOp(); }
+};
+
+
+// The test instruction set, set up without a world
+class cTestInstSet : public cInstSet
+{
+private:
+  cTestInstLib m_lib;
+
+public:
+  cTestInstSet() : cInstSet(NULL, "test", 0, NULL, 10, 1)
+  {
+    m_inst_lib = &m_lib;
+    m_lib_name_map.Resize(NUM_TEST_INSTS);
+    for (int i = 0; i < NUM_TEST_INSTS; i++) m_lib_name_map[i].lib_fun_id = i;
+    m_lib_nopmod_map.Resize(NUM_TEST_NOPS);
+    for (int i = 0; i < NUM_TEST_NOPS; i++) {
+      m_lib_nopmod_map[i] = i;
+      m_nop_mods[i] = i;
+    }
+  }
+};
+
+
+// Small deterministic generator, so that failures are reproducible
+class cTestSequence
+{
+private:
+  unsigned int m_state;
+
+public:
+  explicit cTestSequence(unsigned int seed) : m_state(seed) { ; }
+  int Next(int range) { m_state = m_state * 1103515245u + 12345u; return (m_state >> 8) % range; }
+};
+
+
+// A head over one memory, advancing and retreating as cHeadCPU does: forward wraps to the start, but stepping back
+// from position 0 stays at 0
+struct sTestHead
+{
+  const cCPUMemory& memory;
+  int position;
+
+  sTestHead(const cCPUMemory& in_memory, int pos) : memory(in_memory), position(pos) { ; }
+
+  void Adjust()
+  {
+    const int size = memory.GetSize();
+    if (size == 0 || position < 0) position = 0;
+    else if (position >= size) position = (position < 2 * size) ? position - size : position % size;
+  }
+  void Advance() { position++; Adjust(); }
+  void Retreat() { position--; Adjust(); }
+  const Instruction& GetInst() const { return memory[position]; }
+};
+
+
+// Sites: 'A' to 'C' are nops, 'L' is the label instruction, anything else is some other instruction
+static void setupTestMemory(cCPUMemory& memory, const char* sites)
+{
+  memory.Resize((int)strlen(sites));
+  for (int i = 0; i < memory.GetSize(); i++) {
+    int op = TEST_OTHER;
+    if (sites[i] >= 'A' && sites[i] < 'A' + NUM_TEST_NOPS) op = sites[i] - 'A';
+    else if (sites[i] == 'L') op = TEST_LABEL;
+    memory[i].SetOp(op);
+  }
+}
+
+static cCodeLabel testLabel(const char* nops)
+{
+  cCodeLabel label;
+  for (const char* nop = nops; *nop; nop++) label.AddNop(*nop - 'A');
+  return label;
+}
+
+
+// The original FindLabelStart/FindNopSequenceStart loops; returns -1 where the hardware returned its IP unmoved
+static int referenceStart(const cInstSet& inst_set, cCPUMemory& memory, bool is_label, const cCodeLabel& search_label,
+                          int max, bool mark_executed)
+{
+  int pos = 0;
+  while (pos < memory.GetSize()) {
+    if (is_label ? inst_set.IsLabel(memory[pos]) : inst_set.IsNop(memory[pos])) {
+      if (is_label) pos++;
+
+      int size_matched = 0;
+      while (size_matched < search_label.GetSize() && pos < memory.GetSize()) {
+        if (!inst_set.IsNop(memory[pos]) || search_label[size_matched] != inst_set.GetNopMod(memory[pos])) break;
+        size_matched++;
+        pos++;
+      }
+
+      if (size_matched == search_label.GetSize()) {
+        if (mark_executed) {
+          if (is_label) size_matched++;
+          const int start = pos - size_matched;
+          for (int i = 0; i < size_matched && i < max; i++) memory.SetFlagExecuted(start + i);
+        }
+        return pos - 1;
+      }
+
+      if (is_label) continue;
+    }
+    pos++;
+  }
+  return -1;
+}
+
+
+// The original FindLabelForward/FindNopSequenceForward loops; returns -1 where the hardware returned its IP unmoved
+static int referenceForward(const cInstSet& inst_set, cCPUMemory& memory, bool is_label, const cCodeLabel& search_label,
+                            int ip_pos, int max, bool mark_executed)
+{
+  const sTestHead ip(memory, ip_pos);
+  sTestHead pos(memory, ip_pos);
+  pos.Advance();
+
+  while (pos.position != ip.position) {
+    if (is_label ? inst_set.IsLabel(pos.GetInst()) : inst_set.IsNop(pos.GetInst())) {
+      const int label_start = pos.position;
+      if (is_label) pos.Advance();
+
+      int size_matched = 0;
+      while (size_matched < search_label.GetSize() && pos.position != ip.position) {
+        if (!inst_set.IsNop(pos.GetInst()) || search_label[size_matched] != inst_set.GetNopMod(pos.GetInst())) break;
+        size_matched++;
+        pos.Advance();
+      }
+
+      if (size_matched == search_label.GetSize()) {
+        pos.Retreat();
+        const int found_pos = pos.position;
+        if (mark_executed) {
+          pos.position = label_start;
+          for (int i = 0; i < size_matched && i < max; i++, pos.Advance()) memory.SetFlagExecuted(pos.position);
+        }
+        return found_pos;
+      }
+
+      if (is_label) continue;
+    }
+
+    if (pos.position == ip.position) break;
+    pos.Advance();
+  }
+  return -1;
+}
+
+
+static int referenceFind(const cInstSet& inst_set, cCPUMemory& memory, cNopSearchCache::eSearchType type,
+                         const cCodeLabel& label, int start, int max, bool mark_executed)
+{
+  switch (type) {
+    case cNopSearchCache::LABEL_START: return referenceStart(inst_set, memory, true, label, max, mark_executed);
+    case cNopSearchCache::LABEL_FORWARD: return referenceForward(inst_set, memory, true, label, start, max, mark_executed);
+    case cNopSearchCache::NOP_SEQUENCE_START: return referenceStart(inst_set, memory, false, label, max, mark_executed);
+    default: return referenceForward(inst_set, memory, false, label, start, max, mark_executed);
+  }
+}
+
+
+// Runs one search through the cache and through the reference, on separate copies of memory, and compares both the
+// position found and the sites flagged as executed
+static void expectSameSearch(const cInstSet& inst_set, cNopSearchCache& cache, const cCPUMemory& memory,
+                             cNopSearchCache::eSearchType type, const cCodeLabel& label, int start, int max)
+{
+  cCPUMemory cache_memory(memory);
+  cCPUMemory ref_memory(memory);
+  cache_memory.ClearFlags();
+  ref_memory.ClearFlags();
+
+  const int expected = referenceFind(inst_set, ref_memory, type, label, start, max, true);
+  const cNopSearchCache::sResult& result = cache.Find(inst_set, memory, type, label, start);
+  ASSERT_EQ(expected, result.found_pos) << "type " << type << " from " << start;
+  if (result.found_pos >= 0) cNopSearchCache::MarkExecuted(cache_memory, result, max);
+
+  for (int i = 0; i < memory.GetSize(); i++) {
+    ASSERT_EQ(ref_memory.FlagExecuted(i), cache_memory.FlagExecuted(i)) << "type " << type << " from " << start << ", site " << i;
+  }
+}
+
+
+TEST(NopSearchCache, WrapAtEnd)
+{
+  cTestInstSet inst_set;
+  cNopSearchCache cache;
+  cCPUMemory memory;
+  const int max = 10;
+
+  // A label whose nops continue past the end of memory and wrap around to its start
+  setupTestMemory(memory, "BxxxLA");
+  EXPECT_EQ(0, cache.Find(inst_set, memory, cNopSearchCache::LABEL_FORWARD, testLabel("AB"), 2).found_pos);
+  expectSameSearch(inst_set, cache, memory, cNopSearchCache::LABEL_FORWARD, testLabel("AB"), 2, max);
+  expectSameSearch(inst_set, cache, memory, cNopSearchCache::NOP_SEQUENCE_FORWARD, testLabel("AB"), 2, max);
+
+  // The search from the start of memory does not wrap
+  EXPECT_EQ(-1, cache.Find(inst_set, memory, cNopSearchCache::LABEL_START, testLabel("AB"), 0).found_pos);
+  expectSameSearch(inst_set, cache, memory, cNopSearchCache::LABEL_START, testLabel("AB"), 0, max);
+
+  // A match ending on the last site leaves the head at 0, the original loops stepped it back from there
+  setupTestMemory(memory, "xxLAB");
+  EXPECT_EQ(0, cache.Find(inst_set, memory, cNopSearchCache::LABEL_FORWARD, testLabel("AB"), 0).found_pos);
+  EXPECT_EQ(4, cache.Find(inst_set, memory, cNopSearchCache::LABEL_START, testLabel("AB"), 0).found_pos);
+  expectSameSearch(inst_set, cache, memory, cNopSearchCache::LABEL_FORWARD, testLabel("AB"), 0, max);
+  expectSameSearch(inst_set, cache, memory, cNopSearchCache::NOP_SEQUENCE_FORWARD, testLabel("AB"), 1, max);
+
+  // The forward scan stops at its starting position, even part way through a match
+  setupTestMemory(memory, "ABxxL");
+  EXPECT_EQ(1, cache.Find(inst_set, memory, cNopSearchCache::LABEL_FORWARD, testLabel("AB"), 3).found_pos);
+  EXPECT_EQ(-1, cache.Find(inst_set, memory, cNopSearchCache::LABEL_FORWARD, testLabel("AB"), 1).found_pos);
+  for (int start = 0; start < memory.GetSize(); start++) {
+    expectSameSearch(inst_set, cache, memory, cNopSearchCache::LABEL_FORWARD, testLabel("AB"), start, max);
+    expectSameSearch(inst_set, cache, memory, cNopSearchCache::NOP_SEQUENCE_FORWARD, testLabel("AB"), start, max);
+  }
+}
+
+
+TEST(NopSearchCache, RevisionInvalidates)
+{
+  cTestInstSet inst_set;
+  cNopSearchCache cache;
+  cCPUMemory memory;
+  setupTestMemory(memory, "xLABxxLBAx");
+  const cCodeLabel label = testLabel("BA");
+
+  EXPECT_EQ(8, cache.Find(inst_set, memory, cNopSearchCache::LABEL_START, label, 0).found_pos);
+  EXPECT_EQ(8, cache.Find(inst_set, memory, cNopSearchCache::LABEL_START, label, 0).found_pos);
+
+  // Writing memory bumps its revision, so the cached result must not be reused
+  memory[2].SetOp(1);
+  memory[3].SetOp(0);
+  EXPECT_EQ(3, cache.Find(inst_set, memory, cNopSearchCache::LABEL_START, label, 0).found_pos);
+
+  // Results are kept per memory
+  cCPUMemory other;
+  setupTestMemory(other, "xLBBxxxxxx");
+  EXPECT_EQ(-1, cache.Find(inst_set, other, cNopSearchCache::LABEL_START, label, 0).found_pos);
+  EXPECT_EQ(3, cache.Find(inst_set, memory, cNopSearchCache::LABEL_START, label, 0).found_pos);
+}
+
+
+TEST(NopSearchCache, MatchesHeadLoops)
+{
+  cTestInstSet inst_set;
+  cTestSequence gen(42);
+  const cNopSearchCache::eSearchType types[] = {
+    cNopSearchCache::LABEL_START, cNopSearchCache::LABEL_FORWARD,
+    cNopSearchCache::NOP_SEQUENCE_START, cNopSearchCache::NOP_SEQUENCE_FORWARD
+  };
+  int num_found = 0;
+
+  for (int trial = 0; trial < 400; trial++) {
+    cCPUMemory memory(1 + gen.Next(60));
+    const int nop_percent = gen.Next(101);
+    for (int i = 0; i < memory.GetSize(); i++) {
+      int op = (gen.Next(100) < nop_percent) ? gen.Next(NUM_TEST_NOPS) : TEST_OTHER;
+      if (gen.Next(8) == 0) op = TEST_LABEL;
+      memory[i].SetOp(op);
+    }
+
+    cNopSearchCache cache;
+    for (int q = 0; q < 40; q++) {
+      cCodeLabel label;
+      const int label_size = 1 + gen.Next(4);
+      for (int i = 0; i < label_size; i++) label.AddNop(gen.Next(NUM_TEST_NOPS));
+
+      const cNopSearchCache::eSearchType type = types[gen.Next(4)];
+      const int start = gen.Next(memory.GetSize());
+      const int max = 1 + gen.Next(6);
+
+      // Repeat some searches, so that cached results are compared as well
+      const int repeats = 1 + gen.Next(2);
+      for (int r = 0; r < repeats; r++) {
+        SCOPED_TRACE(testing::Message() << "trial " << trial << ", query " << q << ", repeat " << r);
+        expectSameSearch(inst_set, cache, memory, type, label, start, max);
+        if (::testing::Test::HasFatalFailure()) return;
+      }
+      if (cache.Find(inst_set, memory, type, label, start).found_pos >= 0) num_found++;
+    }
+  }
+
+  // Make sure the comparison was not only of failed searches
+  EXPECT_GT(num_found, 2000);
+}
@@ -0,0 +1,210 @@
+/*
+ *  unittests/main/MutationRates.cc
+ *  avida-core
+ *
+ *  Copyright 2011 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "apto/rng/AvidaRNG.h"
+
+#include "cAvidaContext.h"
+#include "cMutationRates.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+
+
+// The copy mutation tests used to be a single P(prob) draw per copy; these tests compare the geometric skip sampling
+// against that per-copy reference, both against theory and against each other.
+
+static const double s_test_probs[] = { 0.5, 0.1, 0.0075, 0.001 };
+static const int s_num_test_probs = sizeof(s_test_probs) / sizeof(double);
+
+
+// Number of failures before the first success, drawn one copy at a time as the original implementation did
+static int referenceSkip(cAvidaContext& ctx, double prob)
+{
+  int skip = 0;
+  while (!ctx.GetRandom().P(prob)) skip++;
+  return skip;
+}
+
+
+struct sMoments
+{
+  double mean;
+  double var;
+};
+
+static sMoments gapMoments(cAvidaContext& ctx, double prob, int num_gaps, bool reference)
+{
+  double sum = 0.0;
+  double sum_sq = 0.0;
+  for (int i = 0; i < num_gaps; i++) {
+    const double gap = reference ? referenceSkip(ctx, prob) : cMutationRates::drawCopySkip(ctx, prob);
+    sum += gap;
+    sum_sq += gap * gap;
+  }
+  sMoments m;
+  m.mean = sum / num_gaps;
+  m.var = sum_sq / num_gaps - m.mean * m.mean;
+  return m;
+}
+
+
+TEST(MutationRates, CopySkip_GeometricMoments)
+{
+  Apto::RNG::AvidaRNG rng(101);
+  cAvidaContext ctx(NULL, rng);
+  const int num_gaps = 200000;
+  
+  for (int i = 0; i < s_num_test_probs; i++) {
+    const double p = s_test_probs[i];
+    const double expected_mean = (1.0 - p) / p;
+    const double expected_var = (1.0 - p) / (p * p);
+    const double mean_tolerance = 5.0 * sqrt(expected_var / num_gaps);
+    
+    sMoments skip = gapMoments(ctx, p, num_gaps, false);
+    EXPECT_NEAR(expected_mean, skip.mean, mean_tolerance) << "prob = " << p;
+    EXPECT_NEAR(expected_var, skip.var, 0.05 * expected_var) << "prob = " << p;
+    
+    // The reference draws once per copy, so use fewer gaps for the low rates
+    const int num_ref_gaps = (p < 0.01) ? num_gaps / 20 : num_gaps;
+    sMoments ref = gapMoments(ctx, p, num_ref_gaps, true);
+    EXPECT_NEAR(ref.mean, skip.mean, 5.0 * sqrt(expected_var / num_gaps + expected_var / num_ref_gaps)) << "prob = " << p;
+  }
+}
+
+
+TEST(MutationRates, CopySkip_GapDistributionMatchesReference)
+{
+  Apto::RNG::AvidaRNG rng(202);
+  cAvidaContext ctx(NULL, rng);
+  const double p = 0.1;
+  const int num_gaps = 100000;
+  const int num_bins = 30;  // gaps of num_bins - 1 or more share the last bin
+  
+  Apto::Array<int> skip_hist(num_bins);
+  Apto::Array<int> ref_hist(num_bins);
+  skip_hist.SetAll(0);
+  ref_hist.SetAll(0);
+  for (int i = 0; i < num_gaps; i++) {
+    skip_hist[Apto::Min(cMutationRates::drawCopySkip(ctx, p), num_bins - 1)]++;
+    ref_hist[Apto::Min(referenceSkip(ctx, p), num_bins - 1)]++;
+  }
+  
+  // Two sample chi-square homogeneity test, 29 degrees of freedom; 58.3 is the 0.001 critical value
+  double chi_sq = 0.0;
+  for (int i = 0; i < num_bins; i++) {
+    const double total = skip_hist[i] + ref_hist[i];
+    if (total == 0) continue;
+    const double diff = skip_hist[i] - ref_hist[i];
+    chi_sq += diff * diff / total;
+  }
+  EXPECT_LT(chi_sq, 58.3);
+}
+
+
+TEST(MutationRates, TestCopyMut_PerGenomeCounts)
+{
+  // Mutations per 100-site copy should follow Binomial(100, p), as they did with one draw per site
+  Apto::RNG::AvidaRNG rng(303);
+  cAvidaContext ctx(NULL, rng);
+  const int genome_size = 100;
+  const int num_genomes = 50000;
+  
+  for (int i = 0; i < s_num_test_probs; i++) {
+    const double p = s_test_probs[i];
+    cMutationRates rates;
+    rates.SetCopyMutProb(p);
+    
+    double sum = 0.0;
+    double sum_sq = 0.0;
+    for (int g = 0; g < num_genomes; g++) {
+      int count = 0;
+      for (int site = 0; site < genome_size; site++) if (rates.TestCopyMut(ctx)) count++;
+      sum += count;
+      sum_sq += count * count;
+    }
+    const double mean = sum / num_genomes;
+    const double var = sum_sq / num_genomes - mean * mean;
+    const double expected_var = genome_size * p * (1.0 - p);
+    
+    EXPECT_NEAR(genome_size * p, mean, 5.0 * sqrt(expected_var / num_genomes)) << "prob = " << p;
+    EXPECT_NEAR(expected_var, var, 0.05 * expected_var + 0.001) << "prob = " << p;
+  }
+}
+
+
+TEST(MutationRates, TestCopyMut_ReducedRate)
+{
+  // Error correcting copies thin the full rate skip; per-genome counts should follow Binomial(100, p / reduction)
+  Apto::RNG::AvidaRNG rng(505);
+  cAvidaContext ctx(NULL, rng);
+  const int genome_size = 100;
+  const int num_genomes = 50000;
+  const double reduction = 3.0;
+  
+  for (int i = 0; i < s_num_test_probs; i++) {
+    const double p = s_test_probs[i] / reduction;
+    cMutationRates rates;
+    rates.SetCopyMutProb(s_test_probs[i]);
+    
+    double sum = 0.0;
+    double sum_sq = 0.0;
+    for (int g = 0; g < num_genomes; g++) {
+      int count = 0;
+      for (int site = 0; site < genome_size; site++) if (rates.TestCopyMut(ctx, reduction)) count++;
+      sum += count;
+      sum_sq += count * count;
+    }
+    const double mean = sum / num_genomes;
+    const double var = sum_sq / num_genomes - mean * mean;
+    const double expected_var = genome_size * p * (1.0 - p);
+    
+    EXPECT_NEAR(genome_size * p, mean, 5.0 * sqrt(expected_var / num_genomes)) << "prob = " << s_test_probs[i];
+    EXPECT_NEAR(expected_var, var, 0.05 * expected_var + 0.001) << "prob = " << s_test_probs[i];
+  }
+}
+
+
+TEST(MutationRates, TestCopyMut_RateChanges)
+{
+  Apto::RNG::AvidaRNG rng(404);
+  cAvidaContext ctx(NULL, rng);
+  cMutationRates rates;
+  
+  // A long pending skip must not survive a change of rate
+  rates.SetCopyMutProb(1e-9);
+  EXPECT_FALSE(rates.TestCopyMut(ctx));
+  rates.SetCopyMutProb(1.0);
+  for (int i = 0; i < 100; i++) EXPECT_TRUE(rates.TestCopyMut(ctx));
+  rates.SetCopyMutProb(0.0);
+  for (int i = 0; i < 100; i++) EXPECT_FALSE(rates.TestCopyMut(ctx));
+  
+  // Nor be handed to a copy of the rates
+  rates.SetCopyMutProb(0.5);
+  int matches = 0;
+  for (int trial = 0; trial < 1000; trial++) {
+    rates.TestCopyMut(ctx);
+    cMutationRates offspring(rates);
+    if (offspring.TestCopyMut(ctx) == rates.TestCopyMut(ctx)) matches++;
+  }
+  EXPECT_GT(matches, 400);
+  EXPECT_LT(matches, 600);
+}
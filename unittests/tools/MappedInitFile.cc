@@ -0,0 +1,182 @@
+/*
+ *  unittests/tools/MappedInitFile.cc
+ *  avida-core
+ *
+ *  Copyright 2011 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cMappedInitFile.h"
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <cstring>
+
+
+static const char* s_test_filename = "mapped_init_file_test.dat";
+
+// Writes the supplied contents to the test file in the working directory, byte for byte
+static void writeTestFile(const char* contents)
+{
+  FILE* fp = fopen(s_test_filename, "wb");
+  ASSERT_TRUE(fp != NULL);
+  fwrite(contents, 1, strlen(contents), fp);
+  fclose(fp);
+}
+
+
+TEST(MappedInitFile, LineIndexing)
+{
+  writeTestFile("alpha beta\n"
+                "\n"
+                "   \t  \n"
+                "gamma   delta\tepsilon\n"
+                "zeta");
+  cMappedInitFile file(s_test_filename, ".");
+  ASSERT_TRUE(file.WasOpened());
+
+  ASSERT_EQ(3, file.GetNumLines());
+  EXPECT_STREQ("alpha beta", file.GetLine(0));
+  EXPECT_STREQ("gamma delta epsilon", file.GetLine(1));
+  EXPECT_STREQ("zeta", file.GetLine(2));
+  EXPECT_EQ(3, file.GetLineView(1).CountNumWords());
+
+  cMappedInitFile::cLineView view = file.GetLineView(1);
+  EXPECT_STREQ("gamma", view.PopWord());
+  EXPECT_STREQ("delta", view.PopWord());
+  EXPECT_STREQ("epsilon", view.PopWord());
+  EXPECT_STREQ("", view.PopWord());
+
+  // Out of range lines are simply empty
+  EXPECT_TRUE(file.GetLineView(-1).IsEmpty());
+  EXPECT_TRUE(file.GetLineView(3).IsEmpty());
+  EXPECT_EQ(3, file.GetNumLines());
+
+  remove(s_test_filename);
+}
+
+
+TEST(MappedInitFile, Continuations)
+{
+  writeTestFile("one two \\\n"
+                "   three \\\n"
+                "four\n"
+                "\\\n"
+                "\n"
+                "five\n"
+                "six \\\n");
+  cMappedInitFile file(s_test_filename, ".");
+  ASSERT_TRUE(file.WasOpened());
+
+  ASSERT_EQ(3, file.GetNumLines());
+  EXPECT_STREQ("one two three four", file.GetLine(0));
+  EXPECT_STREQ("five", file.GetLine(1));
+  EXPECT_STREQ("six", file.GetLine(2));
+  EXPECT_EQ(4, file.GetLineView(0).CountNumWords());
+
+  remove(s_test_filename);
+}
+
+
+TEST(MappedInitFile, Comments)
+{
+  writeTestFile("# leading comment line\n"
+                "a b # trailing comment\n"
+                "    # indented comment only\n"
+                "c#d\n"
+                "e \\\n"
+                "f # comment after a continuation\n");
+  cMappedInitFile file(s_test_filename, ".");
+  ASSERT_TRUE(file.WasOpened());
+
+  ASSERT_EQ(3, file.GetNumLines());
+  EXPECT_STREQ("a b", file.GetLine(0));
+  EXPECT_STREQ("c", file.GetLine(1));
+  EXPECT_STREQ("e f", file.GetLine(2));
+
+  remove(s_test_filename);
+}
+
+
+TEST(MappedInitFile, CRLF)
+{
+  writeTestFile("#filetype genotype_data\r\n"
+                "#format id num_cpus\r\n"
+                "\r\n"
+                "1 10\r\n"
+                "2 \\\r\n"
+                "20\r\n");
+  cMappedInitFile file(s_test_filename, ".");
+  ASSERT_TRUE(file.WasOpened());
+
+  EXPECT_STREQ("genotype_data", file.GetFiletype());
+  ASSERT_EQ(2, file.GetFormat().GetSize());
+  ASSERT_EQ(2, file.GetNumLines());
+  EXPECT_STREQ("1 10", file.GetLine(0));
+  EXPECT_STREQ("2 20", file.GetLine(1));
+
+  Apto::SmartPtr<Apto::Map<Apto::String, Apto::String> > dict = file.GetLineAsDict(1);
+  EXPECT_STREQ("2", dict->Get("id"));
+  EXPECT_STREQ("20", dict->Get("num_cpus"));
+
+  remove(s_test_filename);
+}
+
+
+TEST(MappedInitFile, LateDirectiveFailsOpen)
+{
+  // Unsupported or conflicting directives must be detected when the file is opened, wherever they appear
+  const char* contents[] = {
+    "#format a b\n1 2\n#format c d\n3 4\n",
+    "#filetype one\n1 2\n#filetype two\n",
+  };
+
+  for (unsigned int i = 0; i < sizeof(contents) / sizeof(contents[0]); i++) {
+    writeTestFile(contents[i]);
+    cMappedInitFile file(s_test_filename, ".");
+    EXPECT_TRUE(file.WasFound()) << "case " << i;
+    EXPECT_FALSE(file.WasOpened()) << "case " << i;
+    EXPECT_FALSE(file.NeedsInitFile()) << "case " << i;
+    EXPECT_EQ(1, file.GetFeedback().GetNumErrors()) << "case " << i;
+    EXPECT_EQ(0, file.GetNumLines()) << "case " << i;
+  }
+
+  remove(s_test_filename);
+}
+
+
+TEST(MappedInitFile, InitFileDirectivesRequestFallback)
+{
+  // Directives only cInitFile understands are left to it, without reporting an error
+  const char* contents[] = {
+    "#format a b\n1 2\n3 4\n#include other.cfg\n5 6\n",
+    "#format a b\n1 2\n#define X 1\n",
+    "#import other.cfg\n#format a b\n1 2\n",
+  };
+
+  for (unsigned int i = 0; i < sizeof(contents) / sizeof(contents[0]); i++) {
+    writeTestFile(contents[i]);
+    cMappedInitFile file(s_test_filename, ".");
+    EXPECT_TRUE(file.WasFound()) << "case " << i;
+    EXPECT_FALSE(file.WasOpened()) << "case " << i;
+    EXPECT_TRUE(file.NeedsInitFile()) << "case " << i;
+    EXPECT_EQ(0, file.GetFeedback().GetNumErrors()) << "case " << i;
+    EXPECT_EQ(0, file.GetNumLines()) << "case " << i;
+  }
+
+  remove(s_test_filename);
+}